@@ -0,0 +1,344 @@
+/**
+ * alternatives.c
+ * Plateau-based alternative routes over two shortest path trees
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "alternatives.h"
+#include "heap.h"
+#include "search_workspace.h"
+
+int init_alternative_workspace(AlternativeWorkspace* workspace, int node_count) {
+    memset(workspace, 0, sizeof(AlternativeWorkspace));
+    if (node_count < 1) {
+        node_count = 1;
+    }
+    size_t n = (size_t)node_count;
+    workspace->forward_order = malloc(n * sizeof(int));
+    workspace->backward_order = malloc(n * sizeof(int));
+    workspace->forward_shared = malloc(n * sizeof(double));
+    workspace->backward_shared = malloc(n * sizeof(double));
+    workspace->plateau = malloc(n * sizeof(double));
+    workspace->route_next = malloc(n * MAX_ALTERNATIVE_ROUTES * sizeof(int));
+    workspace->on_path = calloc(n, sizeof(unsigned char));
+    workspace->paths = malloc(n * MAX_ALTERNATIVE_ROUTES * sizeof(int));
+    if (!workspace->forward_order || !workspace->backward_order || !workspace->forward_shared ||
+        !workspace->backward_shared || !workspace->plateau || !workspace->route_next ||
+        !workspace->on_path || !workspace->paths ||
+        init_search_workspace(&workspace->forward, node_count) != 0 ||
+        init_search_workspace(&workspace->backward, node_count) != 0) {
+        free_alternative_workspace(workspace);
+        return -1;
+    }
+    for (size_t i = 0; i < n * MAX_ALTERNATIVE_ROUTES; i++) {
+        workspace->route_next[i] = -1;
+    }
+    workspace->node_count = node_count;
+    return 0;
+}
+
+void free_alternative_workspace(AlternativeWorkspace* workspace) {
+    free_search_workspace(&workspace->forward);
+    free_search_workspace(&workspace->backward);
+    free(workspace->forward_order);
+    free(workspace->backward_order);
+    free(workspace->forward_shared);
+    free(workspace->backward_shared);
+    free(workspace->plateau);
+    free(workspace->route_next);
+    free(workspace->on_path);
+    free(workspace->paths);
+    memset(workspace, 0, sizeof(AlternativeWorkspace));
+}
+
+// Settled by the tree's search, so its distance and tree edge are final
+static int tree_settled(const SearchWorkspace* tree, int v) {
+    return tree->stamp[v] == tree->epoch && !in_heap(&tree->heap, v);
+}
+
+// Dijkstra from root over the CSR, or into root over the reverse CSR,
+// recording the settle order until the queue minimum passes limit. Once
+// target (if not -1) is settled, limit drops to the stretch bound of its
+// distance. Returns the target's distance, INF if it was not settled.
+static double grow_tree(const Graph* graph, SearchWorkspace* tree, int order[], int* count,
+                        int root, int reverse, int target, double limit) {
+    const CSRGraph* csr = &graph->csr;
+    const int* offsets = reverse ? csr->reverse_offsets : csr->offsets;
+    const int* heads = reverse ? csr->reverse_sources : csr->targets;
+    const double* weights = reverse ? csr->reverse_weights : csr->weights;
+    unsigned int epoch;
+    unsigned int* stamp = tree->stamp;
+    double* distance = tree->distance;
+    int* parent = tree->previous;
+    MinHeap* heap = &tree->heap;
+    double target_distance = INF;
+
+    begin_search(tree);
+    epoch = tree->epoch;
+    stamp[root] = epoch;
+    distance[root] = 0.0;
+    parent[root] = -1;
+    insert_heap(heap, root, 0.0);
+    *count = 0;
+
+    while (!is_empty(heap) && peek_min_key(heap) <= limit) {
+        int u = extract_min(heap).vertex;
+        tree->settled++;
+        order[(*count)++] = u;
+        if (u == target) {
+            target_distance = distance[u];
+            limit = target_distance * (1.0 + ALTERNATIVE_STRETCH);
+        }
+
+        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+            int v = heads[e];
+            double alt = distance[u] + weights[e];
+
+            if (stamp[v] != epoch || alt < distance[v]) {
+                stamp[v] = epoch;
+                distance[v] = alt;
+                parent[v] = u;
+                insert_heap(heap, v, alt);
+            }
+        }
+    }
+    return target_distance;
+}
+
+// Plateau length from each vertex of the backward tree: the km its
+// backward tree path follows roads that are also forward tree roads
+static void find_plateaus(AlternativeWorkspace* workspace) {
+    const SearchWorkspace* forward = &workspace->forward;
+    const SearchWorkspace* backward = &workspace->backward;
+    double* plateau = workspace->plateau;
+
+    for (int i = 0; i < workspace->backward_count; i++) {
+        int v = workspace->backward_order[i];
+        int w = backward->previous[v];
+        // w was settled before v, so its plateau is known
+        if (w >= 0 && tree_settled(forward, v) && tree_settled(forward, w) &&
+            forward->previous[w] == v) {
+            plateau[v] = plateau[w] + backward->distance[v] - backward->distance[w];
+        } else {
+            plateau[v] = 0.0;
+        }
+    }
+}
+
+static int on_chosen_route(const AlternativeWorkspace* workspace, int u, int v) {
+    const int* next = workspace->route_next + (size_t)u * MAX_ALTERNATIVE_ROUTES;
+    for (int r = 0; r < workspace->route_count; r++) {
+        if (next[r] == v) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// km of each tree path (start -> v forward, v -> end backward) that some
+// chosen route already drives, one pass over each tree in settle order
+static void measure_sharing(AlternativeWorkspace* workspace) {
+    const SearchWorkspace* forward = &workspace->forward;
+    const SearchWorkspace* backward = &workspace->backward;
+
+    for (int i = 0; i < workspace->forward_count; i++) {
+        int v = workspace->forward_order[i];
+        int u = forward->previous[v];
+        double shared = 0.0;
+        if (u >= 0) {
+            shared = workspace->forward_shared[u];
+            if (on_chosen_route(workspace, u, v)) {
+                shared += forward->distance[v] - forward->distance[u];
+            }
+        }
+        workspace->forward_shared[v] = shared;
+    }
+    for (int i = 0; i < workspace->backward_count; i++) {
+        int v = workspace->backward_order[i];
+        int w = backward->previous[v];
+        double shared = 0.0;
+        if (w >= 0) {
+            shared = workspace->backward_shared[w];
+            if (on_chosen_route(workspace, v, w)) {
+                shared += backward->distance[v] - backward->distance[w];
+            }
+        }
+        workspace->backward_shared[v] = shared;
+    }
+}
+
+// First vertex of the best admissible plateau, -1 if none is left
+static int best_via(const AlternativeWorkspace* workspace, double shortest, double limit) {
+    const SearchWorkspace* forward = &workspace->forward;
+    const SearchWorkspace* backward = &workspace->backward;
+    int best = -1;
+    double best_score = 0.0;
+
+    // forward_order[0] is the start, whose plateau leads to end
+    for (int i = 1; i < workspace->forward_count; i++) {
+        int v = workspace->forward_order[i];
+        if (!tree_settled(backward, v) || workspace->plateau[v] <= 0.0 ||
+            workspace->plateau[v] < ALTERNATIVE_PLATEAU * shortest) {
+            continue;
+        }
+        // Every vertex of a plateau gives the same route; take its first
+        int u = forward->previous[v];
+        if (tree_settled(backward, u) && backward->previous[u] == v) {
+            continue;
+        }
+        double length = forward->distance[v] + backward->distance[v];
+        double shared = workspace->forward_shared[v] + workspace->backward_shared[v];
+        if (length > limit || shared > ALTERNATIVE_SHARING * shortest) {
+            continue;
+        }
+        double score = 2.0 * length + shared - workspace->plateau[v];
+        if (best < 0 || score < best_score) {
+            best = v;
+            best_score = score;
+        }
+    }
+    return best;
+}
+
+// Route through via (the forward tree to via, then the backward tree) as
+// the next chosen route; 0 if it visits a vertex twice
+static int add_route(AlternativeWorkspace* workspace, int via) {
+    int r = workspace->route_count;
+    int* path = workspace->paths + (size_t)r * workspace->node_count;
+    const int* parent = workspace->forward.previous;
+    const int* next = workspace->backward.previous;
+    unsigned char* on_path = workspace->on_path;
+    int length = 0;
+    int simple = 1;
+
+    for (int v = via; v != -1; v = parent[v]) {
+        path[length++] = v;
+    }
+    for (int i = 0, j = length - 1; i < j; i++, j--) {
+        int swap = path[i];
+        path[i] = path[j];
+        path[j] = swap;
+    }
+    for (int i = 0; i < length; i++) {
+        on_path[path[i]] = 1;
+    }
+    for (int v = next[via]; v != -1; v = next[v]) {
+        if (on_path[v]) {
+            simple = 0;
+            break;
+        }
+        on_path[v] = 1;
+        path[length++] = v;
+    }
+    for (int i = 0; i < length; i++) {
+        on_path[path[i]] = 0;
+    }
+    if (!simple) {
+        return 0;
+    }
+
+    for (int i = 0; i + 1 < length; i++) {
+        workspace->route_next[(size_t)path[i] * MAX_ALTERNATIVE_ROUTES + r] = path[i + 1];
+    }
+    AlternativeRoute* route = &workspace->routes[r];
+    route->path = path;
+    route->length = length;
+    route->distance = workspace->forward.distance[via] + workspace->backward.distance[via];
+    route->shared = workspace->forward_shared[via] + workspace->backward_shared[via];
+    route->plateau = workspace->plateau[via];
+    route->via = via;
+    workspace->route_count++;
+    return 1;
+}
+
+int find_alternatives(const Graph* graph, AlternativeWorkspace* workspace, int start, int end,
+                      int max_routes) {
+    workspace->route_count = 0;
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+    if (workspace->node_count < graph->node_count) {
+        printf("❌ Alternative route workspace is smaller than the graph\n");
+        return 0;
+    }
+    if (max_routes > MAX_ALTERNATIVE_ROUTES) {
+        max_routes = MAX_ALTERNATIVE_ROUTES;
+    }
+
+    double shortest = grow_tree(graph, &workspace->forward, workspace->forward_order,
+                                &workspace->forward_count, start, 0, end, INF);
+    workspace->backward_count = 0;
+    if (shortest >= INF || max_routes < 1) {
+        return 0;
+    }
+    double limit = shortest * (1.0 + ALTERNATIVE_STRETCH);
+    grow_tree(graph, &workspace->backward, workspace->backward_order, &workspace->backward_count,
+              end, 1, -1, limit);
+    find_plateaus(workspace);
+
+    // The shortest route is the forward tree path to end
+    workspace->forward_shared[end] = 0.0;
+    workspace->backward_shared[end] = 0.0;
+    add_route(workspace, end);
+    workspace->routes[0].plateau = shortest;
+    workspace->routes[0].via = -1;
+
+    measure_sharing(workspace);
+    while (shortest > 0.0 && workspace->route_count < max_routes) {
+        int via = best_via(workspace, shortest, limit);
+        if (via < 0) {
+            break;
+        }
+        if (add_route(workspace, via)) {
+            measure_sharing(workspace);
+        } else {
+            // Its tree paths cross: never consider that plateau again
+            workspace->plateau[via] = 0.0;
+        }
+    }
+
+    // Leave route_next all -1 for the next query
+    for (int r = 0; r < workspace->route_count; r++) {
+        const AlternativeRoute* route = &workspace->routes[r];
+        for (int i = 0; i < route->length; i++) {
+            workspace->route_next[(size_t)route->path[i] * MAX_ALTERNATIVE_ROUTES + r] = -1;
+        }
+    }
+    return workspace->route_count;
+}
+
+int alternatives_pathfind(const Graph* graph, AlternativeWorkspace* workspace, int start, int end,
+                          int* routes_found) {
+    *routes_found = 0;
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+
+    clock_t start_time = clock();
+    printf("Starting alternative routes: node %d → node %d\n", start, end);
+
+    int count = find_alternatives(graph, workspace, start, end, MAX_ALTERNATIVE_ROUTES);
+    if (count == 0) {
+        printf("❌ No path found!\n");
+        return 0;
+    }
+    *routes_found = count;
+
+    double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+    const AlternativeRoute* routes = workspace->routes;
+    printf("✅ Alternative routes completed! %d route%s, shortest %.2f km\n",
+           count, count == 1 ? "" : "s", routes[0].distance);
+    printf("   Nodes explored: %d, Time: %.4fs\n",
+           workspace->forward.settled + workspace->backward.settled, calc_time);
+    for (int r = 1; r < count; r++) {
+        printf("   Alternative %d: %.2f km (+%.0f%%), %.2f km shared, plateau %.2f km\n", r,
+               routes[r].distance, (routes[r].distance / routes[0].distance - 1.0) * 100.0,
+               routes[r].shared, routes[r].plateau);
+    }
+    return routes[0].length;
+}
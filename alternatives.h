@@ -0,0 +1,58 @@
+/**
+ * alternatives.h
+ * Alternative routes: the shortest route plus a few diverse, locally
+ * optimal alternatives, chosen through plateaus of two shortest path trees
+ */
+
+#ifndef ALTERNATIVES_H
+#define ALTERNATIVES_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define ALTERNATIVE_STRETCH 0.25    // At most 25% longer than the shortest route
+#define ALTERNATIVE_SHARING 0.8     // Shares at most 80% of the shortest length with earlier routes
+#define ALTERNATIVE_PLATEAU 0.25    // Plateau of at least a quarter of the shortest length
+
+/**
+ * Allocate a workspace for alternative route queries on graphs of
+ * node_count nodes. As with SearchWorkspace, queries using it never
+ * allocate; create one per worker thread.
+ * @return 0 on success, -1 if memory could not be allocated
+ */
+int init_alternative_workspace(AlternativeWorkspace* workspace, int node_count);
+
+/**
+ * Release the memory held by an alternative route workspace
+ */
+void free_alternative_workspace(AlternativeWorkspace* workspace);
+
+/**
+ * Shortest route and alternatives from start to end, found with one
+ * Dijkstra tree out of start and one into end (over the reverse CSR),
+ * each grown to (1 + ALTERNATIVE_STRETCH) times the shortest distance.
+ * A plateau is a run of roads on both trees; the route through it (the
+ * forward tree to it, the backward tree after it) is a shortest path
+ * along the whole plateau. Each alternative is the route through a
+ * plateau of at least ALTERNATIVE_PLATEAU of the shortest distance that
+ * is within the stretch bound, has no repeated vertex and shares at most
+ * ALTERNATIVE_SHARING of the shortest distance with the routes already
+ * chosen; among those, the one minimising 2 * length + shared - plateau.
+ * Quiet; the routes are left in workspace->routes, shortest first.
+ * @param max_routes Routes wanted, the shortest included (1 to
+ *                   MAX_ALTERNATIVE_ROUTES)
+ * @return Routes found, 0 if end is unreachable or the graph is not frozen
+ */
+int find_alternatives(const Graph* graph, AlternativeWorkspace* workspace, int start, int end,
+                      int max_routes);
+
+/**
+ * Find the shortest route and its alternatives and print each one's
+ * length, shared km and plateau with the query statistics
+ * @param routes_found Set to the number of routes left in workspace->routes
+ * @return Length of the shortest path (number of vertices), 0 if none
+ */
+int alternatives_pathfind(const Graph* graph, AlternativeWorkspace* workspace, int start, int end,
+                          int* routes_found);
+
+#endif // ALTERNATIVES_H
@@ -0,0 +1,281 @@
+/**
+ * arc_flags.c
+ * Arc-flag precomputation over a coordinate partition and pruned queries
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "arc_flags.h"
+#include "overlay.h"
+#include "heap.h"
+#include "search_workspace.h"
+#include "parallel.h"
+
+#define ARC_FLAG_MAX_THREADS 64
+
+// Boundary nodes handed to a thread: first, then every stride-th. Each
+// thread sets flags in its own copy, merged once all have finished.
+typedef struct {
+    const Graph* graph;
+    const ArcFlags* flags;
+    const int* boundary;
+    int boundary_count;
+    int first;
+    int stride;
+    unsigned char* local;
+    SearchWorkspace workspace;
+} ArcFlagWorker;
+
+static void set_flag(unsigned char* flags, int flag_bytes, int e, int r) {
+    flags[(size_t)e * flag_bytes + r / 8] |= (unsigned char)(1u << (r % 8));
+}
+
+static int has_flag(const ArcFlags* flags, int e, int r) {
+    return flags->flags[(size_t)e * flags->flag_bytes + r / 8] & (1u << (r % 8));
+}
+
+// Flag every edge of the shortest path tree into each boundary node with
+// the node's region, plus any edge tied with it, so a pruned search may
+// take whichever of several equal paths it meets first
+static void* run_arc_flag_worker(void* arg) {
+    ArcFlagWorker* worker = arg;
+    const Graph* graph = worker->graph;
+    const CSRGraph* csr = &graph->csr;
+    const ArcFlags* flags = worker->flags;
+    SearchWorkspace* ws = &worker->workspace;
+
+    for (int i = worker->first; i < worker->boundary_count; i += worker->stride) {
+        int b = worker->boundary[i];
+        int r = flags->region[b];
+        reverse_dijkstra_search(graph, ws, b);
+
+        for (int u = 0; u < graph->node_count; u++) {
+            if (ws->stamp[u] != ws->epoch || u == b) {
+                continue;
+            }
+            for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                int v = csr->targets[e];
+                if (ws->stamp[v] == ws->epoch &&
+                    (ws->previous[u] == v || ws->distance[v] + csr->weights[e] == ws->distance[u])) {
+                    set_flag(worker->local, flags->flag_bytes, e, r);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+int compute_arc_flags(const Graph* graph, ArcFlags* flags, int region_count, int thread_count) {
+    memset(flags, 0, sizeof(ArcFlags));
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before computing arc flags\n");
+        return -1;
+    }
+    if (region_count < 1 || region_count > MAX_ARC_FLAG_REGIONS) {
+        printf("❌ Arc flags need 1 to %d regions\n", MAX_ARC_FLAG_REGIONS);
+        return -1;
+    }
+
+    const CSRGraph* csr = &graph->csr;
+    int n = graph->node_count;
+    double start_time = wall_seconds();
+    flags->node_count = n;
+    flags->edge_count = csr->edge_count;
+    flags->region_count = region_count;
+    flags->flag_bytes = (region_count + 7) / 8;
+    size_t flag_size = (size_t)csr->edge_count * flags->flag_bytes;
+
+    unsigned int* partition = malloc((n > 0 ? n : 1) * sizeof(unsigned int));
+    int* boundary = malloc((n > 0 ? n : 1) * sizeof(int));
+    flags->region = malloc(n > 0 ? n : 1);
+    flags->flags = calloc(flag_size > 0 ? flag_size : 1, 1);
+    if (!partition || !boundary || !flags->region || !flags->flags ||
+        partition_by_coordinates(graph, region_count, partition) != 0) {
+        printf("❌ Out of memory: could not allocate arc flags\n");
+        free(partition);
+        free(boundary);
+        free_arc_flags(flags);
+        return -1;
+    }
+    for (int v = 0; v < n; v++) {
+        flags->region[v] = (unsigned char)partition[v];
+    }
+    free(partition);
+
+    // Roads inside a region lead to it; nodes entered from another region
+    // are where shortest paths into it cross the boundary
+    int boundary_count = 0;
+    for (int u = 0; u < n; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            if (flags->region[csr->targets[e]] == flags->region[u]) {
+                set_flag(flags->flags, flags->flag_bytes, e, flags->region[u]);
+            }
+        }
+        for (int e = csr->reverse_offsets[u]; e < csr->reverse_offsets[u + 1]; e++) {
+            if (flags->region[csr->reverse_sources[e]] != flags->region[u]) {
+                boundary[boundary_count++] = u;
+                break;
+            }
+        }
+    }
+
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > ARC_FLAG_MAX_THREADS) {
+        worker_count = ARC_FLAG_MAX_THREADS;
+    }
+    if (worker_count > boundary_count) {
+        worker_count = boundary_count > 0 ? boundary_count : 1;
+    }
+    ArcFlagWorker workers[ARC_FLAG_MAX_THREADS];
+    for (int i = 0; i < worker_count; i++) {
+        workers[i].local = calloc(flag_size > 0 ? flag_size : 1, 1);
+        if (!workers[i].local || init_search_workspace(&workers[i].workspace, n) != 0) {
+            printf("❌ Out of memory: could not allocate arc flag workers\n");
+            free(workers[i].local);
+            for (int j = 0; j < i; j++) {
+                free(workers[j].local);
+                free_search_workspace(&workers[j].workspace);
+            }
+            free(boundary);
+            free_arc_flags(flags);
+            return -1;
+        }
+        workers[i].graph = graph;
+        workers[i].flags = flags;
+        workers[i].boundary = boundary;
+        workers[i].boundary_count = boundary_count;
+        workers[i].first = i;
+        workers[i].stride = worker_count;
+    }
+
+    run_parallel(run_arc_flag_worker, workers, sizeof(ArcFlagWorker), worker_count);
+    for (int i = 0; i < worker_count; i++) {
+        for (size_t k = 0; k < flag_size; k++) {
+            flags->flags[k] |= workers[i].local[k];
+        }
+        free(workers[i].local);
+        free_search_workspace(&workers[i].workspace);
+    }
+    free(boundary);
+    flags->fingerprint = graph->csr.fingerprint;
+
+    long long set = 0;
+    for (int e = 0; e < csr->edge_count; e++) {
+        for (int r = 0; r < region_count; r++) {
+            set += has_flag(flags, e, r) != 0;
+        }
+    }
+    double total = (double)csr->edge_count * region_count;
+    printf("✅ Arc flags for %d regions (%d boundary nodes, %d threads, %.2fs): %.1f%% set, %.1f KB\n",
+           region_count, boundary_count, worker_count, wall_seconds() - start_time,
+           total > 0 ? 100.0 * set / total : 0.0, (flag_size + n) / 1024.0);
+    return 0;
+}
+
+void free_arc_flags(ArcFlags* flags) {
+    free(flags->region);
+    free(flags->flags);
+    memset(flags, 0, sizeof(ArcFlags));
+}
+
+double arc_flag_search(const Graph* graph, const ArcFlags* flags, SearchWorkspace* workspace,
+                       int start, int end, AStarHeuristic heuristic, const void* context) {
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return INF;
+    }
+    if (workspace->node_count < graph->node_count) {
+        printf("❌ Search workspace is smaller than the graph\n");
+        return INF;
+    }
+    const CSRGraph* csr = &graph->csr;
+    unsigned int epoch;
+    unsigned int* stamp = workspace->stamp;
+    double* g_costs = workspace->distance;
+    int* parents = workspace->previous;
+    MinHeap* open_set = &workspace->heap;
+    int target_region = flags->region[end];
+
+    begin_search(workspace);
+    epoch = workspace->epoch;
+    stamp[start] = epoch;
+    g_costs[start] = 0.0;
+    parents[start] = -1;
+    insert_heap(open_set, start, heuristic ? heuristic(context, start, end) : 0.0);
+
+    while (!is_empty(open_set)) {
+        int u = extract_min(open_set).vertex;
+        workspace->settled++;
+
+        if (u == end) {
+            return g_costs[end];
+        }
+
+        // Only roads starting a shortest path into the target's region
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            if (!has_flag(flags, e, target_region)) {
+                continue;
+            }
+            int v = csr->targets[e];
+            int reached = stamp[v] == epoch;
+
+            if (!reached || in_heap(open_set, v)) {
+                double tentative_g = g_costs[u] + csr->weights[e];
+
+                if (!reached || tentative_g < g_costs[v]) {
+                    stamp[v] = epoch;
+                    g_costs[v] = tentative_g;
+                    parents[v] = u;
+                    double h = heuristic ? heuristic(context, v, end) : 0.0;
+                    insert_heap(open_set, v, tentative_g + h);
+                }
+            }
+        }
+    }
+    return INF;
+}
+
+int arc_flags_pathfind(const Graph* graph, const ArcFlags* flags, int start, int end, int use_astar,
+                       int path[], double* total_cost, int* nodes_settled) {
+    *nodes_settled = 0;
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+    if (flags->node_count != graph->node_count || flags->fingerprint != graph->csr.fingerprint) {
+        printf("❌ Arc flags were computed for different weights\n");
+        return 0;
+    }
+
+    clock_t start_time = clock();
+    const char* name = use_astar ? "A*" : "Dijkstra";
+    printf("Starting %s with arc flags: node %d → node %d\n", name, start, end);
+
+    SearchWorkspace workspace;
+    if (init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate arc flag search state\n");
+        return 0;
+    }
+
+    int path_length = 0;
+    double cost = arc_flag_search(graph, flags, &workspace, start, end,
+                                  use_astar ? straight_line_heuristic : NULL, graph);
+    if (cost < INF) {
+        path_length = workspace_path(&workspace, end, path);
+        *total_cost = cost;
+        *nodes_settled = workspace.settled;
+
+        double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        printf("✅ %s with arc flags completed! Distance: %.2f km\n", name, *total_cost);
+        printf("   Nodes explored: %d, Time: %.4fs\n", workspace.settled, calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+
+    free_search_workspace(&workspace);
+    return path_length;
+}
@@ -0,0 +1,55 @@
+/**
+ * arc_flags.h
+ * Arc flags: per-edge region bitsets that let a search skip roads leading
+ * nowhere near the target's region
+ */
+
+#ifndef ARC_FLAGS_H
+#define ARC_FLAGS_H
+
+#include "gps_types.h"
+#include "graph.h"
+#include "pathfinding.h"
+
+#define MAX_ARC_FLAG_REGIONS 64
+#define DEFAULT_ARC_FLAG_REGIONS 16
+
+/**
+ * Partition the nodes into region_count regions by coordinates (see
+ * partition_by_coordinates) and flag each edge with every region it
+ * starts a shortest path into: one backward search per region boundary
+ * node, the boundary nodes shared among threads. The graph must be
+ * frozen; the flags follow its current weights.
+ * @param region_count Regions, 1 to MAX_ARC_FLAG_REGIONS
+ * @param thread_count Worker threads, or 0 for one per online CPU
+ * @return 0 on success, -1 if the graph is not frozen or memory runs out
+ */
+int compute_arc_flags(const Graph* graph, ArcFlags* flags, int region_count, int thread_count);
+
+/**
+ * Release the memory held by arc flags
+ */
+void free_arc_flags(ArcFlags* flags);
+
+/**
+ * Dijkstra (heuristic NULL) or A* that only follows edges flagged for the
+ * target's region. Quiet, like astar_search_with; the path is left in the
+ * workspace for workspace_path.
+ * @return Path cost in km, INF if there is no path
+ */
+double arc_flag_search(const Graph* graph, const ArcFlags* flags, SearchWorkspace* workspace,
+                       int start, int end, AStarHeuristic heuristic, const void* context);
+
+/**
+ * Find the shortest path with arc-flag pruning and print the query
+ * statistics
+ * @param use_astar Order the search by straight-line distance to end
+ * @param path Array to store the path vertices (node_count entries)
+ * @param total_cost Pointer to store total path cost
+ * @param nodes_settled Set to the vertices the search settled
+ * @return Length of the path (number of vertices)
+ */
+int arc_flags_pathfind(const Graph* graph, const ArcFlags* flags, int start, int end, int use_astar,
+                       int path[], double* total_cost, int* nodes_settled);
+
+#endif // ARC_FLAGS_H
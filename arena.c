@@ -0,0 +1,62 @@
+/**
+ * arena.c
+ * Bump/slab arena allocator implementation
+ */
+
+#include <stdlib.h>
+#include "arena.h"
+
+#define ARENA_ALIGNMENT 16
+#define ARENA_MIN_BLOCK (64 * 1024)         // First slab: 64 KB
+#define ARENA_MAX_BLOCK (16 * 1024 * 1024)  // Slabs stop doubling at 16 MB
+
+static size_t align_up(size_t size) {
+    return (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+void arena_init(Arena* arena) {
+    arena->head = NULL;
+    arena->next_block_size = ARENA_MIN_BLOCK;
+    arena->bytes_allocated = 0;
+    arena->bytes_used = 0;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size = align_up(size);
+    ArenaBlock* block = arena->head;
+    
+    if (!block || block->size - block->used < size) {
+        size_t block_size = arena->next_block_size > 0 ? arena->next_block_size : ARENA_MIN_BLOCK;
+        while (block_size < size) {
+            block_size *= 2;
+        }
+        
+        // Header is padded so data[] starts on an aligned boundary
+        block = malloc(align_up(sizeof(ArenaBlock)) + block_size);
+        if (!block) {
+            return NULL;
+        }
+        block->next = arena->head;
+        block->used = align_up(sizeof(ArenaBlock)) - sizeof(ArenaBlock);
+        block->size = block_size + block->used;
+        arena->head = block;
+        arena->bytes_allocated += block_size;
+        
+        arena->next_block_size = block_size < ARENA_MAX_BLOCK ? block_size * 2 : ARENA_MAX_BLOCK;
+    }
+    
+    void* memory = block->data + block->used;
+    block->used += size;
+    arena->bytes_used += size;
+    return memory;
+}
+
+void arena_release(Arena* arena) {
+    ArenaBlock* block = arena->head;
+    while (block != NULL) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    arena_init(arena);
+}
@@ -0,0 +1,43 @@
+/**
+ * arena.h
+ * Bump/slab arena allocator for bulk graph construction
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// One slab of arena memory; allocations are carved from data[] in order
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    size_t size;
+    unsigned char data[];
+} ArenaBlock;
+
+// Arena: a chain of slabs that is only ever released as a whole
+typedef struct {
+    ArenaBlock* head;
+    size_t next_block_size;
+    size_t bytes_allocated;     // Sum of slab sizes (what the arena holds)
+    size_t bytes_used;          // Sum of allocation sizes handed out
+} Arena;
+
+/**
+ * Initialize an empty arena (no memory is reserved until the first alloc)
+ */
+void arena_init(Arena* arena);
+
+/**
+ * Allocate `size` bytes aligned for any scalar type
+ * @return Pointer into the arena, or NULL if a new slab could not be allocated
+ */
+void* arena_alloc(Arena* arena, size_t size);
+
+/**
+ * Release every slab at once; all pointers from this arena become invalid
+ */
+void arena_release(Arena* arena);
+
+#endif // ARENA_H
@@ -0,0 +1,304 @@
+/**
+ * batch_query.c
+ * Query parsing, the work-stealing worker pool and batch statistics
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "batch_query.h"
+#include "pathfinding.h"
+#include "contraction.h"
+#include "search_workspace.h"
+#include "parallel.h"
+
+#define QUERY_LINE_LENGTH 256
+
+static const char* algorithm_names[] = { "dijkstra", "astar", "bidirectional", "ch" };
+
+// Queries [next, end) still to be answered by a worker. The owner takes
+// from next; a thief takes the upper half by lowering end.
+typedef struct {
+    pthread_mutex_t lock;
+    int next;
+    int end;
+} QueryRange;
+
+typedef struct Worker Worker;
+
+// State shared by the whole pool
+typedef struct {
+    const Graph* graph;
+    const ContractionHierarchy* ch;
+    const BatchQuery* queries;
+    BatchResult* results;
+    Worker* workers;
+    int worker_count;
+} BatchPool;
+
+struct Worker {
+    BatchPool* pool;
+    int id;
+    QueryRange range;
+    SearchWorkspace forward;
+    SearchWorkspace backward;
+    long steals;
+};
+
+int parse_query_algorithm(const char* name, QueryAlgorithm* algorithm) {
+    for (int a = QUERY_DIJKSTRA; a <= QUERY_CH; a++) {
+        if (strcmp(name, algorithm_names[a]) == 0) {
+            *algorithm = (QueryAlgorithm)a;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+const char* query_algorithm_name(QueryAlgorithm algorithm) {
+    return algorithm_names[algorithm];
+}
+
+int read_batch_queries(FILE* input, const Graph* graph, BatchQuery** queries, int* count) {
+    int capacity = 256;
+    *count = 0;
+    *queries = malloc(capacity * sizeof(BatchQuery));
+    if (!*queries) {
+        printf("❌ Out of memory: could not read queries\n");
+        return -1;
+    }
+
+    char line[QUERY_LINE_LENGTH];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), input) != NULL) {
+        line_number++;
+        char name[32] = "dijkstra";
+        int start, end;
+        char* text = line + strspn(line, " \t");
+        if (*text == '\0' || *text == '\n' || *text == '\r' || *text == '#') {
+            continue;
+        }
+
+        BatchQuery query;
+        int fields = sscanf(text, "%d %d %31s", &start, &end, name);
+        if (fields < 2 || parse_query_algorithm(name, &query.algorithm) != 0) {
+            printf("❌ Line %d: expected \"start end [dijkstra|astar|bidirectional|ch]\"\n", line_number);
+            free(*queries);
+            *queries = NULL;
+            return -1;
+        }
+        if (start < 0 || start >= graph->node_count || end < 0 || end >= graph->node_count) {
+            printf("❌ Line %d: location index outside the graph (0 to %d)\n",
+                   line_number, graph->node_count - 1);
+            free(*queries);
+            *queries = NULL;
+            return -1;
+        }
+        query.start = start;
+        query.end = end;
+
+        if (*count == capacity) {
+            capacity *= 2;
+            BatchQuery* grown = realloc(*queries, capacity * sizeof(BatchQuery));
+            if (!grown) {
+                printf("❌ Out of memory: could not read queries\n");
+                free(*queries);
+                *queries = NULL;
+                return -1;
+            }
+            *queries = grown;
+        }
+        (*queries)[(*count)++] = query;
+    }
+    return 0;
+}
+
+static void answer_query(Worker* worker, int index) {
+    const BatchPool* pool = worker->pool;
+    const BatchQuery* query = &pool->queries[index];
+    BatchResult* result = &pool->results[index];
+    int meeting;
+
+    double start_time = wall_seconds();
+    switch (query->algorithm) {
+        case QUERY_DIJKSTRA:
+            result->distance = dijkstra_search(pool->graph, &worker->forward, query->start, query->end);
+            result->settled = worker->forward.settled;
+            break;
+        case QUERY_ASTAR:
+            result->distance = astar_search(pool->graph, &worker->forward, query->start, query->end);
+            result->settled = worker->forward.settled;
+            break;
+        case QUERY_BIDIRECTIONAL:
+            result->distance = bidirectional_search(pool->graph, &worker->forward, &worker->backward,
+                                                    query->start, query->end, &meeting);
+            result->settled = worker->forward.settled + worker->backward.settled;
+            break;
+        case QUERY_CH:
+            result->distance = ch_search(pool->ch, &worker->forward, &worker->backward,
+                                         query->start, query->end, &meeting);
+            result->settled = worker->forward.settled + worker->backward.settled;
+            break;
+    }
+    result->seconds = wall_seconds() - start_time;
+}
+
+// Next query of the worker's own range, -1 once it is empty
+static int take_query(Worker* worker) {
+    int index = -1;
+    pthread_mutex_lock(&worker->range.lock);
+    if (worker->range.next < worker->range.end) {
+        index = worker->range.next++;
+    }
+    pthread_mutex_unlock(&worker->range.lock);
+    return index;
+}
+
+// Move the upper half of another worker's remaining queries into this
+// worker's (empty) range; 0 once every range is empty
+static int steal_queries(Worker* worker) {
+    BatchPool* pool = worker->pool;
+    for (int k = 1; k < pool->worker_count; k++) {
+        Worker* victim = &pool->workers[(worker->id + k) % pool->worker_count];
+        pthread_mutex_lock(&victim->range.lock);
+        int remaining = victim->range.end - victim->range.next;
+        int first = victim->range.end - (remaining + 1) / 2;
+        int end = victim->range.end;
+        if (remaining > 0) {
+            victim->range.end = first;
+        }
+        pthread_mutex_unlock(&victim->range.lock);
+
+        if (remaining > 0) {
+            pthread_mutex_lock(&worker->range.lock);
+            worker->range.next = first;
+            worker->range.end = end;
+            pthread_mutex_unlock(&worker->range.lock);
+            worker->steals++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void* run_batch_worker(void* arg) {
+    Worker* worker = arg;
+    for (;;) {
+        int index = take_query(worker);
+        if (index >= 0) {
+            answer_query(worker, index);
+        } else if (!steal_queries(worker)) {
+            break;
+        }
+    }
+    return NULL;
+}
+
+static int compare_seconds(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Latency percentiles and throughput of a finished batch
+static int summarize_batch(const BatchResult* results, int count, BatchStats* stats) {
+    double* latencies = malloc((count > 0 ? count : 1) * sizeof(double));
+    if (!latencies) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        latencies[i] = results[i].seconds;
+    }
+    qsort(latencies, count, sizeof(double), compare_seconds);
+    stats->p50 = count > 0 ? latencies[(count - 1) / 2] : 0.0;
+    stats->p99 = count > 0 ? latencies[(int)((count - 1) * 0.99)] : 0.0;
+    stats->queries_per_second = stats->seconds > 0.0 ? count / stats->seconds : 0.0;
+    free(latencies);
+    return 0;
+}
+
+int run_batch_queries(const Graph* graph, const ContractionHierarchy* ch,
+                      const BatchQuery* queries, int count, int thread_count,
+                      BatchResult* results, BatchStats* stats) {
+    memset(stats, 0, sizeof(BatchStats));
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return -1;
+    }
+    int ch_usable = ch && ch->node_count == graph->node_count &&
+                    ch->fingerprint == graph->csr.fingerprint;
+    for (int i = 0; i < count; i++) {
+        if (queries[i].algorithm == QUERY_CH && !ch_usable) {
+            printf("❌ Query %d needs a contraction hierarchy for this graph\n", i + 1);
+            return -1;
+        }
+    }
+
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > BATCH_MAX_THREADS) {
+        worker_count = BATCH_MAX_THREADS;
+    }
+    Worker workers[BATCH_MAX_THREADS];
+    BatchPool pool = { graph, ch, queries, results, workers, worker_count };
+    for (int i = 0; i < worker_count; i++) {
+        if (init_search_workspace(&workers[i].forward, graph->node_count) != 0 ||
+            init_search_workspace(&workers[i].backward, graph->node_count) != 0) {
+            printf("❌ Out of memory: could not allocate batch workers\n");
+            free_search_workspace(&workers[i].forward);
+            for (int j = 0; j < i; j++) {
+                free_search_workspace(&workers[j].forward);
+                free_search_workspace(&workers[j].backward);
+                pthread_mutex_destroy(&workers[j].range.lock);
+            }
+            return -1;
+        }
+        workers[i].pool = &pool;
+        workers[i].id = i;
+        workers[i].steals = 0;
+        workers[i].range.next = (int)((long long)count * i / worker_count);
+        workers[i].range.end = (int)((long long)count * (i + 1) / worker_count);
+        pthread_mutex_init(&workers[i].range.lock, NULL);
+    }
+
+    double start_time = wall_seconds();
+    run_parallel(run_batch_worker, workers, sizeof(Worker), worker_count);
+    stats->seconds = wall_seconds() - start_time;
+
+    for (int i = 0; i < worker_count; i++) {
+        stats->steals += workers[i].steals;
+        free_search_workspace(&workers[i].forward);
+        free_search_workspace(&workers[i].backward);
+        pthread_mutex_destroy(&workers[i].range.lock);
+    }
+    stats->query_count = count;
+    stats->thread_count = worker_count;
+    if (summarize_batch(results, count, stats) != 0) {
+        printf("❌ Out of memory: could not summarize batch\n");
+        return -1;
+    }
+    return 0;
+}
+
+void write_batch_results(FILE* output, const BatchQuery* queries, const BatchResult* results, int count) {
+    for (int i = 0; i < count; i++) {
+        fprintf(output, "%d %d %s ", queries[i].start, queries[i].end,
+                query_algorithm_name(queries[i].algorithm));
+        if (results[i].distance < INF) {
+            fprintf(output, "%.6f", results[i].distance);
+        } else {
+            fprintf(output, "unreachable");
+        }
+        fprintf(output, " %d %.1f\n", results[i].settled, results[i].seconds * 1e6);
+    }
+}
+
+void print_batch_stats(const BatchStats* stats) {
+    printf("✅ %d queries on %d threads in %.3fs: %.0f queries/s\n",
+           stats->query_count, stats->thread_count, stats->seconds, stats->queries_per_second);
+    printf("   Latency p50: %.1f us, p99: %.1f us, ranges stolen: %ld\n",
+           stats->p50 * 1e6, stats->p99 * 1e6, stats->steals);
+}
@@ -0,0 +1,91 @@
+/**
+ * batch_query.h
+ * Batch query engine: many routes answered by a pool of worker threads
+ * sharing one read-only graph
+ */
+
+#ifndef BATCH_QUERY_H
+#define BATCH_QUERY_H
+
+#include <stdio.h>
+#include "gps_types.h"
+#include "graph.h"
+
+#define BATCH_MAX_THREADS 64
+
+typedef enum {
+    QUERY_DIJKSTRA,
+    QUERY_ASTAR,
+    QUERY_BIDIRECTIONAL,
+    QUERY_CH                // Needs a contraction hierarchy for the graph
+} QueryAlgorithm;
+
+typedef struct {
+    int start;
+    int end;
+    QueryAlgorithm algorithm;
+} BatchQuery;
+
+typedef struct {
+    double distance;        // km, INF if there is no path
+    int settled;
+    double seconds;         // Latency of this query alone
+} BatchResult;
+
+typedef struct {
+    int query_count;
+    int thread_count;
+    double seconds;         // Wall time of the whole batch
+    double queries_per_second;
+    double p50;             // Median query latency in seconds
+    double p99;
+    long steals;            // Query ranges taken from another worker
+} BatchStats;
+
+/**
+ * Algorithm named dijkstra, astar, bidirectional or ch
+ * @return 0 on success, -1 for an unknown name
+ */
+int parse_query_algorithm(const char* name, QueryAlgorithm* algorithm);
+
+/**
+ * Name accepted by parse_query_algorithm
+ */
+const char* query_algorithm_name(QueryAlgorithm algorithm);
+
+/**
+ * Read "start end [algorithm]" lines (default dijkstra); blank lines and
+ * lines starting with # are skipped
+ * @param queries Set to a malloc'd array the caller frees
+ * @return 0 on success, -1 on a malformed line, an index outside the
+ *         graph or if memory runs out
+ */
+int read_batch_queries(FILE* input, const Graph* graph, BatchQuery** queries, int* count);
+
+/**
+ * Answer every query on a pool of worker threads, each with its own
+ * search workspaces, over the shared frozen graph. Each worker starts
+ * with a contiguous share of the queries and, once it runs out, steals
+ * half of the remaining share of another worker.
+ * @param ch Hierarchy built for graph, or NULL if no query uses ch
+ * @param thread_count Workers, or 0 for one per online CPU
+ * @param results count entries, filled in input order
+ * @return 0 on success, -1 if the graph is not frozen, a query needs a
+ *         missing hierarchy or memory runs out
+ */
+int run_batch_queries(const Graph* graph, const ContractionHierarchy* ch,
+                      const BatchQuery* queries, int count, int thread_count,
+                      BatchResult* results, BatchStats* stats);
+
+/**
+ * Write one "start end algorithm distance settled microseconds" line per
+ * query, in input order
+ */
+void write_batch_results(FILE* output, const BatchQuery* queries, const BatchResult* results, int count);
+
+/**
+ * Print throughput and latency percentiles
+ */
+void print_batch_stats(const BatchStats* stats);
+
+#endif // BATCH_QUERY_H
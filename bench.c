@@ -0,0 +1,1722 @@
+/**
+ * bench.c
+ * Performance benchmarks for TrackMate on synthetic road grids
+ *
+ * Usage: ./trackmate_bench [benchmark] [grid side]
+ *   csr          - Relaxations per second, linked-list vs CSR adjacency
+ *   build        - Build/teardown time and peak RSS with the edge arena
+ *   build-malloc - The same load with one malloc per edge (previous scheme)
+ *   reorder      - Time per settled node with random, Hilbert and BFS numbering
+ *   mmap         - Startup time: build from scratch vs open a binary graph file
+ *   osm          - OpenStreetMap XML import throughput, 1 thread vs 4 threads
+ *   network      - CSV node/edge loader rows per second, 1 thread vs 4 threads
+ *   heap         - Priority queue cost per query with 2-, 4- and 8-ary heaps
+ *   radix        - Query time, binary heap vs radix heap on integer metres
+ *   workspace    - Short queries with per-query state vs a reused workspace
+ *   bidir        - Nodes settled and query time, forward vs bidirectional Dijkstra
+ *   ch           - Contraction hierarchy preprocessing, file load and query time
+ *   alt          - Nodes settled by A* with straight-line vs landmark bounds
+ *   overlay      - Multi-level overlay partition, customization and query time
+ *   hl           - Hub label size, mapped load time and lookups, SSE2 vs scalar
+ *   arcflags     - Arc flag precomputation, nodes settled with and without pruning
+ *   matrix       - 500 x 2000 distance matrix: buckets vs Dijkstra, threads, file output
+ *   batch        - Batch query throughput and p50/p99 latency on 1 to 8 worker threads
+ *   td           - Time-dependent queries: profiles vs localtime() per relaxed edge
+ *   alternatives - Alternative routes: plateaus of two search trees vs repeated penalized Dijkstra
+ * Run the two build benchmarks as separate processes so peak RSS is not shared.
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "gps_types.h"
+#include "graph.h"
+#include "heap.h"
+#include "pathfinding.h"
+#include "distance.h"
+#include "reorder.h"
+#include "graph_file.h"
+#include "osm_import.h"
+#include "network_loader.h"
+#include "contraction.h"
+#include "traffic.h"
+#include "landmarks.h"
+#include "overlay.h"
+#include "hub_labels.h"
+#include "arc_flags.h"
+#include "distance_matrix.h"
+#include "batch_query.h"
+#include "time_dependent.h"
+#include "alternatives.h"
+#include "parallel.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#define DEFAULT_GRID_SIDE 300
+#define BENCH_QUERIES 20
+#define BUILD_GRID_SIDE 1582    // 2 * 1582 * 1581 = ~5M roads
+#define REORDER_GRID_SIDE 1000   // 1M nodes: well beyond the CPU caches
+#define MMAP_GRID_SIDE 1000
+#define BENCH_GRAPH_FILE "bench_graph.tmg"
+#define OSM_GRID_SIDE 1400      // ~270 MB of XML, a metro-area extract
+#define BENCH_OSM_FILE "bench_grid.osm"
+#define OSM_BENCH_THREADS 4
+#define HEAP_GRID_SIDE 1000
+#define WORKSPACE_QUERIES 2000
+#define NETWORK_GRID_SIDE 1000  // 1M node rows, ~2.2M edge rows
+#define BENCH_NODES_FILE "bench_nodes.csv"
+#define BENCH_EDGES_FILE "bench_edges.csv"
+#define CH_GRID_SIDE 300     // Preprocessing is superlinear on grids
+#define CH_QUERIES 1000
+#define BENCH_HIERARCHY_FILE "bench_grid.tmch"
+#define ALT_GRID_SIDE 500
+#define ALT_LANDMARKS 16
+#define ALT_RUSH_HOUR 8      // Congested roads leave the straight-line bound loose
+#define OVERLAY_GRID_SIDE 500   // 250k nodes, a city
+#define HL_GRID_SIDE 200
+#define HL_LOOKUPS 1000000
+#define HL_HOT_NODES 512     // Their labels fit in L2
+#define BENCH_LABEL_FILE "bench_grid.tmhl"
+#define ARC_FLAG_GRID_SIDE 200
+#define MATRIX_GRID_SIDE 200
+#define MATRIX_SOURCES 500      // Vehicles
+#define MATRIX_TARGETS 2000     // Orders
+#define MATRIX_PAIR_SAMPLES 200 // Single-pair Dijkstra runs the baseline is extrapolated from
+#define BENCH_MATRIX_FILE "bench_matrix.tmdm"
+#define BATCH_GRID_SIDE 200
+#define BATCH_QUERIES 2000
+#define TD_GRID_SIDE 300
+#define TD_DEPARTURE (17 * 60.0 + 45)   // Into the evening rush
+#define ALTERNATIVES_GRID_SIDE 300
+#define PENALTY_FACTOR 1.4      // Roads already on a route, for the penalty baseline
+
+static double elapsed_seconds(clock_t start) {
+    return ((double)(clock() - start)) / CLOCKS_PER_SEC;
+}
+
+static long peak_rss_kb(void) {
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        return usage.ru_maxrss;
+    }
+#endif
+    return -1;
+}
+
+static int add_grid_locations(Graph* graph, int side) {
+    if (init_graph(graph) != 0 || reserve_nodes(graph, side * side) != 0) {
+        return -1;
+    }
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            add_location(graph, r * side + c, "grid", 18.90 + r * 0.002, 72.80 + c * 0.002);
+        }
+    }
+    return 0;
+}
+
+/**
+ * Road list of a side x side grid as (from, to) pairs, in shuffled order
+ * like a real export, so linked-list edges built from it end up scattered
+ * across the heap instead of conveniently sequential.
+ */
+static int* make_grid_roads(int side, int* road_count) {
+    *road_count = 2 * side * (side - 1);
+    int* roads = malloc((size_t)*road_count * 2 * sizeof(int));
+    if (!roads) {
+        return NULL;
+    }
+
+    int n = 0;
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int u = r * side + c;
+            if (c + 1 < side) { roads[2*n] = u; roads[2*n + 1] = u + 1; n++; }
+            if (r + 1 < side) { roads[2*n] = u; roads[2*n + 1] = u + side; n++; }
+        }
+    }
+
+    srand(42);
+    for (int i = *road_count - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int from = roads[2*i], to = roads[2*i + 1];
+        roads[2*i] = roads[2*j];
+        roads[2*i + 1] = roads[2*j + 1];
+        roads[2*j] = from;
+        roads[2*j + 1] = to;
+    }
+    return roads;
+}
+
+// Grid of locations around Mumbai joined by shuffled bidirectional roads
+static int build_grid(Graph* graph, int side) {
+    int road_count;
+    int* roads = make_grid_roads(side, &road_count);
+    if (add_grid_locations(graph, side) != 0 || !roads) {
+        free(roads);
+        return -1;
+    }
+    for (int i = 0; i < road_count; i++) {
+        add_edge(graph, roads[2*i], roads[2*i + 1]);
+    }
+    free(roads);
+    return 0;
+}
+
+// One full Dijkstra over the linked-list adjacency; returns relaxations
+static long list_dijkstra(const Graph* graph, int start, double distances[], MinHeap* heap) {
+    long relaxations = 0;
+    for (int i = 0; i < graph->node_count; i++) distances[i] = INF;
+    distances[start] = 0.0;
+    clear_heap(heap);
+    insert_heap(heap, start, 0.0);
+
+    while (!is_empty(heap)) {
+        PQNode current = extract_min(heap);
+        int u = current.vertex;
+
+        for (Edge* edge = graph->edge_lists[u]; edge != NULL; edge = edge->next) {
+            double alt = distances[u] + edge->current_weight;
+            relaxations++;
+            if (alt < distances[edge->destination]) {
+                distances[edge->destination] = alt;
+                insert_heap(heap, edge->destination, alt);
+            }
+        }
+    }
+    return relaxations;
+}
+
+// The same search over the frozen CSR adjacency
+static long csr_dijkstra(const Graph* graph, int start, double distances[], MinHeap* heap,
+                         long* settled) {
+    const CSRGraph* csr = &graph->csr;
+    long relaxations = 0;
+    for (int i = 0; i < graph->node_count; i++) distances[i] = INF;
+    distances[start] = 0.0;
+    clear_heap(heap);
+    insert_heap(heap, start, 0.0);
+
+    while (!is_empty(heap)) {
+        PQNode current = extract_min(heap);
+        int u = current.vertex;
+        if (settled) (*settled)++;
+
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            double alt = distances[u] + csr->weights[e];
+            relaxations++;
+            if (alt < distances[csr->targets[e]]) {
+                distances[csr->targets[e]] = alt;
+                insert_heap(heap, csr->targets[e], alt);
+            }
+        }
+    }
+    return relaxations;
+}
+
+static void bench_csr(int side) {
+    printf("🔬 Adjacency layout benchmark (%dx%d grid)\n", side, side);
+    printf("══════════════════════════════════════════\n");
+
+    Graph graph;
+    if (build_grid(&graph, side) != 0 || freeze_graph(&graph) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    print_graph_stats(&graph);
+
+    double* distances = malloc((size_t)graph.node_count * sizeof(double));
+    MinHeap heap;
+    if (!distances || init_heap(&heap, graph.node_count) != 0) {
+        printf("❌ Out of memory\n");
+        free(distances);
+        return;
+    }
+
+    long list_relaxations = 0, csr_relaxations = 0;
+    clock_t t = clock();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        list_relaxations += list_dijkstra(&graph, (q * 7919) % graph.node_count, distances, &heap);
+    }
+    double list_time = elapsed_seconds(t);
+
+    t = clock();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        csr_relaxations += csr_dijkstra(&graph, (q * 7919) % graph.node_count, distances, &heap, NULL);
+    }
+    double csr_time = elapsed_seconds(t);
+
+    printf("\n%-12s %14s %10s %16s\n", "Layout", "Relaxations", "Time (s)", "Relax/sec");
+    printf("%-12s %14ld %10.3f %16.0f\n", "linked-list", list_relaxations, list_time,
+           list_relaxations / list_time);
+    printf("%-12s %14ld %10.3f %16.0f\n", "CSR", csr_relaxations, csr_time,
+           csr_relaxations / csr_time);
+    printf("\n⚡ CSR speedup: %.2fx\n", list_time / csr_time);
+
+    free_heap(&heap);
+    free(distances);
+    cleanup_graph(&graph);
+}
+
+// Previous construction scheme: two mallocs per road, one free per edge,
+// with the original 64-byte edge record carrying its road type string
+typedef struct LegacyEdge {
+    int destination;
+    double base_distance;
+    double current_weight;
+    char road_type[20];
+    int traffic_factor;
+    double speed_limit;
+    struct LegacyEdge* next;
+} LegacyEdge;
+
+static void legacy_add_edge(const Graph* graph, LegacyEdge** lists, int from, int to) {
+    double distance = haversine_distance(
+        graph->nodes.latitude[from], graph->nodes.longitude[from],
+        graph->nodes.latitude[to], graph->nodes.longitude[to]
+    );
+    LegacyEdge* forward = malloc(sizeof(LegacyEdge));
+    LegacyEdge* reverse = malloc(sizeof(LegacyEdge));
+    forward->destination = to;
+    forward->base_distance = forward->current_weight = distance;
+    strcpy(forward->road_type, "main");
+    forward->traffic_factor = 1;
+    forward->speed_limit = 50.0;
+    forward->next = lists[from];
+    lists[from] = forward;
+    *reverse = *forward;
+    reverse->destination = from;
+    reverse->next = lists[to];
+    lists[to] = reverse;
+}
+
+static void bench_build(int side, int use_malloc) {
+    printf("🏗️  Graph construction benchmark (%dx%d grid, %s)\n", side, side,
+           use_malloc ? "malloc per edge" : "edge arena");
+    printf("══════════════════════════════════════════════════════\n");
+
+    Graph graph;
+    int road_count;
+    int* roads = make_grid_roads(side, &road_count);
+    LegacyEdge** lists = use_malloc ? calloc((size_t)side * side, sizeof(LegacyEdge*)) : NULL;
+    if (add_grid_locations(&graph, side) != 0 || !roads || (use_malloc && !lists)) {
+        printf("❌ Could not set up benchmark graph\n");
+        cleanup_graph(&graph);
+        free(roads);
+        free(lists);
+        return;
+    }
+    long rss_before = peak_rss_kb();
+
+    clock_t t = clock();
+    for (int i = 0; i < road_count; i++) {
+        if (use_malloc) {
+            legacy_add_edge(&graph, lists, roads[2*i], roads[2*i + 1]);
+        } else {
+            add_edge(&graph, roads[2*i], roads[2*i + 1]);
+        }
+    }
+    double build_time = elapsed_seconds(t);
+    long rss_after = peak_rss_kb();
+
+    t = clock();
+    if (use_malloc) {
+        for (int i = 0; i < graph.node_count; i++) {
+            LegacyEdge* edge = lists[i];
+            while (edge != NULL) {
+                LegacyEdge* temp = edge;
+                edge = edge->next;
+                free(temp);
+            }
+        }
+        free(lists);
+    }
+    cleanup_graph(&graph);
+    double teardown_time = elapsed_seconds(t);
+    free(roads);
+
+    printf("Roads added:     %d (%d directed edges)\n", road_count, 2 * road_count);
+    printf("Build time:      %.3f s (%.0f roads/sec)\n", build_time, road_count / build_time);
+    printf("Teardown time:   %.3f s\n", teardown_time);
+    printf("Peak RSS:        %.1f MB (edges: %.1f MB)\n",
+           rss_after / 1024.0, (rss_after - rss_before) / 1024.0);
+}
+
+// Average time per settled node over queries from fixed original nodes
+static double time_per_settled_node(Graph* graph, double distances[], MinHeap* heap) {
+    if (freeze_graph(graph) != 0) {
+        return -1.0;
+    }
+    long settled = 0;
+    clock_t t = clock();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int source = current_node_index(graph, (q * 7919) % graph->node_count);
+        csr_dijkstra(graph, source, distances, heap, &settled);
+    }
+    return elapsed_seconds(t) * 1e9 / (double)settled;
+}
+
+static void bench_reorder(int side) {
+    printf("🧭 Node numbering benchmark (%dx%d grid)\n", side, side);
+    printf("═══════════════════════════════════════\n");
+
+    Graph graph;
+    if (build_grid(&graph, side) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+
+    // Imported graphs arrive in arbitrary order: start from a random numbering
+    int* shuffle = malloc((size_t)graph.node_count * sizeof(int));
+    double* distances = malloc((size_t)graph.node_count * sizeof(double));
+    MinHeap heap;
+    if (!shuffle || !distances || init_heap(&heap, graph.node_count) != 0) {
+        printf("❌ Out of memory\n");
+        free(shuffle);
+        free(distances);
+        cleanup_graph(&graph);
+        return;
+    }
+    for (int i = 0; i < graph.node_count; i++) shuffle[i] = i;
+    for (int i = graph.node_count - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = shuffle[i];
+        shuffle[i] = shuffle[j];
+        shuffle[j] = t;
+    }
+    apply_node_permutation(&graph, shuffle);
+
+    printf("\n%-10s %18s\n", "Order", "ns/settled node");
+    printf("%-10s %18.1f\n", "random", time_per_settled_node(&graph, distances, &heap));
+    reorder_graph(&graph, ORDER_HILBERT);
+    printf("%-10s %18.1f\n", "hilbert", time_per_settled_node(&graph, distances, &heap));
+    apply_node_permutation(&graph, shuffle);
+    reorder_graph(&graph, ORDER_BFS);
+    printf("%-10s %18.1f\n", "bfs", time_per_settled_node(&graph, distances, &heap));
+
+    free_heap(&heap);
+    free(shuffle);
+    free(distances);
+    cleanup_graph(&graph);
+}
+
+static void bench_mmap(int side) {
+    printf("📂 Startup benchmark (%dx%d grid)\n", side, side);
+    printf("════════════════════════════════\n");
+
+    Graph graph;
+    double t = wall_seconds();
+    if (build_grid(&graph, side) != 0 || freeze_graph(&graph) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    double build_time = wall_seconds() - t;
+
+    t = wall_seconds();
+    int saved = save_graph_file(&graph, BENCH_GRAPH_FILE);
+    double save_time = wall_seconds() - t;
+    cleanup_graph(&graph);
+    if (saved != 0) {
+        return;
+    }
+
+    t = wall_seconds();
+    if (open_graph_file(&graph, BENCH_GRAPH_FILE, 0) != 0) {
+        remove(BENCH_GRAPH_FILE);
+        return;
+    }
+    double open_time = wall_seconds() - t;
+    size_t file_size = graph.mapping_size;
+    cleanup_graph(&graph);
+
+    t = wall_seconds();
+    if (open_graph_file(&graph, BENCH_GRAPH_FILE, 1) != 0) {
+        remove(BENCH_GRAPH_FILE);
+        return;
+    }
+    double verify_time = wall_seconds() - t;
+
+    // First query on the mapped graph pays for the page faults it triggers
+    double* distances = malloc((size_t)graph.node_count * sizeof(double));
+    MinHeap heap;
+    double query_time = -1.0;
+    if (distances && init_heap(&heap, graph.node_count) == 0) {
+        t = wall_seconds();
+        csr_dijkstra(&graph, 0, distances, &heap, NULL);
+        query_time = wall_seconds() - t;
+        free_heap(&heap);
+    }
+    free(distances);
+    cleanup_graph(&graph);
+    remove(BENCH_GRAPH_FILE);
+
+    printf("File size:              %.1f MB\n", file_size / (1024.0 * 1024.0));
+    printf("Build + freeze:         %.3f s\n", build_time);
+    printf("Save graph file:        %.3f s\n", save_time);
+    printf("Open (mmap):            %.6f s\n", open_time);
+    printf("Open + verify checksum: %.3f s\n", verify_time);
+    printf("First full Dijkstra:    %.3f s\n", query_time);
+}
+
+// The grid as OSM XML: one residential way per row and column, every
+// fifth row one-way, plus the tags and attributes a real extract carries
+static int write_grid_osm(int side, const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        return -1;
+    }
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<osm version=\"0.6\">\n");
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            fprintf(file, " <node id=\"%d\" version=\"3\" timestamp=\"2024-01-01T00:00:00Z\" "
+                    "lat=\"%.7f\" lon=\"%.7f\"/>\n",
+                    1000000 + r * side + c, 18.90 + r * 0.002, 72.80 + c * 0.002);
+        }
+    }
+    for (int line = 0; line < 2 * side; line++) {
+        int is_row = line < side;
+        int index = is_row ? line : line - side;
+        fprintf(file, " <way id=\"%d\" version=\"1\">\n", 500000 + line);
+        for (int k = 0; k < side; k++) {
+            int node = is_row ? index * side + k : k * side + index;
+            fprintf(file, "  <nd ref=\"%d\"/>\n", 1000000 + node);
+        }
+        fprintf(file, "  <tag k=\"highway\" v=\"residential\"/>\n");
+        fprintf(file, "  <tag k=\"name\" v=\"Grid Road %d\"/>\n", line);
+        if (is_row && index % 5 == 0) {
+            fprintf(file, "  <tag k=\"oneway\" v=\"yes\"/>\n");
+        }
+        fprintf(file, " </way>\n");
+    }
+    fprintf(file, "</osm>\n");
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+static void bench_osm(int side) {
+    printf("🗺️  OpenStreetMap import benchmark (%dx%d grid)\n", side, side);
+    printf("══════════════════════════════════════════════\n");
+    if (write_grid_osm(side, BENCH_OSM_FILE) != 0) {
+        printf("❌ Could not write %s\n", BENCH_OSM_FILE);
+        return;
+    }
+
+    int threads[2] = { 1, OSM_BENCH_THREADS };
+    int edges[2] = { -1, -1 };
+    for (int i = 0; i < 2; i++) {
+        Graph graph;
+        if (init_graph(&graph) != 0) {
+            break;
+        }
+        double t = wall_seconds();
+        if (import_osm_xml(&graph, BENCH_OSM_FILE, threads[i]) == 0) {
+            printf("%d thread(s): %.3f s, %d nodes, %d edges\n\n", threads[i],
+                   wall_seconds() - t, graph.node_count, graph.edge_count);
+            edges[i] = graph.edge_count;
+        }
+        cleanup_graph(&graph);
+    }
+    remove(BENCH_OSM_FILE);
+    printf("%s\n", edges[0] >= 0 && edges[0] == edges[1] ?
+           "✅ Same graph with both thread counts" : "❌ Imports differ");
+}
+
+// Point-to-point Dijkstra as in pathfinding.c; returns improving relaxations,
+// each of which a lazy-insertion heap would have pushed as a new entry
+static long heap_dijkstra(const Graph* graph, int start, int end, double distances[],
+                          MinHeap* heap, int* peak_size) {
+    const CSRGraph* csr = &graph->csr;
+    long improved = 0;
+    for (int i = 0; i < graph->node_count; i++) distances[i] = INF;
+    distances[start] = 0.0;
+    clear_heap(heap);
+    insert_heap(heap, start, 0.0);
+
+    while (!is_empty(heap)) {
+        int u = extract_min(heap).vertex;
+        if (u == end) break;
+
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            double alt = distances[u] + csr->weights[e];
+            if (alt < distances[csr->targets[e]]) {
+                distances[csr->targets[e]] = alt;
+                insert_heap(heap, csr->targets[e], alt);
+                improved++;
+            }
+        }
+        if (heap->size > *peak_size) *peak_size = heap->size;
+    }
+    return improved;
+}
+
+// Grid with jittered coordinates, so edge weights differ and keys actually
+// get lowered during searches
+static int build_jittered_grid(Graph* graph, int side) {
+    if (init_graph(graph) != 0 || reserve_nodes(graph, side * side) != 0) {
+        return -1;
+    }
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            add_location(graph, r * side + c, "grid",
+                         18.90 + r * 0.002 + ((r * 31 + c * 17) % 7) * 0.0002,
+                         72.80 + c * 0.002 + ((r * 13 + c * 7) % 5) * 0.0002);
+            if (c > 0) add_edge(graph, r * side + c - 1, r * side + c);
+            if (r > 0) add_edge(graph, (r - 1) * side + c, r * side + c);
+        }
+    }
+    return 0;
+}
+
+// Jittered grid whose every tenth row and column is a highway, weighted
+// for traffic at the given hour (highways faster, local streets slower),
+// so routes have a road hierarchy to exploit like real networks do
+static int build_arterial_grid(Graph* graph, int side, int hour) {
+    if (init_graph(graph) != 0 || reserve_nodes(graph, side * side) != 0) {
+        return -1;
+    }
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            add_location(graph, r * side + c, "grid",
+                         18.90 + r * 0.002 + ((r * 31 + c * 17) % 7) * 0.0002,
+                         72.80 + c * 0.002 + ((r * 13 + c * 7) % 5) * 0.0002);
+            if (c > 0) add_enhanced_edge(graph, r * side + c - 1, r * side + c,
+                                         r % 10 == 0 ? "highway" : "local", 1, 50.0);
+            if (r > 0) add_enhanced_edge(graph, (r - 1) * side + c, r * side + c,
+                                         c % 10 == 0 ? "highway" : "local", 1, 50.0);
+        }
+    }
+    apply_traffic_weights(graph, hour);
+    return 0;
+}
+
+// Queue operations alone: fill with random keys, lower a quarter of
+// them, then drain. Returns operations performed.
+static long heap_operations(MinHeap* heap, int n) {
+    long operations = 0;
+    srand(42);
+    clear_heap(heap);
+    for (int v = 0; v < n; v++) {
+        insert_heap(heap, v, 1000.0 + (rand() % 1000000) * 0.001);
+        operations++;
+    }
+    for (int i = 0; i < n / 4; i++) {
+        int v = rand() % n;
+        decrease_key(heap, v, (rand() % 1000000) * 0.001);
+        operations++;
+    }
+    while (!is_empty(heap)) {
+        extract_min(heap);
+        operations++;
+    }
+    return operations;
+}
+
+static void bench_heap(int side) {
+    printf("⛰️  Priority queue benchmark (%dx%d grid)\n", side, side);
+    printf("═══════════════════════════════════════\n");
+
+    Graph graph;
+    if (build_jittered_grid(&graph, side) != 0) {
+        cleanup_graph(&graph);
+        return;
+    }
+    double* distances = malloc((size_t)graph.node_count * sizeof(double));
+    if (freeze_graph(&graph) != 0 || !distances) {
+        printf("❌ Out of memory\n");
+        free(distances);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    int arities[3] = { 2, 4, 8 };
+    printf("%-8s %16s %18s\n", "Arity", "Time/query (s)", "Queue ops/sec");
+    for (int a = 0; a < 3; a++) {
+        MinHeap heap;
+        if (init_heap_arity(&heap, graph.node_count, arities[a]) != 0) {
+            printf("❌ Out of memory\n");
+            break;
+        }
+        long improved = 0;
+        int peak_size = 0;
+        clock_t t = clock();
+        for (int q = 0; q < BENCH_QUERIES; q++) {
+            int start = (q * 7919) % graph.node_count;
+            int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+            improved += heap_dijkstra(&graph, start, end, distances, &heap, &peak_size);
+        }
+        double query_time = elapsed_seconds(t);
+        long pushes = heap.pushes, pops = heap.pops, decreases = heap.decreases;
+
+        // Queue alone, on a heap holding every vertex
+        t = clock();
+        long operations = heap_operations(&heap, graph.node_count);
+        double operation_time = elapsed_seconds(t);
+        printf("%-8d %16.4f %18.0f\n", arities[a], query_time / BENCH_QUERIES,
+               operations / operation_time);
+
+        if (a == 2) {
+            printf("\nPer query (%d queries):\n", BENCH_QUERIES);
+            printf("  Pushes:               %ld\n", pushes / BENCH_QUERIES);
+            printf("  Pops:                 %ld\n", pops / BENCH_QUERIES);
+            printf("  Decrease-keys:        %ld\n", decreases / BENCH_QUERIES);
+            printf("  Lazy-heap pushes:     %ld (one per improving relaxation)\n", improved / BENCH_QUERIES);
+            printf("Peak heap size:         %d entries (bound: %d)\n", peak_size, heap.capacity);
+        }
+        free_heap(&heap);
+    }
+
+    free(distances);
+    cleanup_graph(&graph);
+}
+
+static void bench_workspace(int side) {
+    printf("♻️  Search workspace benchmark (%dx%d grid, short queries)\n", side, side);
+    printf("═════════════════════════════════════════════════════\n");
+
+    Graph graph;
+    SearchWorkspace reused;
+    if (build_jittered_grid(&graph, side) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&reused, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+
+    // Intra-city trips: a few blocks between start and end
+    double times[2] = { 0.0, 0.0 };
+    long settled = 0;
+    int mismatches = 0;
+    for (int q = 0; q < WORKSPACE_QUERIES; q++) {
+        int r = (q * 7919) % (side - 10), c = (q * 104729) % (side - 10);
+        int start = r * side + c;
+        int end = (r + 1 + q % 9) * side + c + 1 + q % 7;
+
+        // Per-query state, as dijkstra() and astar_pathfind() set up
+        clock_t t = clock();
+        SearchWorkspace fresh;
+        double expected = INF;
+        if (init_search_workspace(&fresh, graph.node_count) == 0) {
+            expected = dijkstra_search(&graph, &fresh, start, end);
+            free_search_workspace(&fresh);
+        }
+        times[0] += elapsed_seconds(t);
+
+        t = clock();
+        double distance = dijkstra_search(&graph, &reused, start, end);
+        times[1] += elapsed_seconds(t);
+        settled += reused.settled;
+        mismatches += distance != expected;
+    }
+
+    printf("Queries: %d, average settled: %ld\n\n", WORKSPACE_QUERIES, settled / WORKSPACE_QUERIES);
+    printf("%-22s %16s\n", "State", "Time/query (us)");
+    printf("%-22s %16.1f\n", "allocated per query", times[0] * 1e6 / WORKSPACE_QUERIES);
+    printf("%-22s %16.1f\n", "reused workspace", times[1] * 1e6 / WORKSPACE_QUERIES);
+    printf("\n⚡ Speedup: %.1fx, %s\n", times[0] / times[1],
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    free_search_workspace(&reused);
+    cleanup_graph(&graph);
+}
+
+static void bench_bidirectional(int side) {
+    printf("↔️  Forward vs bidirectional Dijkstra (%dx%d grid)\n", side, side);
+    printf("═════════════════════════════════════════════════\n");
+
+    Graph graph;
+    SearchWorkspace single, forward, backward;
+    if (build_jittered_grid(&graph, side) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&single, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    if (init_search_workspace(&forward, graph.node_count) != 0 ||
+        init_search_workspace(&backward, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        free_search_workspace(&single);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    double times[2] = { 0.0, 0.0 };
+    long settled[2] = { 0, 0 };
+    int mismatches = 0;
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+
+        clock_t t = clock();
+        double expected = dijkstra_search(&graph, &single, start, end);
+        times[0] += elapsed_seconds(t);
+        settled[0] += single.settled;
+
+        t = clock();
+        int meeting;
+        double distance = bidirectional_search(&graph, &forward, &backward, start, end, &meeting);
+        times[1] += elapsed_seconds(t);
+        settled[1] += forward.settled + backward.settled;
+        mismatches += fabs(distance - expected) > 1e-9;
+    }
+
+    printf("%-16s %16s %16s\n", "Search", "Settled/query", "Time/query (ms)");
+    printf("%-16s %16ld %16.2f\n", "forward", settled[0] / BENCH_QUERIES, times[0] * 1000.0 / BENCH_QUERIES);
+    printf("%-16s %16ld %16.2f\n", "bidirectional", settled[1] / BENCH_QUERIES, times[1] * 1000.0 / BENCH_QUERIES);
+    printf("\n⚡ Settles %.0f%% of the nodes, %.2fx faster, %s\n",
+           100.0 * settled[1] / settled[0], times[0] / times[1],
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    free_search_workspace(&single);
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    cleanup_graph(&graph);
+}
+
+static void bench_ch(int side) {
+    printf("🏔️  Contraction hierarchy (%dx%d grid)\n", side, side);
+    printf("═══════════════════════════════════════\n");
+
+    Graph graph;
+    ContractionHierarchy ch, loaded;
+    SearchWorkspace forward, backward;
+    if (build_arterial_grid(&graph, side, 12) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&forward, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    if (init_search_workspace(&backward, graph.node_count) != 0 ||
+        build_contraction_hierarchy(&graph, &ch, 0) != 0) {
+        free_search_workspace(&forward);
+        free_search_workspace(&backward);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    double t = wall_seconds();
+    int saved = save_contraction_hierarchy(&ch, BENCH_HIERARCHY_FILE) == 0;
+    double save_time = wall_seconds() - t;
+    t = wall_seconds();
+    int reloaded = saved && load_contraction_hierarchy(&loaded, &graph, BENCH_HIERARCHY_FILE) == 0;
+    double load_time = wall_seconds() - t;
+    remove(BENCH_HIERARCHY_FILE);
+    printf("Save: %.3f s, load + validate: %.3f s\n\n", save_time, load_time);
+
+    // Hierarchy queries are cheap enough to time many; Dijkstra is timed
+    // on the first BENCH_QUERIES of them
+    double times[3] = { 0.0, 0.0, 0.0 };
+    long settled[3] = { 0, 0, 0 };
+    int mismatches = 0;
+    for (int q = 0; q < CH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+        int meeting;
+
+        clock_t c = clock();
+        double distance = ch_search(reloaded ? &loaded : &ch, &forward, &backward, start, end, &meeting);
+        times[2] += elapsed_seconds(c);
+        settled[2] += forward.settled + backward.settled;
+        if (q >= BENCH_QUERIES) {
+            continue;
+        }
+
+        c = clock();
+        double expected = dijkstra_search(&graph, &forward, start, end);
+        times[0] += elapsed_seconds(c);
+        settled[0] += forward.settled;
+
+        c = clock();
+        bidirectional_search(&graph, &forward, &backward, start, end, &meeting);
+        times[1] += elapsed_seconds(c);
+        settled[1] += forward.settled + backward.settled;
+        mismatches += fabs(distance - expected) > 1e-9;
+    }
+
+    printf("%-16s %16s %16s\n", "Search", "Settled/query", "Time/query (us)");
+    printf("%-16s %16ld %16.1f\n", "dijkstra", settled[0] / BENCH_QUERIES, times[0] * 1e6 / BENCH_QUERIES);
+    printf("%-16s %16ld %16.1f\n", "bidirectional", settled[1] / BENCH_QUERIES, times[1] * 1e6 / BENCH_QUERIES);
+    printf("%-16s %16ld %16.1f\n", "hierarchy", settled[2] / CH_QUERIES, times[2] * 1e6 / CH_QUERIES);
+    printf("\n⚡ Hierarchy query speedup over Dijkstra: %.0fx, %s\n",
+           (times[0] / BENCH_QUERIES) / (times[2] / CH_QUERIES),
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    if (reloaded) {
+        free_contraction_hierarchy(&loaded);
+    }
+    free_contraction_hierarchy(&ch);
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    cleanup_graph(&graph);
+}
+
+static void bench_radix(int side) {
+    printf("🪣 Binary heap vs radix heap Dijkstra (%dx%d grid)\n", side, side);
+    printf("══════════════════════════════════════════════════\n");
+
+    Graph graph;
+    double* distances[2] = { NULL, NULL };
+    int* previous = NULL;
+    if (build_jittered_grid(&graph, side) != 0 || freeze_graph(&graph) != 0 ||
+        !(distances[0] = malloc((size_t)graph.node_count * sizeof(double))) ||
+        !(distances[1] = malloc((size_t)graph.node_count * sizeof(double))) ||
+        !(previous = malloc((size_t)graph.node_count * sizeof(int)))) {
+        printf("❌ Could not build benchmark graph\n");
+        free(distances[0]);
+        free(distances[1]);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    double times[2] = { 0.0, 0.0 };
+    double worst_gap = 0.0;
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+        clock_t t = clock();
+        dijkstra(&graph, start, end, distances[0], previous);
+        times[0] += elapsed_seconds(t);
+        t = clock();
+        dijkstra_radix(&graph, start, end, distances[1], previous);
+        times[1] += elapsed_seconds(t);
+        if (distances[1][end] - distances[0][end] > worst_gap) {
+            worst_gap = distances[1][end] - distances[0][end];
+        }
+    }
+
+    printf("\n%-14s %16s\n", "Queue", "Time/query (s)");
+    printf("%-14s %16.4f\n", "binary heap", times[0] / BENCH_QUERIES);
+    printf("%-14s %16.4f\n", "radix heap", times[1] / BENCH_QUERIES);
+    printf("\n⚡ Radix heap speedup: %.2fx, worst route length gap: %.1f m\n",
+           times[0] / times[1], worst_gap * 1000.0);
+
+    free(distances[0]);
+    free(distances[1]);
+    free(previous);
+    cleanup_graph(&graph);
+}
+
+// The grid as node and edge CSV files, with every tenth road repeated
+// (reversed) and a self-loop every hundred rows, as raw exports have
+static int write_grid_csv(int side, const char* nodes_filename, const char* edges_filename) {
+    FILE* nodes = fopen(nodes_filename, "w");
+    FILE* edges = fopen(edges_filename, "w");
+    if (!nodes || !edges) {
+        if (nodes) fclose(nodes);
+        if (edges) fclose(edges);
+        return -1;
+    }
+    fprintf(nodes, "id,name,type,district,lat,lon,elevation,traffic\n");
+    fprintf(edges, "from,to,road_type,traffic_factor,speed_limit,oneway\n");
+    long long rows = 0;
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int id = 1000000 + r * side + c;
+            fprintf(nodes, "%d,\"Junction %d, Grid\",junction,District %d,%.7f,%.7f,%.1f,%d\n",
+                    id, id, r / 100, 18.90 + r * 0.002, 72.80 + c * 0.002, 10.0 + c % 7, 1 + c % 3);
+            int neighbors[2] = { c + 1 < side ? id + 1 : -1, r + 1 < side ? id + side : -1 };
+            for (int k = 0; k < 2; k++) {
+                if (neighbors[k] < 0) {
+                    continue;
+                }
+                fprintf(edges, "%d,%d,local,%d,30,%d\n", id, neighbors[k], 1 + k, r % 5 == 0 && k == 0);
+                if (++rows % 10 == 0) {
+                    fprintf(edges, "%d,%d,local,%d,30,0\n", neighbors[k], id, 1 + k);
+                }
+                if (rows % 100 == 0) {
+                    fprintf(edges, "%d,%d,local,1,30,0\n", id, id);
+                }
+            }
+        }
+    }
+    int result = fclose(nodes) == 0 ? 0 : -1;
+    return fclose(edges) == 0 ? result : -1;
+}
+
+static void bench_network(int side) {
+    printf("📂 Network file loader benchmark (%dx%d grid)\n", side, side);
+    printf("══════════════════════════════════════════════\n");
+    if (write_grid_csv(side, BENCH_NODES_FILE, BENCH_EDGES_FILE) != 0) {
+        printf("❌ Could not write %s / %s\n", BENCH_NODES_FILE, BENCH_EDGES_FILE);
+        return;
+    }
+
+    int threads[2] = { 1, OSM_BENCH_THREADS };
+    int edges[2] = { -1, -1 };
+    for (int i = 0; i < 2; i++) {
+        Graph graph;
+        if (init_graph(&graph) != 0) {
+            break;
+        }
+        double t = wall_seconds();
+        if (load_network_files(&graph, BENCH_NODES_FILE, BENCH_EDGES_FILE, threads[i]) == 0) {
+            printf("%d thread(s): %.3f s total, %d nodes, %d edges\n\n", threads[i],
+                   wall_seconds() - t, graph.node_count, graph.edge_count);
+            edges[i] = graph.edge_count;
+        }
+        cleanup_graph(&graph);
+    }
+    remove(BENCH_NODES_FILE);
+    remove(BENCH_EDGES_FILE);
+    printf("%s\n", edges[0] >= 0 && edges[0] == edges[1] ?
+           "✅ Same graph with both thread counts" : "❌ Loads differ");
+}
+
+static void bench_alt(int side) {
+    printf("📍 A* heuristics at rush hour (%dx%d grid, %d landmarks)\n", side, side, ALT_LANDMARKS);
+    printf("═══════════════════════════════════════════════════════\n");
+
+    Graph graph;
+    SearchWorkspace single, forward;
+    LandmarkSet sets[2];
+    if (build_arterial_grid(&graph, side, ALT_RUSH_HOUR) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&single, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    if (init_search_workspace(&forward, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        free_search_workspace(&single);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    double select_times[2];
+    for (int m = 0; m < 2; m++) {
+        double t = wall_seconds();
+        if (select_landmarks(&graph, &sets[m], ALT_LANDMARKS, m == 0 ? LANDMARKS_FARTHEST : LANDMARKS_AVOID) != 0) {
+            if (m == 1) free_landmarks(&sets[0]);
+            free_search_workspace(&single);
+            free_search_workspace(&forward);
+            cleanup_graph(&graph);
+            return;
+        }
+        select_times[m] = wall_seconds() - t;
+    }
+    printf("Distance tables: %zu bytes per node\n\n", (size_t)ALT_LANDMARKS * 2 * sizeof(float));
+
+    // 0: Dijkstra, 1: straight-line A*, 2: ALT farthest, 3: ALT avoid
+    double times[4] = { 0.0, 0.0, 0.0, 0.0 };
+    long settled[4] = { 0, 0, 0, 0 };
+    int mismatches = 0;
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+
+        clock_t c = clock();
+        double expected = dijkstra_search(&graph, &single, start, end);
+        times[0] += elapsed_seconds(c);
+        settled[0] += single.settled;
+
+        c = clock();
+        double distance = astar_search(&graph, &forward, start, end);
+        times[1] += elapsed_seconds(c);
+        settled[1] += forward.settled;
+        mismatches += fabs(distance - expected) > 1e-9;
+
+        for (int m = 0; m < 2; m++) {
+            LandmarkQuery query;
+            c = clock();
+            init_landmark_query(&query, &sets[m], start, end, DEFAULT_ACTIVE_LANDMARKS);
+            distance = astar_search_with(&graph, &forward, start, end, landmark_heuristic, &query);
+            times[2 + m] += elapsed_seconds(c);
+            settled[2 + m] += forward.settled;
+            mismatches += fabs(distance - expected) > 1e-9;
+        }
+    }
+
+    static const char* names[4] = { "dijkstra", "A* straight", "ALT farthest", "ALT avoid" };
+    printf("%-16s %16s %16s %12s\n", "Search", "Settled/query", "Time/query (ms)", "Select (s)");
+    for (int i = 0; i < 4; i++) {
+        printf("%-16s %16ld %16.2f", names[i], settled[i] / BENCH_QUERIES, times[i] * 1000.0 / BENCH_QUERIES);
+        if (i >= 2) {
+            printf(" %12.2f", select_times[i - 2]);
+        }
+        printf("\n");
+    }
+    int best = settled[2] <= settled[3] ? 2 : 3;
+    printf("\n⚡ %s settles %.0f%% of straight-line A*'s nodes, %.2fx faster, %s\n",
+           names[best], 100.0 * settled[best] / settled[1], times[1] / times[best],
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    free_landmarks(&sets[0]);
+    free_landmarks(&sets[1]);
+    free_search_workspace(&single);
+    free_search_workspace(&forward);
+    cleanup_graph(&graph);
+}
+
+// Overlay queries against Dijkstra on the graph's current weights
+static void time_overlay_queries(const Graph* graph, const MultiLevelOverlay* overlay,
+                                 SearchWorkspace* single, SearchWorkspace* workspace) {
+    double times[2] = { 0.0, 0.0 };
+    long settled[2] = { 0, 0 };
+    int mismatches = 0;
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph->node_count;
+        int end = (q * 104729 + graph->node_count / 2) % graph->node_count;
+
+        clock_t c = clock();
+        double expected = dijkstra_search(graph, single, start, end);
+        times[0] += elapsed_seconds(c);
+        settled[0] += single->settled;
+
+        c = clock();
+        double distance = overlay_search(graph, overlay, workspace, start, end);
+        times[1] += elapsed_seconds(c);
+        settled[1] += workspace->settled;
+        mismatches += fabs(distance - expected) > 1e-9;
+    }
+    printf("%-16s %16s %16s\n", "Search", "Settled/query", "Time/query (ms)");
+    printf("%-16s %16ld %16.2f\n", "dijkstra", settled[0] / BENCH_QUERIES, times[0] * 1000.0 / BENCH_QUERIES);
+    printf("%-16s %16ld %16.2f\n", "overlay", settled[1] / BENCH_QUERIES, times[1] * 1000.0 / BENCH_QUERIES);
+    printf("⚡ %.1fx faster, %s\n\n", times[0] / times[1],
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+}
+
+static void bench_overlay(int side) {
+    printf("🧩 Multi-level overlay (%dx%d grid)\n", side, side);
+    printf("═══════════════════════════════════\n");
+
+    Graph graph;
+    MultiLevelOverlay overlay;
+    SearchWorkspace single, workspace;
+    if (build_arterial_grid(&graph, side, 12) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&single, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    if (init_search_workspace(&workspace, graph.node_count) != 0 ||
+        build_overlay(&graph, &overlay, 0) != 0) {
+        free_search_workspace(&single);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    // Customization with one thread, then one per CPU
+    double t = wall_seconds();
+    customize_overlay(&graph, &overlay, 1);
+    double serial = wall_seconds() - t;
+    t = wall_seconds();
+    customize_overlay(&graph, &overlay, 0);
+    double parallel = wall_seconds() - t;
+    printf("Customize: %.2f s on 1 thread, %.2f s with a thread per CPU\n\n", serial, parallel);
+    time_overlay_queries(&graph, &overlay, &single, &workspace);
+
+    // Traffic changes: reweight, refreeze and re-customize the same partition
+    t = wall_seconds();
+    apply_traffic_weights(&graph, ALT_RUSH_HOUR);
+    int refrozen = freeze_graph(&graph) == 0;
+    double reweight = wall_seconds() - t;
+    t = wall_seconds();
+    if (refrozen && customize_overlay(&graph, &overlay, 0) == 0) {
+        printf("Rush hour: reweight + freeze %.2f s, re-customize %.2f s\n",
+               reweight, wall_seconds() - t);
+        time_overlay_queries(&graph, &overlay, &single, &workspace);
+    }
+
+    free_overlay(&overlay);
+    free_search_workspace(&single);
+    free_search_workspace(&workspace);
+    cleanup_graph(&graph);
+}
+
+static void bench_hub_labels(int side) {
+    printf("🏷️  Hub labels (%dx%d grid)\n", side, side);
+    printf("═════════════════════════════\n");
+
+    Graph graph;
+    ContractionHierarchy ch;
+    HubLabels built, labels;
+    SearchWorkspace forward, backward;
+    if (build_arterial_grid(&graph, side, 12) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&forward, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    if (init_search_workspace(&backward, graph.node_count) != 0 ||
+        build_contraction_hierarchy(&graph, &ch, 0) != 0) {
+        free_search_workspace(&forward);
+        cleanup_graph(&graph);
+        return;
+    }
+    if (build_hub_labels(&ch, &built) != 0) {
+        free_contraction_hierarchy(&ch);
+        free_search_workspace(&forward);
+        free_search_workspace(&backward);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    double t = wall_seconds();
+    int saved = save_hub_labels(&built, BENCH_LABEL_FILE) == 0;
+    double save_time = wall_seconds() - t;
+    t = wall_seconds();
+    int mapped = saved && load_hub_labels(&labels, &graph, BENCH_LABEL_FILE) == 0;
+    double load_time = wall_seconds() - t;
+    remove(BENCH_LABEL_FILE);
+    printf("Save: %.3f s, map + validate: %.4f s\n\n", save_time, load_time);
+    const HubLabels* used = mapped ? &labels : &built;
+
+    // Lookups over a fixed pseudo-random pair sequence, between any nodes
+    // (label reads miss the cache) and among HL_HOT_NODES nodes (merge
+    // cost alone); checksums keep the merges from being optimized away
+    // and must agree
+    int n = graph.node_count;
+    double sums[4] = { 0.0, 0.0, 0.0, 0.0 };
+    double times[4];
+    for (int variant = 0; variant < 4; variant++) {
+        unsigned int range = variant < 2 || n < HL_HOT_NODES ? (unsigned int)n : HL_HOT_NODES;
+        unsigned int state = 12345;
+        clock_t c = clock();
+        for (int q = 0; q < HL_LOOKUPS; q++) {
+            state = state * 1103515245u + 12345u;
+            int start = (int)((state >> 8) % range * 7919u % (unsigned int)n);
+            state = state * 1103515245u + 12345u;
+            int end = (int)((state >> 8) % range * 7919u % (unsigned int)n);
+            sums[variant] += variant % 2 == 0 ? hub_label_distance(used, start, end)
+                                              : hub_label_distance_scalar(used, start, end);
+        }
+        times[variant] = elapsed_seconds(c);
+    }
+
+    double ch_time = 0.0, dijkstra_time = 0.0;
+    int mismatches = sums[0] != sums[1] || sums[2] != sums[3];
+    for (int q = 0; q < CH_QUERIES; q++) {
+        int start = (q * 7919) % n;
+        int end = (q * 104729 + n / 2) % n;
+        int meeting;
+        clock_t c = clock();
+        double distance = ch_search(&ch, &forward, &backward, start, end, &meeting);
+        ch_time += elapsed_seconds(c);
+        mismatches += fabs(hub_label_distance(used, start, end) - distance) > 1e-9;
+        if (q < BENCH_QUERIES) {
+            c = clock();
+            dijkstra_search(&graph, &forward, start, end);
+            dijkstra_time += elapsed_seconds(c);
+        }
+    }
+
+    printf("%-16s %16s\n", "Lookup", "Time/query (us)");
+    printf("%-16s %16.3f\n", "labels sse2", times[0] * 1e6 / HL_LOOKUPS);
+    printf("%-16s %16.3f\n", "labels scalar", times[1] * 1e6 / HL_LOOKUPS);
+    printf("%-16s %16.3f\n", "cached sse2", times[2] * 1e6 / HL_LOOKUPS);
+    printf("%-16s %16.3f\n", "cached scalar", times[3] * 1e6 / HL_LOOKUPS);
+    printf("%-16s %16.3f\n", "hierarchy", ch_time * 1e6 / CH_QUERIES);
+    printf("%-16s %16.3f\n", "dijkstra", dijkstra_time * 1e6 / BENCH_QUERIES);
+    printf("\n⚡ %.1fM lookups/s, SSE2 merge %.2fx faster than scalar (%.2fx when cached), %s\n",
+           HL_LOOKUPS / times[0] / 1e6, times[1] / times[0], times[3] / times[2],
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    if (mapped) {
+        free_hub_labels(&labels);
+    }
+    free_hub_labels(&built);
+    free_contraction_hierarchy(&ch);
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    cleanup_graph(&graph);
+}
+
+static void bench_arc_flags(int side) {
+    printf("🚩 Arc flags at rush hour (%dx%d grid, %d regions)\n", side, side, DEFAULT_ARC_FLAG_REGIONS);
+    printf("═══════════════════════════════════════════════════\n");
+
+    Graph graph;
+    SearchWorkspace workspace;
+    if (build_arterial_grid(&graph, side, ALT_RUSH_HOUR) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&workspace, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+
+    ArcFlags flags;
+    double t = wall_seconds();
+    if (compute_arc_flags(&graph, &flags, DEFAULT_ARC_FLAG_REGIONS, 0) != 0) {
+        free_search_workspace(&workspace);
+        cleanup_graph(&graph);
+        return;
+    }
+    printf("Precomputation: %.2fs\n\n", wall_seconds() - t);
+
+    // 0: Dijkstra, 1: A*, 2: Dijkstra with arc flags, 3: A* with arc flags
+    double times[4] = { 0.0, 0.0, 0.0, 0.0 };
+    long settled[4] = { 0, 0, 0, 0 };
+    int mismatches = 0;
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+
+        clock_t c = clock();
+        double expected = dijkstra_search(&graph, &workspace, start, end);
+        times[0] += elapsed_seconds(c);
+        settled[0] += workspace.settled;
+
+        c = clock();
+        double distance = astar_search(&graph, &workspace, start, end);
+        times[1] += elapsed_seconds(c);
+        settled[1] += workspace.settled;
+        mismatches += fabs(distance - expected) > 1e-9;
+
+        for (int m = 0; m < 2; m++) {
+            c = clock();
+            distance = arc_flag_search(&graph, &flags, &workspace, start, end,
+                                       m == 0 ? NULL : straight_line_heuristic, &graph);
+            times[2 + m] += elapsed_seconds(c);
+            settled[2 + m] += workspace.settled;
+            mismatches += fabs(distance - expected) > 1e-9;
+        }
+    }
+
+    static const char* names[4] = { "dijkstra", "A*", "dijkstra + flags", "A* + flags" };
+    printf("%-18s %16s %16s\n", "Search", "Settled/query", "Time/query (ms)");
+    for (int i = 0; i < 4; i++) {
+        printf("%-18s %16ld %16.2f\n", names[i], settled[i] / BENCH_QUERIES,
+               times[i] * 1000.0 / BENCH_QUERIES);
+    }
+    printf("\n⚡ Arc flags settle %.0f%% of Dijkstra's nodes and %.0f%% of A*'s, %s\n",
+           100.0 * settled[2] / settled[0], 100.0 * settled[3] / settled[1],
+           mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    free_arc_flags(&flags);
+    free_search_workspace(&workspace);
+    cleanup_graph(&graph);
+}
+
+static void bench_matrix(int side) {
+    printf("🧮 Distance matrix (%dx%d grid, %d x %d)\n", side, side, MATRIX_SOURCES, MATRIX_TARGETS);
+    printf("═══════════════════════════════════════════════\n");
+
+    Graph graph;
+    ContractionHierarchy ch;
+    SearchWorkspace workspace;
+    if (build_arterial_grid(&graph, side, 12) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&workspace, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    int* sources = malloc(MATRIX_SOURCES * sizeof(int));
+    int* targets = malloc(MATRIX_TARGETS * sizeof(int));
+    float* matrix = malloc((size_t)MATRIX_SOURCES * MATRIX_TARGETS * sizeof(float));
+    if (!sources || !targets || !matrix || build_contraction_hierarchy(&graph, &ch, 0) != 0) {
+        free(sources);
+        free(targets);
+        free(matrix);
+        free_search_workspace(&workspace);
+        cleanup_graph(&graph);
+        return;
+    }
+    for (int i = 0; i < MATRIX_SOURCES; i++) {
+        sources[i] = (int)(((long long)i * 7919) % graph.node_count);
+    }
+    for (int j = 0; j < MATRIX_TARGETS; j++) {
+        targets[j] = (int)(((long long)j * 104729 + graph.node_count / 2) % graph.node_count);
+    }
+    printf("\n");
+
+    double t = wall_seconds();
+    int ok = distance_matrix(&ch, sources, MATRIX_SOURCES, targets, MATRIX_TARGETS, 1, matrix) == 0;
+    double single_time = wall_seconds() - t;
+    t = wall_seconds();
+    ok = ok && distance_matrix(&ch, sources, MATRIX_SOURCES, targets, MATRIX_TARGETS, 0, matrix) == 0;
+    double threaded_time = wall_seconds() - t;
+    t = wall_seconds();
+    ok = ok && write_distance_matrix(&ch, sources, MATRIX_SOURCES, targets, MATRIX_TARGETS, 0,
+                                     BENCH_MATRIX_FILE) == 0;
+    double file_time = wall_seconds() - t;
+    remove(BENCH_MATRIX_FILE);
+
+    // Baselines, extrapolated: one Dijkstra per pair, and one search to
+    // every node per source
+    int mismatches = 0;
+    t = wall_seconds();
+    for (int q = 0; q < MATRIX_PAIR_SAMPLES; q++) {
+        int i = (q * 37) % MATRIX_SOURCES, j = (q * 101) % MATRIX_TARGETS;
+        double expected = dijkstra_search(&graph, &workspace, sources[i], targets[j]);
+        float entry = matrix[(size_t)i * MATRIX_TARGETS + j];
+        mismatches += fabs(entry - expected) > 1e-5 * (1.0 + expected);
+    }
+    double pair_time = (wall_seconds() - t) / MATRIX_PAIR_SAMPLES * MATRIX_SOURCES * MATRIX_TARGETS;
+    t = wall_seconds();
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        dijkstra_search(&graph, &workspace, sources[q], -1);
+    }
+    double row_time = (wall_seconds() - t) / BENCH_QUERIES * MATRIX_SOURCES;
+
+    printf("\n%-28s %12s\n", "Method", "Time (s)");
+    printf("%-28s %12.1f\n", "dijkstra per pair (est.)", pair_time);
+    printf("%-28s %12.2f\n", "dijkstra per source (est.)", row_time);
+    printf("%-28s %12.3f\n", "buckets, 1 thread", single_time);
+    printf("%-28s %12.3f\n", "buckets, all threads", threaded_time);
+    printf("%-28s %12.3f\n", "buckets, streamed to file", file_time);
+    printf("\n⚡ Matrix %.0fx faster than per-pair Dijkstra, %.0fx faster than per-source, %s\n",
+           pair_time / threaded_time, row_time / threaded_time,
+           ok && mismatches == 0 ? "same distances ✅" : "distances differ ❌");
+
+    free(sources);
+    free(targets);
+    free(matrix);
+    free_contraction_hierarchy(&ch);
+    free_search_workspace(&workspace);
+    cleanup_graph(&graph);
+}
+
+static void bench_batch(int side) {
+    printf("📦 Batch queries (%dx%d grid, %d queries: dijkstra, astar, bidirectional)\n",
+           side, side, BATCH_QUERIES);
+    printf("═══════════════════════════════════════════════════════════════════\n");
+#ifndef _WIN32
+    printf("Online CPUs: %d\n\n", default_thread_count());
+#endif
+
+    Graph graph;
+    if (build_arterial_grid(&graph, side, 12) != 0 || freeze_graph(&graph) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    BatchQuery* queries = malloc(BATCH_QUERIES * sizeof(BatchQuery));
+    BatchResult* results = malloc(BATCH_QUERIES * sizeof(BatchResult));
+    if (!queries || !results) {
+        printf("❌ Out of memory!\n");
+        free(queries);
+        free(results);
+        cleanup_graph(&graph);
+        return;
+    }
+    for (int q = 0; q < BATCH_QUERIES; q++) {
+        queries[q].start = (int)(((long long)q * 7919) % graph.node_count);
+        queries[q].end = (int)(((long long)q * 104729 + graph.node_count / 2) % graph.node_count);
+        queries[q].algorithm = (QueryAlgorithm)(q % 3);
+    }
+
+    static const int thread_counts[] = { 1, 2, 4, 8 };
+    double base_qps = 0.0;
+    printf("%-8s %12s %12s %12s %10s %8s\n", "Threads", "Queries/s", "p50 (us)", "p99 (us)", "Speedup", "Steals");
+    for (int i = 0; i < 4; i++) {
+        BatchStats stats;
+        if (run_batch_queries(&graph, NULL, queries, BATCH_QUERIES, thread_counts[i], results, &stats) != 0) {
+            break;
+        }
+        if (i == 0) {
+            base_qps = stats.queries_per_second;
+        }
+        printf("%-8d %12.0f %12.1f %12.1f %9.2fx %8ld\n", stats.thread_count, stats.queries_per_second,
+               stats.p50 * 1e6, stats.p99 * 1e6, stats.queries_per_second / base_qps, stats.steals);
+    }
+
+    free(queries);
+    free(results);
+    cleanup_graph(&graph);
+}
+
+// Dijkstra weighing each relaxed edge for the wall-clock hour, as the
+// legacy A* did: a time() and localtime() call per edge
+static double clock_weight_dijkstra(const Graph* graph, int start, int end, double distances[],
+                                    MinHeap* heap, long* settled) {
+    for (int i = 0; i < graph->node_count; i++) distances[i] = INF;
+    distances[start] = 0.0;
+    clear_heap(heap);
+    insert_heap(heap, start, 0.0);
+
+    while (!is_empty(heap)) {
+        int u = extract_min(heap).vertex;
+        (*settled)++;
+        if (u == end) {
+            return distances[end];
+        }
+        for (Edge* edge = graph->edge_lists[u]; edge != NULL; edge = edge->next) {
+            time_t now = time(NULL);
+            struct tm* local_time = localtime(&now);
+            double alt = distances[u] + calculate_dynamic_weight(edge, local_time->tm_hour);
+            if (alt < distances[edge->destination]) {
+                distances[edge->destination] = alt;
+                insert_heap(heap, edge->destination, alt);
+            }
+        }
+    }
+    return INF;
+}
+
+static void bench_time_dependent(int side) {
+    printf("🕒 Time-dependent queries (%dx%d grid, leaving %02d:%02d)\n", side, side,
+           (int)TD_DEPARTURE / 60, (int)TD_DEPARTURE % 60);
+    printf("══════════════════════════════════════════════════\n");
+
+    Graph graph;
+    SearchWorkspace workspace;
+    MinHeap heap;
+    if (build_arterial_grid(&graph, side, 12) != 0 || freeze_graph(&graph) != 0 ||
+        init_search_workspace(&workspace, graph.node_count) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    double* distances = malloc((size_t)graph.node_count * sizeof(double));
+    TimeProfiles profiles;
+    if (!distances || init_heap(&heap, graph.node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        free(distances);
+        free_search_workspace(&workspace);
+        cleanup_graph(&graph);
+        return;
+    }
+    double t = wall_seconds();
+    if (build_time_profiles(&graph, &profiles) != 0) {
+        free(distances);
+        free_heap(&heap);
+        free_search_workspace(&workspace);
+        cleanup_graph(&graph);
+        return;
+    }
+    printf("Profiles: %d shared, %zu bytes per road, built in %.3fs\n\n", profiles.profile_count,
+           sizeof(float) + sizeof(unsigned short), wall_seconds() - t);
+
+    // 0: localtime() per edge, 1: profile Dijkstra, 2: profile A*
+    double times[3] = { 0.0, 0.0, 0.0 };
+    long settled[3] = { 0, 0, 0 };
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+
+        clock_t c = clock();
+        clock_weight_dijkstra(&graph, start, end, distances, &heap, &settled[0]);
+        times[0] += elapsed_seconds(c);
+
+        for (int m = 0; m < 2; m++) {
+            c = clock();
+            td_search(&graph, &profiles, &workspace, start, end, TD_DEPARTURE, m);
+            times[1 + m] += elapsed_seconds(c);
+            settled[1 + m] += workspace.settled;
+        }
+    }
+
+    static const char* names[3] = { "localtime/edge", "profile dijkstra", "profile A*" };
+    printf("%-18s %16s %16s %14s\n", "Search", "Settled/query", "Time/query (ms)", "us/settled");
+    for (int i = 0; i < 3; i++) {
+        printf("%-18s %16ld %16.2f %14.3f\n", names[i], settled[i] / BENCH_QUERIES,
+               times[i] * 1000.0 / BENCH_QUERIES, times[i] * 1e6 / settled[i]);
+    }
+    printf("\n⚡ Profiles cost %.1fx less per settled node than a clock call per edge\n",
+           (times[0] / settled[0]) / (times[1] / settled[1]));
+
+    free_time_profiles(&profiles);
+    free(distances);
+    free_heap(&heap);
+    free_search_workspace(&workspace);
+    cleanup_graph(&graph);
+}
+
+// The penalty method: route again with the roads of every route found so
+// far made PENALTY_FACTOR times longer, MAX_ALTERNATIVE_ROUTES searches a query
+static int penalty_alternatives(Graph* graph, SearchWorkspace* workspace, int start, int end,
+                                int path[], int penalized[], long* settled) {
+    double* weights = graph->csr.weights;
+    int penalized_count = 0;
+    int routes = 0;
+
+    for (int r = 0; r < MAX_ALTERNATIVE_ROUTES; r++) {
+        if (dijkstra_search(graph, workspace, start, end) >= INF) {
+            break;
+        }
+        *settled += workspace->settled;
+        routes++;
+        int length = workspace_path(workspace, end, path);
+        for (int i = 1; i < length; i++) {
+            for (int e = graph->csr.offsets[path[i - 1]]; e < graph->csr.offsets[path[i - 1] + 1]; e++) {
+                if (graph->csr.targets[e] == path[i]) {
+                    weights[e] *= PENALTY_FACTOR;
+                    penalized[penalized_count++] = e;
+                    break;
+                }
+            }
+        }
+    }
+    // Undo in reverse, so roads penalized twice come back exactly
+    while (penalized_count > 0) {
+        weights[penalized[--penalized_count]] /= PENALTY_FACTOR;
+    }
+    return routes;
+}
+
+static void bench_alternatives(int side) {
+    printf("🔀 Alternative routes (%dx%d grid, up to %d routes)\n", side, side, MAX_ALTERNATIVE_ROUTES);
+    printf("══════════════════════════════════════════════════\n");
+
+    Graph graph;
+    SearchWorkspace workspace;
+    AlternativeWorkspace alternatives;
+    if (build_arterial_grid(&graph, side, ALT_RUSH_HOUR) != 0 || freeze_graph(&graph) != 0) {
+        printf("❌ Could not build benchmark graph\n");
+        cleanup_graph(&graph);
+        return;
+    }
+    int* path = malloc((size_t)graph.node_count * sizeof(int));
+    int* penalized = malloc((size_t)graph.node_count * MAX_ALTERNATIVE_ROUTES * sizeof(int));
+    if (!path || !penalized || init_search_workspace(&workspace, graph.node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        free(path);
+        free(penalized);
+        cleanup_graph(&graph);
+        return;
+    }
+    if (init_alternative_workspace(&alternatives, graph.node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        free_search_workspace(&workspace);
+        free(path);
+        free(penalized);
+        cleanup_graph(&graph);
+        return;
+    }
+
+    double times[2] = { 0.0, 0.0 };
+    long settled[2] = { 0, 0 };
+    int routes[2] = { 0, 0 };
+    double stretch = 0.0, shared = 0.0;
+    long single_settled = 0;
+    for (int q = 0; q < BENCH_QUERIES; q++) {
+        int start = (q * 7919) % graph.node_count;
+        int end = (q * 104729 + graph.node_count / 2) % graph.node_count;
+
+        dijkstra_search(&graph, &workspace, start, end);
+        single_settled += workspace.settled;
+
+        clock_t c = clock();
+        routes[0] += penalty_alternatives(&graph, &workspace, start, end, path, penalized, &settled[0]);
+        times[0] += elapsed_seconds(c);
+
+        c = clock();
+        int count = find_alternatives(&graph, &alternatives, start, end, MAX_ALTERNATIVE_ROUTES);
+        times[1] += elapsed_seconds(c);
+        settled[1] += alternatives.forward.settled + alternatives.backward.settled;
+        routes[1] += count;
+        for (int r = 1; r < count; r++) {
+            stretch += alternatives.routes[r].distance / alternatives.routes[0].distance - 1.0;
+            shared += alternatives.routes[r].shared / alternatives.routes[0].distance;
+        }
+    }
+
+    static const char* names[2] = { "penalties", "plateaus" };
+    printf("%-12s %16s %16s %14s\n", "Method", "Time/query (ms)", "Settled/query", "Routes/query");
+    for (int i = 0; i < 2; i++) {
+        printf("%-12s %16.2f %16ld %14.2f\n", names[i], times[i] * 1000.0 / BENCH_QUERIES,
+               settled[i] / BENCH_QUERIES, (double)routes[i] / BENCH_QUERIES);
+    }
+    int alternative_count = routes[1] - BENCH_QUERIES;
+    if (alternative_count > 0) {
+        printf("\nPlateau alternatives: %.1f%% longer, %.0f%% shared with earlier routes on average\n",
+               stretch * 100.0 / alternative_count, shared * 100.0 / alternative_count);
+    }
+    printf("⚡ Plateaus settle %.1fx the nodes of one Dijkstra query, %.1fx faster than penalties\n",
+           (double)settled[1] / single_settled, times[0] / times[1]);
+
+    free_alternative_workspace(&alternatives);
+    free_search_workspace(&workspace);
+    free(path);
+    free(penalized);
+    cleanup_graph(&graph);
+}
+
+int main(int argc, char* argv[]) {
+    const char* which = argc > 1 ? argv[1] : "all";
+    int side = argc > 2 ? atoi(argv[2]) : DEFAULT_GRID_SIDE;
+    if (side < 2) side = DEFAULT_GRID_SIDE;
+
+    int ran = 0;
+    if (strcmp(which, "all") == 0 || strcmp(which, "csr") == 0) {
+        bench_csr(side);
+        ran = 1;
+    }
+    if (strcmp(which, "reorder") == 0) {
+        bench_reorder(argc > 2 ? side : REORDER_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "osm") == 0) {
+        bench_osm(argc > 2 ? side : OSM_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "heap") == 0) {
+        bench_heap(argc > 2 ? side : HEAP_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "workspace") == 0) {
+        bench_workspace(argc > 2 ? side : HEAP_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "bidir") == 0) {
+        bench_bidirectional(argc > 2 ? side : HEAP_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "ch") == 0) {
+        bench_ch(argc > 2 ? side : CH_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "alt") == 0) {
+        bench_alt(argc > 2 ? side : ALT_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "overlay") == 0) {
+        bench_overlay(argc > 2 ? side : OVERLAY_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "hl") == 0) {
+        bench_hub_labels(argc > 2 ? side : HL_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "arcflags") == 0) {
+        bench_arc_flags(argc > 2 ? side : ARC_FLAG_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "matrix") == 0) {
+        bench_matrix(argc > 2 ? side : MATRIX_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "batch") == 0) {
+        bench_batch(argc > 2 ? side : BATCH_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "alternatives") == 0) {
+        bench_alternatives(argc > 2 ? side : ALTERNATIVES_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "td") == 0) {
+        bench_time_dependent(argc > 2 ? side : TD_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "radix") == 0) {
+        bench_radix(argc > 2 ? side : HEAP_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "network") == 0) {
+        bench_network(argc > 2 ? side : NETWORK_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "mmap") == 0) {
+        bench_mmap(argc > 2 ? side : MMAP_GRID_SIDE);
+        ran = 1;
+    }
+    if (strcmp(which, "build") == 0 || strcmp(which, "build-malloc") == 0) {
+        bench_build(argc > 2 ? side : BUILD_GRID_SIDE, strcmp(which, "build-malloc") == 0);
+        ran = 1;
+    }
+
+    if (!ran) {
+        printf("Unknown benchmark '%s'\n", which);
+        return 1;
+    }
+    return 0;
+}
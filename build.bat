@@ -19,7 +19,7 @@ echo 📦 Compiling TrackMate modules...
 echo.
 
 REM Compile all modules
-gcc distance.c heap.c graph.c pathfinding.c json_output.c data_loader.c main.c -o trackmate.exe -std=c99 -Wall -O2 -lm
+gcc arena.c string_table.c parallel.c distance.c heap.c radix_heap.c search_workspace.c graph.c graph_file.c pathfinding.c contraction.c landmarks.c overlay.c hub_labels.c arc_flags.c distance_matrix.c batch_query.c time_dependent.c alternatives.c traffic.c reorder.c osm_import.c network_loader.c json_output.c data_loader.c main.c -o trackmate.exe -std=c99 -Wall -O2 -lm -pthread
 
 if %errorlevel% equ 0 (
     echo.
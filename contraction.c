@@ -0,0 +1,823 @@
+/**
+ * contraction.c
+ * Contraction hierarchy preprocessing, queries and hierarchy files
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "contraction.h"
+#include "heap.h"
+#include "search_workspace.h"
+#include "parallel.h"
+#include "graph_file.h"
+
+#define CONTRACTION_MAX_THREADS 64
+#define WITNESS_SETTLE_LIMIT 500    // Witness searches give up after this many nodes
+#define PRIORITY_SETTLE_LIMIT 20    // Shorter searches when only estimating priorities
+#define HIERARCHY_FILE_MAGIC "TMHIER"
+#define HIERARCHY_FILE_BYTE_ORDER 0x01020304u
+
+// Edge of the graph being contracted, stored at both of its ends
+typedef struct {
+    int node;           // Other end
+    int middle;         // Bypassed node for shortcuts, -1 for roads
+    double weight;
+} HierarchyArc;
+
+typedef struct {
+    HierarchyArc* arcs;
+    int count;
+    int capacity;
+} ArcList;
+
+typedef struct {
+    int from;
+    int to;
+    int middle;
+    double weight;
+} Shortcut;
+
+// Preprocessing state. out/in hold the edges among uncontracted nodes;
+// once a node is contracted its own lists are final and become its up
+// and down edges.
+typedef struct {
+    int node_count;
+    ArcList* out;
+    ArcList* in;
+    unsigned char* contracted;
+    unsigned char* in_batch;        // Being contracted this round
+    unsigned char* dirty;           // Priority needs recomputing
+    int* deleted_neighbours;
+    int* level;                     // Hierarchy depth below the node
+    int* priority;
+} Contraction;
+
+// One thread's share of a round: either priorities for dirty nodes, or
+// the shortcuts needed to contract the round's batch
+typedef struct {
+    Contraction* state;
+    const int* nodes;
+    int count;
+    int collect;                    // Nonzero: record shortcuts instead of priorities
+    SearchWorkspace workspace;
+    unsigned int* target_stamp;     // Out-neighbours of the node being contracted
+    unsigned int target_epoch;
+    Shortcut* shortcuts;
+    int shortcut_count;
+    int shortcut_capacity;
+    int error;
+} ContractionWorker;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;            // HIERARCHY_FILE_BYTE_ORDER as written
+    int32_t node_count;
+    int32_t up_count;
+    int32_t down_count;
+    int32_t shortcut_count;
+    uint64_t fingerprint;           // graph_fingerprint of the source graph
+} HierarchyFileHeader;
+
+// Add an edge, or lower the weight of the existing one to the same node
+static int add_arc(ArcList* list, int node, double weight, int middle) {
+    for (int i = 0; i < list->count; i++) {
+        if (list->arcs[i].node == node) {
+            if (weight < list->arcs[i].weight) {
+                list->arcs[i].weight = weight;
+                list->arcs[i].middle = middle;
+            }
+            return 0;
+        }
+    }
+    if (list->count == list->capacity) {
+        int new_capacity = list->capacity > 0 ? list->capacity * 2 : 4;
+        HierarchyArc* arcs = realloc(list->arcs, (size_t)new_capacity * sizeof(HierarchyArc));
+        if (!arcs) {
+            return -1;
+        }
+        list->arcs = arcs;
+        list->capacity = new_capacity;
+    }
+    list->arcs[list->count].node = node;
+    list->arcs[list->count].middle = middle;
+    list->arcs[list->count].weight = weight;
+    list->count++;
+    return 0;
+}
+
+static void remove_arc(ArcList* list, int node) {
+    for (int i = 0; i < list->count; i++) {
+        if (list->arcs[i].node == node) {
+            list->arcs[i] = list->arcs[--list->count];
+            return;
+        }
+    }
+}
+
+static int append_shortcut(ContractionWorker* worker, int from, int to, int middle, double weight) {
+    if (worker->shortcut_count == worker->shortcut_capacity) {
+        int new_capacity = worker->shortcut_capacity > 0 ? worker->shortcut_capacity * 2 : 256;
+        Shortcut* shortcuts = realloc(worker->shortcuts, (size_t)new_capacity * sizeof(Shortcut));
+        if (!shortcuts) {
+            return -1;
+        }
+        worker->shortcuts = shortcuts;
+        worker->shortcut_capacity = new_capacity;
+    }
+    Shortcut* shortcut = &worker->shortcuts[worker->shortcut_count++];
+    shortcut->from = from;
+    shortcut->to = to;
+    shortcut->middle = middle;
+    shortcut->weight = weight;
+    return 0;
+}
+
+static int outranks(const Contraction* state, int v, int w);
+
+// Dijkstra from source among uncontracted nodes until all targets are
+// settled, limit km is passed or the settle limit is hit (a low one when
+// only estimating a priority: a missed witness just makes the node look
+// more expensive). It avoids skip and the batch nodes ordered before
+// skip: that is the graph a one-at-a-time contraction in that order would
+// see, less the shortcuts those nodes add, which only costs extra shortcuts.
+static void witness_search(const Contraction* state, ContractionWorker* worker,
+                           int source, int skip, double limit, int targets) {
+    SearchWorkspace* workspace = &worker->workspace;
+    int settle_limit = worker->collect ? WITNESS_SETTLE_LIMIT : PRIORITY_SETTLE_LIMIT;
+    begin_search(workspace);
+    unsigned int epoch = workspace->epoch;
+    workspace->stamp[source] = epoch;
+    workspace->distance[source] = 0.0;
+    insert_heap(&workspace->heap, source, 0.0);
+
+    while (!is_empty(&workspace->heap) && workspace->settled < settle_limit) {
+        PQNode top = extract_min(&workspace->heap);
+        if (top.distance > limit) {
+            break;
+        }
+        workspace->settled++;
+        if (worker->target_stamp[top.vertex] == worker->target_epoch && --targets == 0) {
+            break;
+        }
+
+        const ArcList* list = &state->out[top.vertex];
+        for (int i = 0; i < list->count; i++) {
+            int v = list->arcs[i].node;
+            if (v == skip || (state->in_batch[v] && outranks(state, v, skip))) {
+                continue;
+            }
+            double alt = top.distance + list->arcs[i].weight;
+            if (workspace->stamp[v] != epoch || alt < workspace->distance[v]) {
+                workspace->stamp[v] = epoch;
+                workspace->distance[v] = alt;
+                insert_heap(&workspace->heap, v, alt);
+            }
+        }
+    }
+}
+
+// Shortcuts contracting v needs: u -> v -> x wherever no witness path
+// from u reaches x at most as long. Recorded when the worker collects.
+// @return Shortcut count, -1 if recording ran out of memory
+static int contract_node(ContractionWorker* worker, int v) {
+    const Contraction* state = worker->state;
+    const ArcList* in = &state->in[v];
+    const ArcList* out = &state->out[v];
+    const SearchWorkspace* workspace = &worker->workspace;
+
+    double max_out = 0.0;
+    worker->target_epoch++;
+    for (int j = 0; j < out->count; j++) {
+        worker->target_stamp[out->arcs[j].node] = worker->target_epoch;
+        if (out->arcs[j].weight > max_out) {
+            max_out = out->arcs[j].weight;
+        }
+    }
+
+    int shortcuts = 0;
+    for (int i = 0; i < in->count; i++) {
+        int u = in->arcs[i].node;
+        double to_v = in->arcs[i].weight;
+        if (out->count == 0 || (out->count == 1 && out->arcs[0].node == u)) {
+            continue;
+        }
+        witness_search(state, worker, u, v, to_v + max_out, out->count);
+
+        for (int j = 0; j < out->count; j++) {
+            int x = out->arcs[j].node;
+            double through_v = to_v + out->arcs[j].weight;
+            if (x == u || (workspace->stamp[x] == workspace->epoch &&
+                           workspace->distance[x] <= through_v)) {
+                continue;
+            }
+            shortcuts++;
+            if (worker->collect && append_shortcut(worker, u, x, v, through_v) != 0) {
+                return -1;
+            }
+        }
+    }
+    return shortcuts;
+}
+
+static void* run_contraction_worker(void* arg) {
+    ContractionWorker* worker = arg;
+    Contraction* state = worker->state;
+    for (int i = 0; i < worker->count; i++) {
+        int v = worker->nodes[i];
+        int shortcuts = contract_node(worker, v);
+        if (shortcuts < 0) {
+            worker->error = 1;
+            break;
+        }
+        if (!worker->collect) {
+            // Edge difference, plus terms that spread contraction evenly
+            state->priority[v] = shortcuts - state->in[v].count - state->out[v].count +
+                                 state->deleted_neighbours[v] + state->level[v];
+        }
+    }
+    return NULL;
+}
+
+// Split nodes into one contiguous share per worker and run them in parallel
+static int run_workers(ContractionWorker* workers, int worker_count,
+                       const int* nodes, int count, int collect) {
+    for (int i = 0; i < worker_count; i++) {
+        int begin = (int)((long long)count * i / worker_count);
+        int end = (int)((long long)count * (i + 1) / worker_count);
+        workers[i].nodes = nodes + begin;
+        workers[i].count = end - begin;
+        workers[i].collect = collect;
+        workers[i].shortcut_count = 0;
+    }
+    run_parallel(run_contraction_worker, workers, sizeof(ContractionWorker), worker_count);
+
+    int result = 0;
+    for (int i = 0; i < worker_count; i++) {
+        if (workers[i].error) {
+            result = -1;
+        }
+    }
+    return result;
+}
+
+static uint32_t mix_node(int v) {
+    uint32_t x = (uint32_t)v * 2654435761u;
+    return x ^ (x >> 16);
+}
+
+// Lower priority contracts first; ties go to a hash of the id so that
+// uniform regions (grids) do not contract in long runs
+static int outranks(const Contraction* state, int v, int w) {
+    if (state->priority[v] != state->priority[w]) {
+        return state->priority[v] < state->priority[w];
+    }
+    uint32_t hv = mix_node(v), hw = mix_node(w);
+    return hv != hw ? hv < hw : v < w;
+}
+
+static int is_local_minimum(const Contraction* state, int v) {
+    const ArcList* lists[2] = { &state->out[v], &state->in[v] };
+    for (int l = 0; l < 2; l++) {
+        for (int i = 0; i < lists[l]->count; i++) {
+            if (!outranks(state, v, lists[l]->arcs[i].node)) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void touch_neighbour(Contraction* state, int w, int v, int* dirty_nodes, int* dirty_count) {
+    state->deleted_neighbours[w]++;
+    if (state->level[w] < state->level[v] + 1) {
+        state->level[w] = state->level[v] + 1;
+    }
+    if (!state->dirty[w]) {
+        state->dirty[w] = 1;
+        dirty_nodes[(*dirty_count)++] = w;
+    }
+}
+
+static void free_contraction(Contraction* state) {
+    for (int i = 0; state->out && i < state->node_count; i++) {
+        free(state->out[i].arcs);
+    }
+    for (int i = 0; state->in && i < state->node_count; i++) {
+        free(state->in[i].arcs);
+    }
+    free(state->out);
+    free(state->in);
+    free(state->contracted);
+    free(state->in_batch);
+    free(state->dirty);
+    free(state->deleted_neighbours);
+    free(state->level);
+    free(state->priority);
+}
+
+static int init_contraction(Contraction* state, const Graph* graph) {
+    int n = graph->node_count;
+    const CSRGraph* csr = &graph->csr;
+    memset(state, 0, sizeof(Contraction));
+    state->node_count = n;
+    state->out = calloc((size_t)n, sizeof(ArcList));
+    state->in = calloc((size_t)n, sizeof(ArcList));
+    state->contracted = calloc((size_t)n, 1);
+    state->in_batch = calloc((size_t)n, 1);
+    state->dirty = calloc((size_t)n, 1);
+    state->deleted_neighbours = calloc((size_t)n, sizeof(int));
+    state->level = calloc((size_t)n, sizeof(int));
+    state->priority = calloc((size_t)n, sizeof(int));
+    if (!state->out || !state->in || !state->contracted || !state->in_batch || !state->dirty ||
+        !state->deleted_neighbours || !state->level || !state->priority) {
+        return -1;
+    }
+
+    // Parallel roads collapse to the shortest; self-loops never help
+    for (int u = 0; u < n; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            if (v != u && (add_arc(&state->out[u], v, csr->weights[e], -1) != 0 ||
+                           add_arc(&state->in[v], u, csr->weights[e], -1) != 0)) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+static void free_edges(HierarchyEdges* edges) {
+    free(edges->offsets);
+    free(edges->neighbours);
+    free(edges->weights);
+    free(edges->middle);
+    memset(edges, 0, sizeof(HierarchyEdges));
+}
+
+static int alloc_edges(HierarchyEdges* edges, int node_count, int edge_count) {
+    size_t slots = (size_t)(edge_count > 0 ? edge_count : 1);
+    edges->offsets = malloc((size_t)(node_count + 1) * sizeof(int));
+    edges->neighbours = malloc(slots * sizeof(int));
+    edges->weights = malloc(slots * sizeof(double));
+    edges->middle = malloc(slots * sizeof(int));
+    edges->edge_count = edge_count;
+    if (!edges->offsets || !edges->neighbours || !edges->weights || !edges->middle) {
+        free_edges(edges);
+        return -1;
+    }
+    return 0;
+}
+
+// Freeze each node's final lists into CSR form
+static int pack_edges(HierarchyEdges* edges, const ArcList* lists, int node_count, int* shortcuts) {
+    int total = 0;
+    for (int v = 0; v < node_count; v++) {
+        total += lists[v].count;
+    }
+    if (alloc_edges(edges, node_count, total) != 0) {
+        return -1;
+    }
+    int position = 0;
+    for (int v = 0; v < node_count; v++) {
+        edges->offsets[v] = position;
+        for (int i = 0; i < lists[v].count; i++) {
+            edges->neighbours[position] = lists[v].arcs[i].node;
+            edges->weights[position] = lists[v].arcs[i].weight;
+            edges->middle[position] = lists[v].arcs[i].middle;
+            *shortcuts += lists[v].arcs[i].middle >= 0;
+            position++;
+        }
+    }
+    edges->offsets[node_count] = position;
+    return 0;
+}
+
+void free_contraction_hierarchy(ContractionHierarchy* ch) {
+    free(ch->rank);
+    free_edges(&ch->up);
+    free_edges(&ch->down);
+    memset(ch, 0, sizeof(ContractionHierarchy));
+}
+
+int build_contraction_hierarchy(const Graph* graph, ContractionHierarchy* ch, int thread_count) {
+    memset(ch, 0, sizeof(ContractionHierarchy));
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before contraction\n");
+        return -1;
+    }
+
+    double start_time = wall_seconds();
+    int n = graph->node_count;
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > CONTRACTION_MAX_THREADS) {
+        worker_count = CONTRACTION_MAX_THREADS;
+    }
+
+    Contraction state;
+    ContractionWorker workers[CONTRACTION_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+    int* remaining = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    int* dirty_nodes = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    int* batch = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    ch->rank = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    int result = init_contraction(&state, graph) == 0 && remaining && dirty_nodes && batch &&
+                 ch->rank ? 0 : -1;
+    for (int i = 0; i < worker_count && result == 0; i++) {
+        workers[i].state = &state;
+        workers[i].target_stamp = calloc((size_t)(n > 0 ? n : 1), sizeof(unsigned int));
+        result = workers[i].target_stamp ? init_search_workspace(&workers[i].workspace, n) : -1;
+    }
+
+    int remaining_count = n, dirty_count = n, rounds = 0, next_rank = 0;
+    for (int v = 0; v < n; v++) {
+        remaining[v] = v;
+        dirty_nodes[v] = v;
+    }
+
+    while (result == 0 && remaining_count > 0) {
+        // Refresh the priorities of nodes whose neighbourhood changed
+        result = run_workers(workers, worker_count, dirty_nodes, dirty_count, 0);
+        for (int i = 0; i < dirty_count; i++) {
+            state.dirty[dirty_nodes[i]] = 0;
+        }
+        dirty_count = 0;
+
+        // Contract every node that outranks all its neighbours; they are
+        // independent, so their shortcuts can be found in parallel
+        int batch_count = 0;
+        for (int i = 0; i < remaining_count; i++) {
+            if (is_local_minimum(&state, remaining[i])) {
+                batch[batch_count++] = remaining[i];
+                state.in_batch[remaining[i]] = 1;
+            }
+        }
+        if (result == 0) {
+            result = run_workers(workers, worker_count, batch, batch_count, 1);
+        }
+
+        for (int b = 0; b < batch_count && result == 0; b++) {
+            int v = batch[b];
+            ch->rank[v] = next_rank++;
+            state.contracted[v] = 1;
+            for (int i = 0; i < state.in[v].count; i++) {
+                int u = state.in[v].arcs[i].node;
+                remove_arc(&state.out[u], v);
+                touch_neighbour(&state, u, v, dirty_nodes, &dirty_count);
+            }
+            for (int i = 0; i < state.out[v].count; i++) {
+                int x = state.out[v].arcs[i].node;
+                remove_arc(&state.in[x], v);
+                touch_neighbour(&state, x, v, dirty_nodes, &dirty_count);
+            }
+        }
+        for (int w = 0; w < worker_count && result == 0; w++) {
+            for (int i = 0; i < workers[w].shortcut_count && result == 0; i++) {
+                const Shortcut* s = &workers[w].shortcuts[i];
+                if (add_arc(&state.out[s->from], s->to, s->weight, s->middle) != 0 ||
+                    add_arc(&state.in[s->to], s->from, s->weight, s->middle) != 0) {
+                    result = -1;
+                }
+            }
+        }
+        for (int b = 0; b < batch_count; b++) {
+            state.in_batch[batch[b]] = 0;
+        }
+
+        int kept = 0;
+        for (int i = 0; i < remaining_count; i++) {
+            if (!state.contracted[remaining[i]]) {
+                remaining[kept++] = remaining[i];
+            }
+        }
+        remaining_count = kept;
+        rounds++;
+    }
+
+    if (result == 0) {
+        ch->node_count = n;
+        ch->fingerprint = graph_fingerprint(graph);
+        if (pack_edges(&ch->up, state.out, n, &ch->shortcut_count) != 0 ||
+            pack_edges(&ch->down, state.in, n, &ch->shortcut_count) != 0) {
+            result = -1;
+        }
+    }
+
+    for (int i = 0; i < worker_count; i++) {
+        free_search_workspace(&workers[i].workspace);
+        free(workers[i].target_stamp);
+        free(workers[i].shortcuts);
+    }
+    free_contraction(&state);
+    free(remaining);
+    free(dirty_nodes);
+    free(batch);
+
+    if (result != 0) {
+        printf("❌ Out of memory: could not build the contraction hierarchy\n");
+        free_contraction_hierarchy(ch);
+        return -1;
+    }
+    printf("✅ Contracted %d nodes in %d rounds (%d threads, %.2fs): %d shortcuts, %d up + %d down edges\n",
+           n, rounds, worker_count, wall_seconds() - start_time, ch->shortcut_count,
+           ch->up.edge_count, ch->down.edge_count);
+    return 0;
+}
+
+double ch_search(const ContractionHierarchy* ch, SearchWorkspace* forward,
+                 SearchWorkspace* backward, int start, int end, int* meeting) {
+    *meeting = -1;
+    if (forward->node_count < ch->node_count || backward->node_count < ch->node_count) {
+        printf("❌ Search workspace is smaller than the hierarchy\n");
+        return INF;
+    }
+
+    begin_search(forward);
+    begin_search(backward);
+    SearchWorkspace* sides[2] = { forward, backward };
+    const HierarchyEdges* climb[2] = { &ch->up, &ch->down };
+    const HierarchyEdges* stall[2] = { &ch->down, &ch->up };
+    int ends[2] = { start, end };
+    for (int d = 0; d < 2; d++) {
+        sides[d]->stamp[ends[d]] = sides[d]->epoch;
+        sides[d]->distance[ends[d]] = 0.0;
+        sides[d]->previous[ends[d]] = -1;
+        insert_heap(&sides[d]->heap, ends[d], 0.0);
+    }
+    if (start == end) {
+        *meeting = start;
+        return 0.0;
+    }
+
+    // Each side runs until its queue minimum reaches the best meeting
+    // distance; the shortest path's top node is then settled by both
+    double best = INF;
+    for (;;) {
+        double keys[2] = { peek_min_key(&forward->heap), peek_min_key(&backward->heap) };
+        int d = keys[0] <= keys[1] ? 0 : 1;
+        if (keys[d] >= best) {
+            break;
+        }
+        SearchWorkspace* side = sides[d];
+        SearchWorkspace* other = sides[1 - d];
+        unsigned int epoch = side->epoch;
+
+        int u = extract_min(&side->heap).vertex;
+        side->settled++;
+
+        // Stall-on-demand: a higher neighbour reaches u more cheaply, so u
+        // cannot be on a shortest up-down path and is not expanded
+        const HierarchyEdges* edges = stall[d];
+        int stalled = 0;
+        for (int e = edges->offsets[u]; e < edges->offsets[u + 1] && !stalled; e++) {
+            int w = edges->neighbours[e];
+            stalled = side->stamp[w] == epoch &&
+                      side->distance[w] + edges->weights[e] < side->distance[u];
+        }
+        if (stalled) {
+            continue;
+        }
+
+        edges = climb[d];
+        for (int e = edges->offsets[u]; e < edges->offsets[u + 1]; e++) {
+            int v = edges->neighbours[e];
+            double alt = side->distance[u] + edges->weights[e];
+
+            if (side->stamp[v] != epoch || alt < side->distance[v]) {
+                side->stamp[v] = epoch;
+                side->distance[v] = alt;
+                side->previous[v] = u;
+                insert_heap(&side->heap, v, alt);
+
+                if (other->stamp[v] == other->epoch && alt + other->distance[v] < best) {
+                    best = alt + other->distance[v];
+                    *meeting = v;
+                }
+            }
+        }
+    }
+    return best;
+}
+
+// Middle node of the hierarchy edge from -> to (-1 for a road)
+static int edge_middle(const ContractionHierarchy* ch, int from, int to) {
+    const HierarchyEdges* edges = ch->rank[from] < ch->rank[to] ? &ch->up : &ch->down;
+    int at = ch->rank[from] < ch->rank[to] ? from : to;
+    int other = at == from ? to : from;
+    for (int e = edges->offsets[at]; e < edges->offsets[at + 1]; e++) {
+        if (edges->neighbours[e] == other) {
+            return edges->middle[e];
+        }
+    }
+    return -1;
+}
+
+// Append the roads behind hierarchy edge from -> to, excluding from
+static void unpack_edge(const ContractionHierarchy* ch, int from, int to, int path[], int* length) {
+    int middle = edge_middle(ch, from, to);
+    if (middle < 0) {
+        path[(*length)++] = to;
+        return;
+    }
+    unpack_edge(ch, from, middle, path, length);
+    unpack_edge(ch, middle, to, path, length);
+}
+
+int ch_path(const ContractionHierarchy* ch, const SearchWorkspace* forward,
+            const SearchWorkspace* backward, int meeting, int path[]) {
+    if (meeting < 0) {
+        return 0;
+    }
+
+    // Hierarchy-level path: start up to meeting, then down to end
+    int hops = 1;
+    for (int v = workspace_previous(forward, meeting); v != -1; v = workspace_previous(forward, v)) {
+        hops++;
+    }
+    for (int v = workspace_previous(backward, meeting); v != -1; v = workspace_previous(backward, v)) {
+        hops++;
+    }
+    int* nodes = malloc((size_t)hops * sizeof(int));
+    if (!nodes) {
+        return 0;
+    }
+    int count = workspace_path(forward, meeting, nodes);
+    for (int v = workspace_previous(backward, meeting); v != -1; v = workspace_previous(backward, v)) {
+        nodes[count++] = v;
+    }
+
+    int length = 0;
+    path[length++] = nodes[0];
+    for (int i = 1; i < count; i++) {
+        unpack_edge(ch, nodes[i - 1], nodes[i], path, &length);
+    }
+    free(nodes);
+    return length;
+}
+
+int ch_pathfind(const Graph* graph, const ContractionHierarchy* ch, int start, int end,
+                int path[], double* total_cost) {
+    if (ch->node_count != graph->node_count) {
+        printf("❌ Contraction hierarchy was built for a different graph\n");
+        return 0;
+    }
+
+    SearchWorkspace forward, backward;
+    if (init_search_workspace(&forward, ch->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate hierarchy search state\n");
+        return 0;
+    }
+    if (init_search_workspace(&backward, ch->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate hierarchy search state\n");
+        free_search_workspace(&forward);
+        return 0;
+    }
+
+    printf("Starting Contraction Hierarchies query: node %d → node %d\n", start, end);
+
+    clock_t start_time = clock();
+    int meeting;
+    int path_length = 0;
+    double cost = ch_search(ch, &forward, &backward, start, end, &meeting);
+    if (cost < INF) {
+        path_length = ch_path(ch, &forward, &backward, meeting, path);
+        *total_cost = cost;
+
+        double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        printf("✅ Found shortest path! Distance: %.2f km\n", *total_cost);
+        printf("   Nodes settled: %d (forward %d + backward %d), Time: %.6fs\n",
+               forward.settled + backward.settled, forward.settled, backward.settled, calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    return path_length;
+}
+
+static int write_edges(FILE* file, const HierarchyEdges* edges, int node_count) {
+    size_t count = (size_t)edges->edge_count;
+    return fwrite(edges->offsets, sizeof(int), (size_t)node_count + 1, file) == (size_t)node_count + 1 &&
+           fwrite(edges->neighbours, sizeof(int), count, file) == count &&
+           fwrite(edges->weights, sizeof(double), count, file) == count &&
+           fwrite(edges->middle, sizeof(int), count, file) == count ? 0 : -1;
+}
+
+static int read_edges(FILE* file, HierarchyEdges* edges, int node_count, int edge_count) {
+    if (alloc_edges(edges, node_count, edge_count) != 0) {
+        return -1;
+    }
+    size_t count = (size_t)edge_count;
+    return fread(edges->offsets, sizeof(int), (size_t)node_count + 1, file) == (size_t)node_count + 1 &&
+           fread(edges->neighbours, sizeof(int), count, file) == count &&
+           fread(edges->weights, sizeof(double), count, file) == count &&
+           fread(edges->middle, sizeof(int), count, file) == count ? 0 : -1;
+}
+
+// Offsets ascending, and every edge climbs to a higher-ranked node past a
+// lower-ranked middle, so queries and unpacking stay in bounds
+static int check_edges(const ContractionHierarchy* ch, const HierarchyEdges* edges) {
+    int n = ch->node_count;
+    if (edges->offsets[0] != 0 || edges->offsets[n] != edges->edge_count) {
+        return -1;
+    }
+    for (int v = 0; v < n; v++) {
+        if (edges->offsets[v + 1] < edges->offsets[v]) {
+            return -1;
+        }
+        for (int e = edges->offsets[v]; e < edges->offsets[v + 1]; e++) {
+            int w = edges->neighbours[e], m = edges->middle[e];
+            if (w < 0 || w >= n || ch->rank[w] <= ch->rank[v] || m < -1 || m >= n ||
+                (m >= 0 && ch->rank[m] >= ch->rank[v]) || !(edges->weights[e] >= 0.0)) {
+                return -1;
+            }
+        }
+    }
+    return 0;
+}
+
+int save_contraction_hierarchy(const ContractionHierarchy* ch, const char* filename) {
+    HierarchyFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HIERARCHY_FILE_MAGIC, sizeof(HIERARCHY_FILE_MAGIC));
+    header.version = HIERARCHY_FILE_VERSION;
+    header.byte_order = HIERARCHY_FILE_BYTE_ORDER;
+    header.node_count = ch->node_count;
+    header.up_count = ch->up.edge_count;
+    header.down_count = ch->down.edge_count;
+    header.shortcut_count = ch->shortcut_count;
+    header.fingerprint = ch->fingerprint;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Could not create %s\n", filename);
+        return -1;
+    }
+    size_t nodes = (size_t)ch->node_count;
+    int result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 fwrite(ch->rank, sizeof(int), nodes, file) == nodes &&
+                 write_edges(file, &ch->up, ch->node_count) == 0 &&
+                 write_edges(file, &ch->down, ch->node_count) == 0 ? 0 : -1;
+    if (fclose(file) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        printf("Error: Could not write %s\n", filename);
+        remove(filename);
+    }
+    return result;
+}
+
+int load_contraction_hierarchy(ContractionHierarchy* ch, const Graph* graph, const char* filename) {
+    memset(ch, 0, sizeof(ContractionHierarchy));
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return -1;
+    }
+
+    HierarchyFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, HIERARCHY_FILE_MAGIC, sizeof(HIERARCHY_FILE_MAGIC)) != 0 ||
+        header.version != HIERARCHY_FILE_VERSION || header.byte_order != HIERARCHY_FILE_BYTE_ORDER ||
+        header.node_count < 0 || header.up_count < 0 || header.down_count < 0) {
+        printf("Error: %s is not a compatible hierarchy file (version %d)\n",
+               filename, HIERARCHY_FILE_VERSION);
+        fclose(file);
+        return -1;
+    }
+    if (header.node_count != graph->node_count || !graph->csr.is_frozen ||
+        header.fingerprint != graph_fingerprint(graph)) {
+        printf("Error: %s was built for a different graph or weights\n", filename);
+        fclose(file);
+        return -1;
+    }
+
+    size_t nodes = (size_t)header.node_count;
+    ch->node_count = header.node_count;
+    ch->shortcut_count = header.shortcut_count;
+    ch->fingerprint = header.fingerprint;
+    ch->rank = malloc((nodes > 0 ? nodes : 1) * sizeof(int));
+    int result = ch->rank && fread(ch->rank, sizeof(int), nodes, file) == nodes &&
+                 read_edges(file, &ch->up, header.node_count, header.up_count) == 0 &&
+                 read_edges(file, &ch->down, header.node_count, header.down_count) == 0 ? 0 : -1;
+    fclose(file);
+
+    for (int v = 0; v < ch->node_count && result == 0; v++) {
+        if (ch->rank[v] < 0 || ch->rank[v] >= ch->node_count) {
+            result = -1;
+        }
+    }
+    if (result == 0 && (check_edges(ch, &ch->up) != 0 || check_edges(ch, &ch->down) != 0)) {
+        result = -1;
+    }
+    if (result != 0) {
+        printf("Error: Hierarchy file %s is truncated or corrupt\n", filename);
+        free_contraction_hierarchy(ch);
+    }
+    return result;
+}
@@ -0,0 +1,71 @@
+/**
+ * contraction.h
+ * Contraction hierarchies: preprocessing, queries and hierarchy files
+ */
+
+#ifndef CONTRACTION_H
+#define CONTRACTION_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define HIERARCHY_FILE_VERSION 1
+
+/**
+ * Contract every node of a frozen graph in order of importance. Each
+ * round picks the nodes whose priority (edge difference + contracted
+ * neighbours + level) is lowest among their neighbours, simulates their
+ * contraction in parallel, then adds the shortcuts for paths through
+ * them that no bounded witness search finds a replacement for.
+ * @param thread_count Contraction threads, or 0 for one per online CPU
+ * @return 0 on success, -1 if the graph is not frozen or memory runs out
+ */
+int build_contraction_hierarchy(const Graph* graph, ContractionHierarchy* ch, int thread_count);
+
+/**
+ * Release the memory held by a hierarchy
+ */
+void free_contraction_hierarchy(ContractionHierarchy* ch);
+
+/**
+ * Write a hierarchy with the fingerprint of the graph it was built for
+ * @return 0 on success, -1 on I/O failure
+ */
+int save_contraction_hierarchy(const ContractionHierarchy* ch, const char* filename);
+
+/**
+ * Read a hierarchy written by save_contraction_hierarchy, refusing files
+ * built for a different graph or weights (see graph_fingerprint)
+ * @return 0 on success, -1 if the file is missing, corrupt or stale
+ */
+int load_contraction_hierarchy(ContractionHierarchy* ch, const Graph* graph, const char* filename);
+
+/**
+ * Bidirectional upward search: forward from start over up edges, backward
+ * from end over down edges, pruned by stall-on-demand. Both workspaces
+ * need node_count entries; quiet, like dijkstra_search.
+ * @param meeting Set to the top node of the shortest path, -1 if none
+ * @return Distance from start to end in km, INF if there is no path
+ */
+double ch_search(const ContractionHierarchy* ch, SearchWorkspace* forward,
+                 SearchWorkspace* backward, int start, int end, int* meeting);
+
+/**
+ * Copy the road-level path found by the last ch_search into path[],
+ * unpacking every shortcut into the roads it replaces
+ * @return Number of vertices, 0 if meeting is -1
+ */
+int ch_path(const ContractionHierarchy* ch, const SearchWorkspace* forward,
+            const SearchWorkspace* backward, int meeting, int path[]);
+
+/**
+ * Find the shortest path with a contraction hierarchy built for graph
+ * and print the query statistics
+ * @param path Array to store the path vertices (node_count entries)
+ * @param total_cost Pointer to store total path cost
+ * @return Length of the path (number of vertices)
+ */
+int ch_pathfind(const Graph* graph, const ContractionHierarchy* ch, int start, int end,
+                int path[], double* total_cost);
+
+#endif // CONTRACTION_H
@@ -6,19 +6,22 @@
 #ifndef DATA_LOADER_H
 #define DATA_LOADER_H
 
+#include "graph.h"
+
 /**
- * Initialize basic Mumbai network (simple version)
+ * Initialize basic Mumbai network (simple version) and freeze it
  */
-void load_basic_mumbai_network(void);
+void load_basic_mumbai_network(Graph* graph);
 
 /**
- * Initialize enhanced Mumbai network with full metadata
+ * Initialize enhanced Mumbai network with full metadata and freeze it
  */
-void load_enhanced_mumbai_network(void);
+void load_enhanced_mumbai_network(Graph* graph);
 
 /**
- * Initialize custom network from user input
+ * Import a custom network from an OpenStreetMap XML extract and freeze it
+ * @return 0 on success, -1 if the file could not be imported
  */
-void load_custom_network(void);
+int load_custom_network(Graph* graph, const char* filename);
 
 #endif // DATA_LOADER_H
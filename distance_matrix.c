@@ -0,0 +1,418 @@
+/**
+ * distance_matrix.c
+ * Bucket-based many-to-many searches over a contraction hierarchy
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "distance_matrix.h"
+#include "heap.h"
+#include "search_workspace.h"
+#include "parallel.h"
+
+#define MATRIX_MAX_THREADS 64
+#define DISTANCE_MATRIX_FILE_MAGIC "TMDMAT"
+#define DISTANCE_MATRIX_FILE_BYTE_ORDER 0x01020304u
+
+// A target's backward distance left at a node its search settled
+typedef struct {
+    int node;
+    int target;             // Index into the targets array
+    double distance;
+} BucketEntry;
+
+// Backward distances of every target, grouped by node: the entries of
+// node v occupy [offsets[v], offsets[v+1])
+typedef struct {
+    int* offsets;           // node_count + 1 entries
+    int* targets;
+    double* distances;
+    long entry_count;
+} Buckets;
+
+// Work handed to a thread: either the backward searches of every
+// stride-th target, or the forward searches of every stride-th row of
+// the current block
+typedef struct {
+    const ContractionHierarchy* ch;
+    const Buckets* buckets;
+    const int* origins;
+    int origin_count;
+    int first;
+    int stride;
+    int target_count;
+    float* rows;            // Block being filled, target_count floats per origin
+    double* row;            // One row while its distances are minimized
+    BucketEntry* entries;   // Backward phase output
+    long entry_count;
+    long entry_capacity;
+    int* settled;           // Unstalled nodes of the last search
+    SearchWorkspace workspace;
+    int error;
+} MatrixWorker;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;            // DISTANCE_MATRIX_FILE_BYTE_ORDER as written
+    int32_t source_count;
+    int32_t target_count;
+    uint64_t fingerprint;           // graph_fingerprint of the source graph
+} MatrixFileHeader;
+
+// Upward search from origin that runs until its queue is empty, pruned by
+// stall-on-demand as in ch_search. Leaves the distances in the workspace
+// and lists the settled nodes that were not stalled, the only ones a
+// shortest up-down path can meet at.
+// @return Number of nodes written to settled
+static int upward_search(const HierarchyEdges* climb, const HierarchyEdges* stall,
+                         SearchWorkspace* ws, int origin, int* settled) {
+    begin_search(ws);
+    unsigned int epoch = ws->epoch;
+    ws->stamp[origin] = epoch;
+    ws->distance[origin] = 0.0;
+    ws->previous[origin] = -1;
+    insert_heap(&ws->heap, origin, 0.0);
+
+    int count = 0;
+    while (!is_empty(&ws->heap)) {
+        int u = extract_min(&ws->heap).vertex;
+        ws->settled++;
+
+        int stalled = 0;
+        for (int e = stall->offsets[u]; e < stall->offsets[u + 1] && !stalled; e++) {
+            int w = stall->neighbours[e];
+            stalled = ws->stamp[w] == epoch && ws->distance[w] + stall->weights[e] < ws->distance[u];
+        }
+        if (stalled) {
+            continue;
+        }
+        settled[count++] = u;
+
+        for (int e = climb->offsets[u]; e < climb->offsets[u + 1]; e++) {
+            int v = climb->neighbours[e];
+            double alt = ws->distance[u] + climb->weights[e];
+
+            if (ws->stamp[v] != epoch || alt < ws->distance[v]) {
+                ws->stamp[v] = epoch;
+                ws->distance[v] = alt;
+                ws->previous[v] = u;
+                insert_heap(&ws->heap, v, alt);
+            }
+        }
+    }
+    return count;
+}
+
+static void* run_backward_worker(void* arg) {
+    MatrixWorker* worker = arg;
+    const ContractionHierarchy* ch = worker->ch;
+    SearchWorkspace* ws = &worker->workspace;
+
+    for (int i = worker->first; i < worker->origin_count && !worker->error; i += worker->stride) {
+        int count = upward_search(&ch->down, &ch->up, ws, worker->origins[i], worker->settled);
+        if (worker->entry_count + count > worker->entry_capacity) {
+            long capacity = (worker->entry_capacity + count) * 2;
+            BucketEntry* grown = realloc(worker->entries, capacity * sizeof(BucketEntry));
+            if (!grown) {
+                worker->error = 1;
+                break;
+            }
+            worker->entries = grown;
+            worker->entry_capacity = capacity;
+        }
+        for (int k = 0; k < count; k++) {
+            BucketEntry* entry = &worker->entries[worker->entry_count++];
+            entry->node = worker->settled[k];
+            entry->target = i;
+            entry->distance = ws->distance[entry->node];
+        }
+    }
+    return NULL;
+}
+
+static void* run_forward_worker(void* arg) {
+    MatrixWorker* worker = arg;
+    const ContractionHierarchy* ch = worker->ch;
+    const Buckets* buckets = worker->buckets;
+    SearchWorkspace* ws = &worker->workspace;
+
+    for (int i = worker->first; i < worker->origin_count; i += worker->stride) {
+        for (int t = 0; t < worker->target_count; t++) {
+            worker->row[t] = INF;
+        }
+        // Every target whose bucket sits at a node the search settles is
+        // reached through that node; the shortest path's top node is one
+        int count = upward_search(&ch->up, &ch->down, ws, worker->origins[i], worker->settled);
+        for (int k = 0; k < count; k++) {
+            int u = worker->settled[k];
+            double up = ws->distance[u];
+            for (int b = buckets->offsets[u]; b < buckets->offsets[u + 1]; b++) {
+                double total = up + buckets->distances[b];
+                if (total < worker->row[buckets->targets[b]]) {
+                    worker->row[buckets->targets[b]] = total;
+                }
+            }
+        }
+        float* out = worker->rows + (size_t)i * worker->target_count;
+        for (int t = 0; t < worker->target_count; t++) {
+            out[t] = worker->row[t] < INF ? (float)worker->row[t] : (float)INF;
+        }
+    }
+    return NULL;
+}
+
+// Group the workers' backward entries by node, worker by worker so the
+// bucket order does not depend on thread timing
+static int fill_buckets(Buckets* buckets, const MatrixWorker* workers, int worker_count, int n) {
+    long total = 0;
+    for (int i = 0; i < worker_count; i++) {
+        total += workers[i].entry_count;
+    }
+    buckets->entry_count = total;
+    buckets->offsets = calloc((size_t)n + 1, sizeof(int));
+    buckets->targets = malloc((total > 0 ? total : 1) * sizeof(int));
+    buckets->distances = malloc((total > 0 ? total : 1) * sizeof(double));
+    if (!buckets->offsets || !buckets->targets || !buckets->distances) {
+        return -1;
+    }
+    for (int i = 0; i < worker_count; i++) {
+        for (long k = 0; k < workers[i].entry_count; k++) {
+            buckets->offsets[workers[i].entries[k].node + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        buckets->offsets[v + 1] += buckets->offsets[v];
+    }
+    int* next = malloc(((size_t)n > 0 ? (size_t)n : 1) * sizeof(int));
+    if (!next) {
+        return -1;
+    }
+    memcpy(next, buckets->offsets, (size_t)n * sizeof(int));
+    for (int i = 0; i < worker_count; i++) {
+        for (long k = 0; k < workers[i].entry_count; k++) {
+            const BucketEntry* entry = &workers[i].entries[k];
+            int slot = next[entry->node]++;
+            buckets->targets[slot] = entry->target;
+            buckets->distances[slot] = entry->distance;
+        }
+    }
+    free(next);
+    return 0;
+}
+
+static int check_nodes(const ContractionHierarchy* ch, const int* nodes, int count) {
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] < 0 || nodes[i] >= ch->node_count) {
+            printf("❌ Invalid location index in distance matrix: %d\n", nodes[i]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int distance_matrix_stream(const ContractionHierarchy* ch, const int* sources, int source_count,
+                           const int* targets, int target_count, int thread_count,
+                           MatrixRowSink sink, void* context) {
+    if (source_count < 0 || target_count < 0 ||
+        check_nodes(ch, sources, source_count) != 0 || check_nodes(ch, targets, target_count) != 0) {
+        return -1;
+    }
+    double start_time = wall_seconds();
+    int n = ch->node_count;
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > MATRIX_MAX_THREADS) {
+        worker_count = MATRIX_MAX_THREADS;
+    }
+
+    // Enough rows per block to fill MATRIX_BLOCK_BYTES, and at least one
+    // per thread
+    long block_rows = MATRIX_BLOCK_BYTES / ((long)(target_count > 0 ? target_count : 1) * sizeof(float));
+    if (block_rows < worker_count) {
+        block_rows = worker_count;
+    }
+    if (block_rows > source_count) {
+        block_rows = source_count > 0 ? source_count : 1;
+    }
+
+    MatrixWorker workers[MATRIX_MAX_THREADS];
+    memset(workers, 0, sizeof(workers));
+    Buckets buckets;
+    memset(&buckets, 0, sizeof(buckets));
+    float* block = malloc((size_t)block_rows * (target_count > 0 ? target_count : 1) * sizeof(float));
+    int result = block ? 0 : -1;
+    int ready = 0;
+    for (int i = 0; i < worker_count && result == 0; i++) {
+        workers[i].settled = malloc(((size_t)n > 0 ? (size_t)n : 1) * sizeof(int));
+        workers[i].row = malloc(((size_t)target_count > 0 ? (size_t)target_count : 1) * sizeof(double));
+        if (!workers[i].settled || !workers[i].row ||
+            init_search_workspace(&workers[i].workspace, n) != 0) {
+            free(workers[i].settled);
+            free(workers[i].row);
+            result = -1;
+            break;
+        }
+        workers[i].ch = ch;
+        workers[i].buckets = &buckets;
+        workers[i].first = i;
+        workers[i].stride = worker_count;
+        workers[i].target_count = target_count;
+        ready++;
+    }
+
+    // Backward searches from the targets fill the buckets once for all rows
+    if (result == 0) {
+        for (int i = 0; i < worker_count; i++) {
+            workers[i].origins = targets;
+            workers[i].origin_count = target_count;
+        }
+        run_parallel(run_backward_worker, workers, sizeof(MatrixWorker), worker_count);
+        for (int i = 0; i < worker_count; i++) {
+            if (workers[i].error) {
+                result = -1;
+            }
+        }
+        if (result == 0) {
+            result = fill_buckets(&buckets, workers, worker_count, n);
+        }
+        for (int i = 0; i < worker_count; i++) {
+            free(workers[i].entries);
+            workers[i].entries = NULL;
+        }
+    }
+    if (result != 0) {
+        printf("❌ Out of memory: could not allocate distance matrix state\n");
+    }
+
+    // Forward searches from the sources, one block of rows at a time
+    for (int first = 0; result == 0 && first < source_count; first += (int)block_rows) {
+        int rows = source_count - first < block_rows ? source_count - first : (int)block_rows;
+        for (int i = 0; i < worker_count; i++) {
+            workers[i].origins = sources + first;
+            workers[i].origin_count = rows;
+            workers[i].rows = block;
+        }
+        run_parallel(run_forward_worker, workers, sizeof(MatrixWorker), worker_count);
+        if (sink(context, first, rows, block) != 0) {
+            result = -1;    // Reported by the sink's owner
+        }
+    }
+    if (result == 0) {
+        printf("✅ %d x %d distance matrix (%d threads, %.2fs): %ld bucket entries\n",
+               source_count, target_count, worker_count, wall_seconds() - start_time,
+               buckets.entry_count);
+    }
+
+    for (int i = 0; i < ready; i++) {
+        free(workers[i].settled);
+        free(workers[i].row);
+        free_search_workspace(&workers[i].workspace);
+    }
+    free(buckets.offsets);
+    free(buckets.targets);
+    free(buckets.distances);
+    free(block);
+    return result;
+}
+
+// Dense destination of distance_matrix
+typedef struct {
+    float* matrix;
+    int target_count;
+} DenseMatrix;
+
+static int copy_rows(void* context, int first_row, int row_count, const float* rows) {
+    DenseMatrix* dense = context;
+    memcpy(dense->matrix + (size_t)first_row * dense->target_count, rows,
+           (size_t)row_count * dense->target_count * sizeof(float));
+    return 0;
+}
+
+int distance_matrix(const ContractionHierarchy* ch, const int* sources, int source_count,
+                    const int* targets, int target_count, int thread_count, float* matrix) {
+    DenseMatrix dense = { matrix, target_count };
+    return distance_matrix_stream(ch, sources, source_count, targets, target_count, thread_count,
+                                  copy_rows, &dense);
+}
+
+// File destination of write_distance_matrix
+typedef struct {
+    FILE* file;
+    int target_count;
+} MatrixFile;
+
+static int write_rows(void* context, int first_row, int row_count, const float* rows) {
+    MatrixFile* out = context;
+    size_t count = (size_t)row_count * out->target_count;
+    (void)first_row;
+    return fwrite(rows, sizeof(float), count, out->file) == count ? 0 : -1;
+}
+
+int write_distance_matrix(const ContractionHierarchy* ch, const int* sources, int source_count,
+                          const int* targets, int target_count, int thread_count,
+                          const char* filename) {
+    MatrixFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, DISTANCE_MATRIX_FILE_MAGIC, sizeof(DISTANCE_MATRIX_FILE_MAGIC));
+    header.version = DISTANCE_MATRIX_FILE_VERSION;
+    header.byte_order = DISTANCE_MATRIX_FILE_BYTE_ORDER;
+    header.source_count = source_count;
+    header.target_count = target_count;
+    header.fingerprint = ch->fingerprint;
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Could not create %s\n", filename);
+        return -1;
+    }
+    MatrixFile out = { file, target_count };
+    int result = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 distance_matrix_stream(ch, sources, source_count, targets, target_count,
+                                        thread_count, write_rows, &out) == 0 ? 0 : -1;
+    if (fclose(file) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        printf("Error: Could not write %s\n", filename);
+        remove(filename);
+    }
+    return result;
+}
+
+int load_distance_matrix(const char* filename, int* source_count, int* target_count, float** matrix) {
+    *matrix = NULL;
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return -1;
+    }
+
+    MatrixFileHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, DISTANCE_MATRIX_FILE_MAGIC, sizeof(DISTANCE_MATRIX_FILE_MAGIC)) != 0 ||
+        header.version != DISTANCE_MATRIX_FILE_VERSION ||
+        header.byte_order != DISTANCE_MATRIX_FILE_BYTE_ORDER ||
+        header.source_count < 0 || header.target_count < 0) {
+        printf("Error: %s is not a compatible distance matrix file (version %d)\n",
+               filename, DISTANCE_MATRIX_FILE_VERSION);
+        fclose(file);
+        return -1;
+    }
+
+    size_t count = (size_t)header.source_count * header.target_count;
+    *matrix = malloc((count > 0 ? count : 1) * sizeof(float));
+    if (!*matrix || fread(*matrix, sizeof(float), count, file) != count) {
+        printf("Error: Could not read %s\n", filename);
+        free(*matrix);
+        *matrix = NULL;
+        fclose(file);
+        return -1;
+    }
+    fclose(file);
+    *source_count = header.source_count;
+    *target_count = header.target_count;
+    return 0;
+}
@@ -0,0 +1,62 @@
+/**
+ * distance_matrix.h
+ * One-to-many and many-to-many distance tables from a contraction hierarchy
+ */
+
+#ifndef DISTANCE_MATRIX_H
+#define DISTANCE_MATRIX_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define DISTANCE_MATRIX_FILE_VERSION 1
+#define MATRIX_BLOCK_BYTES (4 << 20)    // Rows computed (and held) per block
+
+/**
+ * Receives each block of finished rows in order: row_count rows of
+ * target_count floats, row-major, starting at source index first_row
+ * @return 0 to continue, nonzero to stop the computation
+ */
+typedef int (*MatrixRowSink)(void* context, int first_row, int row_count, const float* rows);
+
+/**
+ * Distances in km from every source to every target, INF where there is
+ * no path. A backward upward search from each target leaves its distance
+ * in a bucket at every node it settles; a forward upward search from each
+ * source then meets all targets at once by scanning the buckets of the
+ * nodes it settles. Sources are computed MATRIX_BLOCK_BYTES of rows at a
+ * time, the rows of a block shared among threads, and each block is
+ * handed to sink before the next is started.
+ * @param thread_count Search threads, or 0 for one per online CPU
+ * @return 0 on success, -1 on a bad node index, if memory runs out or
+ *         the sink stops the computation
+ */
+int distance_matrix_stream(const ContractionHierarchy* ch, const int* sources, int source_count,
+                           const int* targets, int target_count, int thread_count,
+                           MatrixRowSink sink, void* context);
+
+/**
+ * distance_matrix_stream into a dense source_count x target_count matrix
+ * @param matrix source_count * target_count floats, row-major
+ */
+int distance_matrix(const ContractionHierarchy* ch, const int* sources, int source_count,
+                    const int* targets, int target_count, int thread_count, float* matrix);
+
+/**
+ * distance_matrix_stream into a binary file: a header with the matrix
+ * size and the fingerprint of the graph, then the rows as native floats,
+ * written block by block so the matrix never has to fit in memory
+ * @return 0 on success, -1 on a bad node index or I/O failure
+ */
+int write_distance_matrix(const ContractionHierarchy* ch, const int* sources, int source_count,
+                          const int* targets, int target_count, int thread_count,
+                          const char* filename);
+
+/**
+ * Read a whole file written by write_distance_matrix
+ * @param matrix Set to a malloc'd row-major matrix the caller frees
+ * @return 0 on success, -1 if the file is missing or corrupt
+ */
+int load_distance_matrix(const char* filename, int* source_count, int* target_count, float** matrix);
+
+#endif // DISTANCE_MATRIX_H
@@ -6,59 +6,299 @@
 #ifndef GPS_TYPES_H
 #define GPS_TYPES_H
 
+#include <stddef.h>
+#include <stdint.h>
+
 // Constants
-#define MAX_NODES 50
-#define MAX_EDGES 200
+#define INITIAL_NODE_CAPACITY 64    // Graph storage grows from here as locations are added
 #define EARTH_RADIUS 6371.0  // Earth radius in kilometers
 #define PI 3.14159265359
 #define INF 999999.0
+#define HEAP_ARITY 4                // Default priority queue fan-out (power of two)
+#define WEIGHT_UNITS_PER_KM 1000.0  // Integer weight unit (metres) of the radix-heap search
+#define RADIX_BUCKETS 33            // Radix heap: bucket 0 plus one per bit of a 32-bit key
+#define TIME_SLOTS 96               // Fifteen-minute slots of a time-dependent profile
+#define MAX_ALTERNATIVE_ROUTES 4    // The shortest route and up to three alternatives
+
+// Road categories interned at graph init, so they always get these IDs.
+// Other road types seen while loading are interned after them.
+typedef enum {
+    ROAD_MAIN = 0,
+    ROAD_HIGHWAY,
+    ROAD_LOCAL,
+    ROAD_TYPE_BUILTIN_COUNT
+} RoadType;
+
+#define LOCATION_TYPE_GENERAL 0     // Interned ID of "general"
+#define DISTRICT_UNKNOWN 0          // Interned ID of "unknown"
+#define MAX_ROAD_TYPES 256          // Road type IDs must fit in an unsigned char
 
-// GPS Location structure
+// GPS Location metadata (cold: only read when routes are printed or exported)
 typedef struct {
     int id;
     char name[50];
-    char type[20];      // "station", "airport", "landmark", etc.
-    double latitude;
-    double longitude;
-    double elevation;   // Height above sea level in meters
-    int traffic_level;  // 1-5 scale (1=low, 5=high)
-    char district[30];
+    unsigned short type;        // Interned: "station", "airport", "landmark", etc.
+    unsigned short district;    // Interned district name
+    int traffic_level;          // 1-5 scale (1=low, 5=high)
 } Location;
 
 // Edge in the graph (represents road between two locations)
 typedef struct Edge {
-    int destination;
-    double base_distance;    // Physical distance in km
-    double current_weight;   // Dynamic weight considering traffic
-    char road_type[20];      // "highway", "main", "local"
-    int traffic_factor;      // Current traffic multiplier (1-3)
-    double speed_limit;      // Speed limit in km/h
     struct Edge* next;
+    double base_distance;        // Physical distance in km
+    double current_weight;       // Dynamic weight considering traffic
+    int destination;
+    float speed_limit;           // Speed limit in km/h
+    unsigned char road_type;     // Interned road type (RoadType for built-ins)
+    unsigned char traffic_factor;// Current traffic multiplier (1-3)
 } Edge;
 
-// Graph node with adjacency list
+// One-way edge handed to add_edges_bulk (distance already computed)
 typedef struct {
-    Location location;
-    Edge* edges;
-    int is_active;  // For dynamic graph updates
-} GraphNode;
+    int from;
+    int to;
+    double distance;            // km
+    float speed_limit;
+    unsigned char road_type;    // Interned road type ID
+    unsigned char traffic_factor;
+} DirectedEdge;
 
-// Priority queue node for pathfinding algorithms
+// Hot per-node data read inside the search loops, stored as dense
+// parallel arrays (structure-of-arrays) indexed by node
+typedef struct {
+    double* latitude;
+    double* longitude;
+    double* elevation;          // Height above sea level in meters
+    unsigned char* is_active;   // For dynamic graph updates
+} NodeStore;
+
+// Compressed sparse row adjacency (search-time graph built by freeze_graph)
+// Outgoing edges of node u occupy [offsets[u], offsets[u+1]) in the
+// targets/weights arrays, so a node's edges sit next to each other.
+// The reverse_* arrays hold the transpose: incoming edges of node v occupy
+// [reverse_offsets[v], reverse_offsets[v+1]) in reverse_sources/weights.
+typedef struct {
+    int* offsets;       // node_count + 1 entries
+    int* targets;       // Destination node of each edge
+    double* weights;    // current_weight of each edge
+    int* reverse_offsets;       // node_count + 1 entries
+    int* reverse_sources;       // Origin node of each incoming edge
+    double* reverse_weights;    // current_weight of each incoming edge
+    // Edge attributes in forward CSR order, so traffic reweighting and
+    // time profiles need no edge lists (graph files store them too)
+    double* base_distances;     // km
+    float* speed_limits;        // km/h
+    unsigned char* road_types;
+    unsigned char* traffic_factors;
+    int edge_count;
+    int is_frozen;      // Cleared whenever the linked-list graph changes
+    // graph_fingerprint and graph_topology_fingerprint, kept current by
+    // freezing, reweighting and opening graph files so searches compare
+    // them without hashing the graph
+    uint64_t fingerprint;
+    uint64_t topology_fingerprint;
+} CSRGraph;
+
+// Vertex and exact key returned by extract_min
 typedef struct {
     int vertex;
     double distance;
-    double g_cost;  // Actual cost from start (A* specific)
-    double h_cost;  // Heuristic cost to goal (A* specific)
-    double f_cost;  // Total cost = g + h (A* specific)
-    int parent;     // Previous vertex in path
 } PQNode;
 
-// Min-heap for Dijkstra's and A* algorithms
+// Packed 8-byte heap entry: comparisons read only the entry array, with
+// the exact key consulted just to break ties between equal float keys
+typedef struct {
+    float key;
+    int vertex;
+} HeapEntry;
+
+// Indexed d-ary min-heap for Dijkstra's and A* algorithms. Each vertex is
+// queued at most once; position[] locates it for decrease-key.
 typedef struct {
-    PQNode nodes[MAX_NODES];
+    HeapEntry* entries;     // Aligned so each node's children share a cache line
+    void* storage;          // Allocation behind entries
+    double* distance;       // Exact key of each queued vertex
+    int* position;          // Slot of each vertex in entries, -1 if not queued
     int size;
+    int capacity;           // Vertex count
+    int arity_shift;        // log2 of the fan-out
+    long pushes;            // Operation counts since init (for benchmarks)
+    long pops;
+    long decreases;
 } MinHeap;
 
+// Per-thread search state reused across queries. Entries are valid only
+// for vertices whose stamp equals epoch, so starting a search is O(1).
+typedef struct {
+    int node_count;
+    unsigned int epoch;     // Current search
+    unsigned int* stamp;    // Search that last reached each vertex
+    double* distance;       // Distance (Dijkstra) or g cost (A*), when stamped
+    int* previous;          // Predecessor on the search tree, when stamped
+    MinHeap heap;           // Kept allocated between searches
+    int settled;            // Vertices settled by the last search
+} SearchWorkspace;
+
+typedef struct {
+    uint32_t key;
+    int vertex;
+} RadixEntry;
+
+// Monotone radix heap over integer keys. Bucket 0 holds keys equal to
+// last; bucket i > 0 holds keys whose highest bit differing from last is
+// bit i-1. Keys pushed may never be below last (Dijkstra guarantees it).
+typedef struct {
+    RadixEntry* buckets[RADIX_BUCKETS];
+    int bucket_size[RADIX_BUCKETS];
+    int bucket_capacity[RADIX_BUCKETS];
+    uint32_t last;      // Most recently extracted key
+    int size;
+    long pushes;        // Operation counts since init (for benchmarks)
+    long pops;
+} RadixHeap;
+
+// One direction of a contraction hierarchy in CSR form. Edges of node v
+// occupy [offsets[v], offsets[v+1]); a shortcut's middle is the node it
+// bypasses (contracted before both ends), -1 for an original road.
+typedef struct {
+    int* offsets;       // node_count + 1 entries
+    int* neighbours;    // Higher-ranked node at the other end
+    double* weights;
+    int* middle;
+    int edge_count;
+} HierarchyEdges;
+
+// Contraction hierarchy built by build_contraction_hierarchy. up holds
+// edges v -> w and down holds edges w -> v, both with rank[w] > rank[v],
+// so queries only ever climb the hierarchy.
+typedef struct {
+    int node_count;
+    int* rank;              // Contraction order of each node
+    HierarchyEdges up;
+    HierarchyEdges down;
+    int shortcut_count;
+    uint64_t fingerprint;   // graph_fingerprint of the graph it was built for
+} ContractionHierarchy;
+
+// Landmark distances for ALT lower bounds, node-major so the values the
+// heuristic reads for one node share a cache line. Floats rounded down
+// (INF where unreachable) halve the footprint of doubles.
+typedef struct {
+    int node_count;
+    int count;                  // Landmarks
+    int* nodes;                 // Node index of each landmark
+    float* to_landmark;         // [v * count + l]: distance v -> landmark l
+    float* from_landmark;       // [v * count + l]: distance landmark l -> v
+} LandmarkSet;
+
+#define MAX_OVERLAY_LEVELS 4
+
+// One level of a multi-level overlay. Boundary vertices have a road to or
+// from another cell of the level; each cell's matrix holds the shortest
+// distance inside the cell from every boundary vertex to every other.
+typedef struct {
+    int cell_count;
+    int* boundary_offsets;      // cell_count + 1 entries into boundary
+    int* boundary;              // Boundary vertices grouped by cell
+    int* boundary_index;        // node_count entries: position in its cell's list, -1 if none
+    size_t* matrix_offsets;     // cell_count + 1 entries into weights
+    double* weights;            // Row-major matrix per cell, INF where unreachable
+} OverlayLevel;
+
+// Multi-level overlay built by build_overlay. The partition and boundary
+// vertices depend only on the roads; customize_overlay fills the matrices
+// from the current weights. levels[0] has the smallest cells, and each
+// node's cell on level l is cell[v] >> (OVERLAY_LEVEL_BITS * l).
+typedef struct {
+    int node_count;
+    int level_count;
+    unsigned int* cell;         // Finest cell of each node
+    OverlayLevel levels[MAX_OVERLAY_LEVELS];
+    uint64_t topology;          // graph_topology_fingerprint it was built for
+    uint64_t metric;            // graph_fingerprint it was last customized for, 0 if never
+} MultiLevelOverlay;
+
+// One direction of a hub labeling. The label of v occupies
+// [offsets[v], offsets[v+1]) of hubs and distances, hubs ascending, so
+// two labels meet in a single merge.
+typedef struct {
+    uint64_t* offsets;          // node_count + 1 entries
+    int32_t* hubs;              // Contraction rank of each hub
+    double* distances;
+} HubLabelArrays;
+
+// Hub labels built by build_hub_labels: any shortest path s -> t passes
+// through a hub in both forward[s] (s -> hub) and backward[t] (hub -> t).
+// Arrays point into mapping when opened from a label file.
+typedef struct {
+    int node_count;
+    HubLabelArrays forward;
+    HubLabelArrays backward;
+    uint64_t fingerprint;       // graph_fingerprint of the graph they were built for
+    void* mapping;              // NULL unless memory-mapped
+    size_t mapping_size;
+} HubLabels;
+
+// Arc flags computed by compute_arc_flags: bit r of an edge's flags is set
+// when the edge starts some shortest path into region r. flags holds
+// flag_bytes per edge, parallel to the CSR targets and weights.
+typedef struct {
+    int node_count;
+    int edge_count;
+    int region_count;
+    int flag_bytes;             // (region_count + 7) / 8
+    unsigned char* region;      // Region of each node
+    unsigned char* flags;       // edge_count * flag_bytes
+    uint64_t fingerprint;       // graph_fingerprint of the weights they were computed for
+} ArcFlags;
+
+// Time-dependent travel times built by build_time_profiles. Edge e (CSR
+// order) takes free_flow[e] minutes scaled by its profile, which is
+// piecewise linear between TIME_SLOTS breakpoints at the start of each
+// fifteen-minute slot. Edges of the same road type and traffic factor
+// share one profile, so each edge costs six bytes.
+typedef struct {
+    int edge_count;
+    int profile_count;
+    float* factors;             // profile_count * TIME_SLOTS breakpoints
+    unsigned short* profile;    // Profile of each edge
+    float* free_flow;           // Minutes to cross each edge without congestion
+    double min_minutes_per_km;  // Lower bound on any edge's minutes per km, for A*
+    uint64_t topology;          // graph_topology_fingerprint they were built for
+} TimeProfiles;
+
+// One route found by find_alternatives. path points into the workspace
+// that found it and stays valid until that workspace's next query.
+typedef struct {
+    int* path;
+    int length;                 // Vertices on path
+    double distance;            // km
+    double shared;              // km also driven by an earlier route
+    double plateau;             // km on both shortest path trees (locally optimal)
+    int via;                    // First vertex of that plateau, -1 for the shortest route
+} AlternativeRoute;
+
+// Per-thread state of the alternative route search: a shortest path tree
+// out of the start, one into the end, and per-vertex scratch. route_next
+// and on_path are restored by each query, so none of it is reset per query.
+typedef struct {
+    int node_count;
+    SearchWorkspace forward;
+    SearchWorkspace backward;
+    int* forward_order;         // Vertices in the order each tree settled them
+    int* backward_order;
+    int forward_count;
+    int backward_count;
+    double* forward_shared;     // km of the tree path start -> v on chosen routes
+    double* backward_shared;    // km of the tree path v -> end on chosen routes
+    double* plateau;            // km of the plateau starting at v, 0 if none starts there
+    int* route_next;            // [v * MAX_ALTERNATIVE_ROUTES + r]: successor on route r, or -1
+    unsigned char* on_path;     // Marks the candidate path being checked
+    int* paths;                 // MAX_ALTERNATIVE_ROUTES * node_count vertices
+    AlternativeRoute routes[MAX_ALTERNATIVE_ROUTES];
+    int route_count;
+} AlternativeWorkspace;
+
 // Route statistics
 typedef struct {
     double total_distance;
@@ -6,160 +6,772 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
+#include <limits.h>
 #include "graph.h"
 #include "distance.h"
+#include "graph_file.h"
 
-// Global graph
-GraphNode graph[MAX_NODES];
-int node_count = 0;
+// Resize one per-node array; leaves *array untouched on failure
+static int resize_array(void** array, size_t element_size, int capacity) {
+    void* resized = realloc(*array, (size_t)capacity * element_size);
+    if (!resized) {
+        return -1;
+    }
+    *array = resized;
+    return 0;
+}
+
+// Graphs opened from a graph file are read-only mappings
+static int check_writable(const Graph* graph) {
+    if (graph->is_mapped) {
+        printf("Error: Graph is mapped from a graph file and cannot be modified\n");
+        return -1;
+    }
+    return 0;
+}
+
+int reserve_nodes(Graph* graph, int capacity) {
+    if (capacity <= graph->node_capacity) {
+        return 0;
+    }
+    if (check_writable(graph) != 0) {
+        return -1;
+    }
+    
+    if (resize_array((void**)&graph->nodes.latitude, sizeof(double), capacity) != 0 ||
+        resize_array((void**)&graph->nodes.longitude, sizeof(double), capacity) != 0 ||
+        resize_array((void**)&graph->nodes.elevation, sizeof(double), capacity) != 0 ||
+        resize_array((void**)&graph->nodes.is_active, sizeof(unsigned char), capacity) != 0 ||
+        resize_array((void**)&graph->locations, sizeof(Location), capacity) != 0 ||
+        resize_array((void**)&graph->edge_lists, sizeof(Edge*), capacity) != 0 ||
+        (graph->original_index && resize_array((void**)&graph->original_index, sizeof(int), capacity) != 0) ||
+        (graph->current_index && resize_array((void**)&graph->current_index, sizeof(int), capacity) != 0)) {
+        printf("Error: Could not allocate storage for %d locations\n", capacity);
+        return -1;
+    }
+    
+    for (int i = graph->node_capacity; i < capacity; i++) {
+        graph->edge_lists[i] = NULL;
+        graph->nodes.is_active[i] = 0;
+    }
+    graph->node_capacity = capacity;
+    return 0;
+}
+
+// Claims the next node index, doubling the storage when it is full
+static int next_node_slot(Graph* graph) {
+    if (graph->node_count == graph->node_capacity) {
+        int new_capacity = graph->node_capacity > 0 ? graph->node_capacity * 2 : INITIAL_NODE_CAPACITY;
+        if (reserve_nodes(graph, new_capacity) != 0) {
+            return -1;
+        }
+    }
+    return graph->node_count;
+}
+
+static unsigned int hash_name_nocase(const char* name) {
+    unsigned int hash = 2166136261u;
+    while (*name) {
+        hash ^= (unsigned char)tolower((unsigned char)*name++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static int equals_nocase(const char* a, const char* b) {
+    while (*a && tolower((unsigned char)*a) == tolower((unsigned char)*b)) {
+        a++;
+        b++;
+    }
+    return tolower((unsigned char)*a) == tolower((unsigned char)*b);
+}
+
+// Index node `index` unless an earlier node already has exactly this name:
+// lookups return the lowest matching index, and repeated names (unnamed
+// intersections, say) must not pile up into one long probe chain
+static void name_index_insert(Graph* graph, int index) {
+    const char* name = graph->locations[index].name;
+    int mask = graph->name_slot_count - 1;
+    int slot = (int)(hash_name_nocase(name) & (unsigned int)mask);
+    while (graph->name_slots[slot] != 0) {
+        if (strcmp(graph->locations[graph->name_slots[slot] - 1].name, name) == 0) {
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+    graph->name_slots[slot] = index + 1;
+}
+
+// Keep the load factor at or below one half, rebuilding in index order
+static int reserve_name_index(Graph* graph, int count) {
+    if (count * 2 <= graph->name_slot_count) {
+        return 0;
+    }
+    
+    int slot_count = graph->name_slot_count > 0 ? graph->name_slot_count : INITIAL_NODE_CAPACITY;
+    while (count * 2 > slot_count) {
+        slot_count *= 2;
+    }
+    int* slots = calloc((size_t)slot_count, sizeof(int));
+    if (!slots) {
+        printf("Error: Could not allocate name index\n");
+        return -1;
+    }
+    
+    free(graph->name_slots);
+    graph->name_slots = slots;
+    graph->name_slot_count = slot_count;
+    for (int i = 0; i < graph->node_count; i++) {
+        name_index_insert(graph, i);
+    }
+    return 0;
+}
+
+static int name_index_lookup(const Graph* graph, const char* name, int ignore_case) {
+    if (graph->name_slot_count == 0) {
+        return -1;
+    }
+    
+    int mask = graph->name_slot_count - 1;
+    int slot = (int)(hash_name_nocase(name) & (unsigned int)mask);
+    while (graph->name_slots[slot] != 0) {
+        const char* candidate = graph->locations[graph->name_slots[slot] - 1].name;
+        if (ignore_case ? equals_nocase(candidate, name) : strcmp(candidate, name) == 0) {
+            return graph->name_slots[slot] - 1;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return -1;
+}
+
+// Built-in categories are interned first so their IDs match RoadType etc.
+static int intern_builtin_categories(Graph* graph) {
+    if (intern_string(&graph->road_types, "main") != ROAD_MAIN ||
+        intern_string(&graph->road_types, "highway") != ROAD_HIGHWAY ||
+        intern_string(&graph->road_types, "local") != ROAD_LOCAL ||
+        intern_string(&graph->location_types, "general") != LOCATION_TYPE_GENERAL ||
+        intern_string(&graph->districts, "unknown") != DISTRICT_UNKNOWN) {
+        printf("Error: Could not allocate category tables\n");
+        return -1;
+    }
+    return 0;
+}
 
-void init_graph(void) {
-    node_count = 0;
-    for (int i = 0; i < MAX_NODES; i++) {
-        graph[i].edges = NULL;
-        graph[i].is_active = 0;
+int init_graph(Graph* graph) {
+    memset(graph, 0, sizeof(Graph));
+    arena_init(&graph->edge_arena);
+    init_string_table(&graph->road_types);
+    init_string_table(&graph->location_types);
+    init_string_table(&graph->districts);
+    
+    if (intern_builtin_categories(graph) != 0) {
+        cleanup_graph(graph);
+        return -1;
     }
+    return reserve_nodes(graph, INITIAL_NODE_CAPACITY);
 }
 
-void add_location(int id, const char* name, double lat, double lon) {
-    graph[node_count].location.id = id;
-    strncpy(graph[node_count].location.name, name, sizeof(graph[node_count].location.name) - 1);
-    graph[node_count].location.name[sizeof(graph[node_count].location.name) - 1] = '\0';
-    strcpy(graph[node_count].location.type, "general");
-    strcpy(graph[node_count].location.district, "unknown");
-    graph[node_count].location.latitude = lat;
-    graph[node_count].location.longitude = lon;
-    graph[node_count].location.elevation = 0.0;
-    graph[node_count].location.traffic_level = 1;
-    graph[node_count].edges = NULL;
-    graph[node_count].is_active = 1;
-    node_count++;
+int add_location(Graph* graph, int id, const char* name, double lat, double lon) {
+    return add_enhanced_location(graph, id, name, "general", "unknown", lat, lon, 0.0, 1);
 }
 
-void add_enhanced_location(int id, const char* name, const char* type, 
+int add_enhanced_location(Graph* graph, int id, const char* name, const char* type, 
                           const char* district, double lat, double lon, 
                           double elev, int traffic) {
-    graph[node_count].location.id = id;
-    strncpy(graph[node_count].location.name, name, sizeof(graph[node_count].location.name) - 1);
-    graph[node_count].location.name[sizeof(graph[node_count].location.name) - 1] = '\0';
-    strncpy(graph[node_count].location.type, type, sizeof(graph[node_count].location.type) - 1);
-    graph[node_count].location.type[sizeof(graph[node_count].location.type) - 1] = '\0';
-    strncpy(graph[node_count].location.district, district, sizeof(graph[node_count].location.district) - 1);
-    graph[node_count].location.district[sizeof(graph[node_count].location.district) - 1] = '\0';
-    graph[node_count].location.latitude = lat;
-    graph[node_count].location.longitude = lon;
-    graph[node_count].location.elevation = elev;
-    graph[node_count].location.traffic_level = traffic;
-    graph[node_count].edges = NULL;
-    graph[node_count].is_active = 1;
-    node_count++;
-}
-
-void add_edge(int from, int to) {
+    int type_id = intern_string(&graph->location_types, type);
+    int district_id = intern_string(&graph->districts, district);
+    if (type_id < 0 || district_id < 0 || type_id > USHRT_MAX || district_id > USHRT_MAX) {
+        printf("Error: Could not intern category for location %d\n", id);
+        return -1;
+    }
+    
+    int index = next_node_slot(graph);
+    if (index < 0 || reserve_name_index(graph, graph->node_count + 1) != 0) {
+        return -1;
+    }
+    
+    Location* location = &graph->locations[index];
+    location->id = id;
+    strncpy(location->name, name, sizeof(location->name) - 1);
+    location->name[sizeof(location->name) - 1] = '\0';
+    location->type = (unsigned short)type_id;
+    location->district = (unsigned short)district_id;
+    location->traffic_level = traffic;
+    
+    graph->nodes.latitude[index] = lat;
+    graph->nodes.longitude[index] = lon;
+    graph->nodes.elevation[index] = elev;
+    graph->nodes.is_active[index] = 1;
+    graph->edge_lists[index] = NULL;
+    if (graph->original_index) {
+        graph->original_index[index] = index;
+        graph->current_index[index] = index;
+    }
+    name_index_insert(graph, index);
+    graph->csr.is_frozen = 0;
+    return graph->node_count++;
+}
+
+static int valid_edge_endpoints(const Graph* graph, int from, int to) {
+    if (check_writable(graph) != 0) {
+        return 0;
+    }
+    if (from < 0 || from >= graph->node_count || to < 0 || to >= graph->node_count) {
+        printf("Error: Edge %d -> %d references an unknown location\n", from, to);
+        return 0;
+    }
+    if (from == to) {
+        printf("Error: Edge %d -> %d is a self-loop\n", from, to);
+        return 0;
+    }
+    return 1;
+}
+
+static int has_edge(const Graph* graph, int from, int to) {
+    for (const Edge* edge = graph->edge_lists[from]; edge != NULL; edge = edge->next) {
+        if (edge->destination == to) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int add_edge(Graph* graph, int from, int to) {
+    if (!valid_edge_endpoints(graph, from, to)) {
+        return -1;
+    }
+    if (has_edge(graph, from, to)) {
+        return 0;
+    }
+    
     // Calculate distance using Haversine formula
     double distance = haversine_distance(
-        graph[from].location.latitude, graph[from].location.longitude,
-        graph[to].location.latitude, graph[to].location.longitude
+        graph->nodes.latitude[from], graph->nodes.longitude[from],
+        graph->nodes.latitude[to], graph->nodes.longitude[to]
     );
     
+    // Both directions come from one bump allocation
+    Edge* new_edge = arena_alloc(&graph->edge_arena, 2 * sizeof(Edge));
+    if (!new_edge) {
+        printf("Error: Could not allocate edge storage\n");
+        return -1;
+    }
+    Edge* reverse_edge = new_edge + 1;
+    
     // Add forward edge
-    Edge* new_edge = malloc(sizeof(Edge));
     new_edge->destination = to;
     new_edge->base_distance = distance;
     new_edge->current_weight = distance;
-    strcpy(new_edge->road_type, "main");
+    new_edge->road_type = ROAD_MAIN;
     new_edge->traffic_factor = 1;
-    new_edge->speed_limit = 50.0;
-    new_edge->next = graph[from].edges;
-    graph[from].edges = new_edge;
+    new_edge->speed_limit = 50.0f;
+    new_edge->next = graph->edge_lists[from];
+    graph->edge_lists[from] = new_edge;
     
     // Add reverse edge (bidirectional)
-    Edge* reverse_edge = malloc(sizeof(Edge));
     reverse_edge->destination = from;
     reverse_edge->base_distance = distance;
     reverse_edge->current_weight = distance;
-    strcpy(reverse_edge->road_type, "main");
+    reverse_edge->road_type = ROAD_MAIN;
     reverse_edge->traffic_factor = 1;
-    reverse_edge->speed_limit = 50.0;
-    reverse_edge->next = graph[to].edges;
-    graph[to].edges = reverse_edge;
+    reverse_edge->speed_limit = 50.0f;
+    reverse_edge->next = graph->edge_lists[to];
+    graph->edge_lists[to] = reverse_edge;
+    
+    graph->edge_count += 2;
+    graph->csr.is_frozen = 0;
+    return 0;
 }
 
-void add_enhanced_edge(int from, int to, const char* road_type, 
+int add_enhanced_edge(Graph* graph, int from, int to, const char* road_type, 
                       int traffic_factor, double speed_limit) {
+    if (!valid_edge_endpoints(graph, from, to)) {
+        return -1;
+    }
+    if (has_edge(graph, from, to)) {
+        return 0;
+    }
+    
+    int road_type_id = intern_string(&graph->road_types, road_type);
+    if (road_type_id < 0 || road_type_id >= MAX_ROAD_TYPES) {
+        printf("Error: Could not intern road type '%s'\n", road_type);
+        return -1;
+    }
+    
     double distance = enhanced_haversine_distance(
-        graph[from].location.latitude, graph[from].location.longitude, 
-        graph[from].location.elevation,
-        graph[to].location.latitude, graph[to].location.longitude, 
-        graph[to].location.elevation
+        graph->nodes.latitude[from], graph->nodes.longitude[from], 
+        graph->nodes.elevation[from],
+        graph->nodes.latitude[to], graph->nodes.longitude[to], 
+        graph->nodes.elevation[to]
     );
     
+    // Both directions come from one bump allocation
+    Edge* new_edge = arena_alloc(&graph->edge_arena, 2 * sizeof(Edge));
+    if (!new_edge) {
+        printf("Error: Could not allocate edge storage\n");
+        return -1;
+    }
+    Edge* reverse_edge = new_edge + 1;
+    
     // Forward edge
-    Edge* new_edge = malloc(sizeof(Edge));
     new_edge->destination = to;
     new_edge->base_distance = distance;
     new_edge->current_weight = distance;
-    strncpy(new_edge->road_type, road_type, sizeof(new_edge->road_type) - 1);
-    new_edge->road_type[sizeof(new_edge->road_type) - 1] = '\0';
-    new_edge->traffic_factor = traffic_factor;
-    new_edge->speed_limit = speed_limit;
-    new_edge->next = graph[from].edges;
-    graph[from].edges = new_edge;
+    new_edge->road_type = (unsigned char)road_type_id;
+    new_edge->traffic_factor = (unsigned char)traffic_factor;
+    new_edge->speed_limit = (float)speed_limit;
+    new_edge->next = graph->edge_lists[from];
+    graph->edge_lists[from] = new_edge;
     
     // Reverse edge
-    Edge* reverse_edge = malloc(sizeof(Edge));
     reverse_edge->destination = from;
     reverse_edge->base_distance = distance;
     reverse_edge->current_weight = distance;
-    strncpy(reverse_edge->road_type, road_type, sizeof(reverse_edge->road_type) - 1);
-    reverse_edge->road_type[sizeof(reverse_edge->road_type) - 1] = '\0';
-    reverse_edge->traffic_factor = traffic_factor;
-    reverse_edge->speed_limit = speed_limit;
-    reverse_edge->next = graph[to].edges;
-    graph[to].edges = reverse_edge;
+    reverse_edge->road_type = (unsigned char)road_type_id;
+    reverse_edge->traffic_factor = (unsigned char)traffic_factor;
+    reverse_edge->speed_limit = (float)speed_limit;
+    reverse_edge->next = graph->edge_lists[to];
+    graph->edge_lists[to] = reverse_edge;
+    
+    graph->edge_count += 2;
+    graph->csr.is_frozen = 0;
+    return 0;
 }
 
-Location* get_location(int id) {
-    if (id >= 0 && id < node_count) {
-        return &graph[id].location;
+int add_directed_edge(Graph* graph, int from, int to, const char* road_type,
+                      int traffic_factor, double speed_limit) {
+    if (!valid_edge_endpoints(graph, from, to)) {
+        return -1;
     }
-    return NULL;
+    if (has_edge(graph, from, to)) {
+        return 0;
+    }
+    
+    int road_type_id = intern_string(&graph->road_types, road_type);
+    if (road_type_id < 0 || road_type_id >= MAX_ROAD_TYPES) {
+        printf("Error: Could not intern road type '%s'\n", road_type);
+        return -1;
+    }
+    
+    Edge* edge = arena_alloc(&graph->edge_arena, sizeof(Edge));
+    if (!edge) {
+        printf("Error: Could not allocate edge storage\n");
+        return -1;
+    }
+    
+    double distance = enhanced_haversine_distance(
+        graph->nodes.latitude[from], graph->nodes.longitude[from], 
+        graph->nodes.elevation[from],
+        graph->nodes.latitude[to], graph->nodes.longitude[to], 
+        graph->nodes.elevation[to]
+    );
+    edge->destination = to;
+    edge->base_distance = distance;
+    edge->current_weight = distance;
+    edge->road_type = (unsigned char)road_type_id;
+    edge->traffic_factor = (unsigned char)traffic_factor;
+    edge->speed_limit = (float)speed_limit;
+    edge->next = graph->edge_lists[from];
+    graph->edge_lists[from] = edge;
+    
+    graph->edge_count++;
+    graph->csr.is_frozen = 0;
+    return 0;
 }
 
-int find_location_by_name(const char* name) {
-    for (int i = 0; i < node_count; i++) {
-        if (strcmp(graph[i].location.name, name) == 0) {
-            return i;
+int add_edges_bulk(Graph* graph, DirectedEdge* edges, int count) {
+    if (check_writable(graph) != 0) {
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        if (edges[i].from < 0 || edges[i].from >= graph->node_count ||
+            edges[i].to < 0 || edges[i].to >= graph->node_count) {
+            printf("Error: Edge %d -> %d references an unknown location\n", edges[i].from, edges[i].to);
+            return -1;
         }
     }
-    return -1;
+    
+    // Sort by (source, destination) in linear time: a counting sort of the
+    // edge indices by destination, then a stable one of the edges by source.
+    // Parallel edges keep their input order.
+    int* start = calloc((size_t)graph->node_count + 1, sizeof(int));
+    int* by_destination = malloc((size_t)(count > 0 ? count : 1) * sizeof(int));
+    DirectedEdge* sorted = malloc((size_t)(count > 0 ? count : 1) * sizeof(DirectedEdge));
+    if (!start || !by_destination || !sorted) {
+        printf("Error: Could not allocate storage for %d edges\n", count);
+        free(start);
+        free(by_destination);
+        free(sorted);
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        start[edges[i].to + 1]++;
+    }
+    for (int u = 0; u < graph->node_count; u++) {
+        start[u + 1] += start[u];
+    }
+    for (int i = 0; i < count; i++) {
+        by_destination[start[edges[i].to]++] = i;
+    }
+    memset(start, 0, ((size_t)graph->node_count + 1) * sizeof(int));
+    for (int i = 0; i < count; i++) {
+        start[edges[i].from + 1]++;
+    }
+    for (int u = 0; u < graph->node_count; u++) {
+        start[u + 1] += start[u];
+    }
+    for (int k = 0; k < count; k++) {
+        const DirectedEdge* edge = &edges[by_destination[k]];
+        sorted[start[edge->from]++] = *edge;
+    }
+    free(by_destination);
+    for (int u = graph->node_count; u > 0; u--) {
+        start[u] = start[u - 1];
+    }
+    start[0] = 0;
+    
+    // Compact away self-loops and edges already present, keeping the
+    // shortest (first on ties) of each run of parallel edges
+    int kept = 0;
+    for (int u = 0; u < graph->node_count; u++) {
+        int i = start[u];
+        while (i < start[u + 1]) {
+            int to = sorted[i].to;
+            int shortest = i;
+            for (i++; i < start[u + 1] && sorted[i].to == to; i++) {
+                if (sorted[i].distance < sorted[shortest].distance) {
+                    shortest = i;
+                }
+            }
+            if (to != u && !has_edge(graph, u, to)) {
+                sorted[kept++] = sorted[shortest];
+            }
+        }
+    }
+    free(start);
+    
+    Edge* records = kept > 0 ? arena_alloc(&graph->edge_arena, (size_t)kept * sizeof(Edge)) : NULL;
+    if (kept > 0 && !records) {
+        printf("Error: Could not allocate edge storage\n");
+        free(sorted);
+        return -1;
+    }
+    
+    // Link back to front so each list runs in sorted order
+    for (int i = kept - 1; i >= 0; i--) {
+        Edge* edge = &records[i];
+        edge->destination = sorted[i].to;
+        edge->base_distance = sorted[i].distance;
+        edge->current_weight = sorted[i].distance;
+        edge->road_type = sorted[i].road_type;
+        edge->traffic_factor = sorted[i].traffic_factor;
+        edge->speed_limit = sorted[i].speed_limit;
+        edge->next = graph->edge_lists[sorted[i].from];
+        graph->edge_lists[sorted[i].from] = edge;
+    }
+    free(sorted);
+    
+    graph->edge_count += kept;
+    graph->csr.is_frozen = 0;
+    return kept;
 }
 
-void print_graph_stats(void) {
-    printf("Graph Statistics:\n");
-    printf("  Total Nodes: %d\n", node_count);
+static void free_csr(CSRGraph* csr) {
+    free(csr->offsets);
+    free(csr->targets);
+    free(csr->weights);
+    free(csr->reverse_offsets);
+    free(csr->reverse_sources);
+    free(csr->reverse_weights);
+    free(csr->base_distances);
+    free(csr->speed_limits);
+    free(csr->road_types);
+    free(csr->traffic_factors);
+    csr->offsets = NULL;
+    csr->targets = NULL;
+    csr->weights = NULL;
+    csr->reverse_offsets = NULL;
+    csr->reverse_sources = NULL;
+    csr->reverse_weights = NULL;
+    csr->base_distances = NULL;
+    csr->speed_limits = NULL;
+    csr->road_types = NULL;
+    csr->traffic_factors = NULL;
+    csr->edge_count = 0;
+    csr->is_frozen = 0;
+}
+
+int freeze_graph(Graph* graph) {
+    CSRGraph* csr = &graph->csr;
+    if (csr->is_frozen) {
+        return 0;
+    }
     
-    int total_edges = 0;
-    for (int i = 0; i < node_count; i++) {
-        Edge* edge = graph[i].edges;
-        while (edge != NULL) {
-            total_edges++;
-            edge = edge->next;
+    int edge_count = graph->edge_count;
+    free_csr(csr);
+    csr->offsets = malloc((size_t)(graph->node_count + 1) * sizeof(int));
+    csr->targets = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(int));
+    csr->weights = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(double));
+    csr->reverse_offsets = malloc((size_t)(graph->node_count + 1) * sizeof(int));
+    csr->reverse_sources = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(int));
+    csr->reverse_weights = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(double));
+    csr->base_distances = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(double));
+    csr->speed_limits = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(float));
+    csr->road_types = malloc((size_t)(edge_count > 0 ? edge_count : 1));
+    csr->traffic_factors = malloc((size_t)(edge_count > 0 ? edge_count : 1));
+    if (!csr->offsets || !csr->targets || !csr->weights ||
+        !csr->reverse_offsets || !csr->reverse_sources || !csr->reverse_weights ||
+        !csr->base_distances || !csr->speed_limits || !csr->road_types || !csr->traffic_factors) {
+        printf("Error: Could not allocate CSR adjacency for %d edges\n", edge_count);
+        free_csr(csr);
+        return -1;
+    }
+    
+    int position = 0;
+    for (int i = 0; i < graph->node_count; i++) {
+        csr->offsets[i] = position;
+        for (Edge* edge = graph->edge_lists[i]; edge != NULL; edge = edge->next) {
+            csr->targets[position] = edge->destination;
+            csr->weights[position] = edge->current_weight;
+            csr->base_distances[position] = edge->base_distance;
+            csr->speed_limits[position] = edge->speed_limit;
+            csr->road_types[position] = edge->road_type;
+            csr->traffic_factors[position] = edge->traffic_factor;
+            position++;
         }
     }
+    csr->offsets[graph->node_count] = position;
+    csr->edge_count = position;
+    
+    // Transpose by counting sort on destination; sources stay ascending
+    // within each node's incoming range
+    int* reverse_offsets = csr->reverse_offsets;
+    memset(reverse_offsets, 0, (size_t)(graph->node_count + 1) * sizeof(int));
+    for (int e = 0; e < position; e++) {
+        reverse_offsets[csr->targets[e] + 1]++;
+    }
+    for (int i = 0; i < graph->node_count; i++) {
+        reverse_offsets[i + 1] += reverse_offsets[i];
+    }
+    for (int u = 0; u < graph->node_count; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int slot = reverse_offsets[csr->targets[e]]++;
+            csr->reverse_sources[slot] = u;
+            csr->reverse_weights[slot] = csr->weights[e];
+        }
+    }
+    // The fill advanced each start to the next node's start; shift back
+    for (int i = graph->node_count; i > 0; i--) {
+        reverse_offsets[i] = reverse_offsets[i - 1];
+    }
+    reverse_offsets[0] = 0;
+    
+    update_graph_fingerprints(graph);
+    csr->is_frozen = 1;
+    return 0;
+}
+
+double* writable_csr_weights(Graph* graph) {
+    CSRGraph* csr = &graph->csr;
+    if (!csr->is_frozen) {
+        printf("Error: Graph must be frozen before reweighting\n");
+        return NULL;
+    }
+    if (graph->is_mapped && !graph->owns_weights) {
+        size_t size = (size_t)(csr->edge_count > 0 ? csr->edge_count : 1) * sizeof(double);
+        double* weights = malloc(size);
+        double* reverse_weights = malloc(size);
+        if (!weights || !reverse_weights) {
+            printf("Error: Could not allocate weights for %d edges\n", csr->edge_count);
+            free(weights);
+            free(reverse_weights);
+            return NULL;
+        }
+        memcpy(weights, csr->weights, (size_t)csr->edge_count * sizeof(double));
+        memcpy(reverse_weights, csr->reverse_weights, (size_t)csr->edge_count * sizeof(double));
+        csr->weights = weights;
+        csr->reverse_weights = reverse_weights;
+        graph->owns_weights = 1;
+    }
+    return csr->weights;
+}
+
+int sync_reverse_weights(Graph* graph) {
+    CSRGraph* csr = &graph->csr;
+    int* cursor = malloc((size_t)(graph->node_count + 1) * sizeof(int));
+    if (!cursor) {
+        printf("Error: Could not allocate reverse weight update\n");
+        return -1;
+    }
+    // Same fill order as freeze_graph's transpose
+    memcpy(cursor, csr->reverse_offsets, (size_t)(graph->node_count + 1) * sizeof(int));
+    for (int u = 0; u < graph->node_count; u++) {
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            csr->reverse_weights[cursor[csr->targets[e]]++] = csr->weights[e];
+        }
+    }
+    free(cursor);
+    update_graph_fingerprints(graph);
+    return 0;
+}
+
+// Copy of array whose element new_index[i] is element i, NULL if out of memory
+static void* permuted_copy(const Graph* graph, const void* array, size_t element_size,
+                           const int* new_index) {
+    unsigned char* permuted = malloc((size_t)graph->node_capacity * element_size);
+    if (!permuted) {
+        return NULL;
+    }
+    const unsigned char* source = array;
+    for (int i = 0; i < graph->node_count; i++) {
+        memcpy(permuted + (size_t)new_index[i] * element_size,
+               source + (size_t)i * element_size, element_size);
+    }
+    return permuted;
+}
+
+int apply_node_permutation(Graph* graph, const int* new_index) {
+    if (check_writable(graph) != 0) {
+        return -1;
+    }
+    
+    // Validate: every target index used exactly once
+    char* seen = calloc((size_t)(graph->node_count > 0 ? graph->node_count : 1), sizeof(char));
+    if (!seen) {
+        return -1;
+    }
+    for (int i = 0; i < graph->node_count; i++) {
+        if (new_index[i] < 0 || new_index[i] >= graph->node_count || seen[new_index[i]]) {
+            printf("Error: Node permutation is not a bijection\n");
+            free(seen);
+            return -1;
+        }
+        seen[new_index[i]] = 1;
+    }
+    free(seen);
+    
+    if (!graph->original_index) {
+        graph->original_index = malloc((size_t)graph->node_capacity * sizeof(int));
+        graph->current_index = malloc((size_t)graph->node_capacity * sizeof(int));
+        if (!graph->original_index || !graph->current_index) {
+            free(graph->original_index);
+            free(graph->current_index);
+            graph->original_index = NULL;
+            graph->current_index = NULL;
+            return -1;
+        }
+        for (int i = 0; i < graph->node_count; i++) {
+            graph->original_index[i] = i;
+            graph->current_index[i] = i;
+        }
+    }
+    
+    // Build every permuted array before replacing any, so running out of
+    // memory part way leaves the graph as it was
+    enum { PERMUTED_ARRAYS = 7 };
+    void** arrays[PERMUTED_ARRAYS] = {
+        (void**)&graph->nodes.latitude, (void**)&graph->nodes.longitude,
+        (void**)&graph->nodes.elevation, (void**)&graph->nodes.is_active,
+        (void**)&graph->locations, (void**)&graph->edge_lists, (void**)&graph->original_index
+    };
+    const size_t element_sizes[PERMUTED_ARRAYS] = {
+        sizeof(double), sizeof(double), sizeof(double), sizeof(unsigned char),
+        sizeof(Location), sizeof(Edge*), sizeof(int)
+    };
+    void* permuted[PERMUTED_ARRAYS];
+    int built = 0;
+    while (built < PERMUTED_ARRAYS &&
+           (permuted[built] = permuted_copy(graph, *arrays[built], element_sizes[built],
+                                            new_index)) != NULL) {
+        built++;
+    }
+    if (built < PERMUTED_ARRAYS) {
+        for (int a = 0; a < built; a++) {
+            free(permuted[a]);
+        }
+        printf("Error: Out of memory while renumbering nodes\n");
+        return -1;
+    }
+    for (int a = 0; a < PERMUTED_ARRAYS; a++) {
+        free(*arrays[a]);
+        *arrays[a] = permuted[a];
+    }
+    
+    for (int i = 0; i < graph->node_count; i++) {
+        graph->current_index[graph->original_index[i]] = i;
+        for (Edge* edge = graph->edge_lists[i]; edge != NULL; edge = edge->next) {
+            edge->destination = new_index[edge->destination];
+        }
+    }
+    
+    // Rebuild the name index so duplicate names resolve in the new order
+    memset(graph->name_slots, 0, (size_t)graph->name_slot_count * sizeof(int));
+    for (int i = 0; i < graph->node_count; i++) {
+        name_index_insert(graph, i);
+    }
+    graph->csr.is_frozen = 0;
+    return 0;
+}
+
+int original_node_index(const Graph* graph, int node) {
+    return graph->original_index ? graph->original_index[node] : node;
+}
+
+int current_node_index(const Graph* graph, int original) {
+    return graph->current_index ? graph->current_index[original] : original;
+}
+
+Location* get_location(Graph* graph, int id) {
+    if (id >= 0 && id < graph->node_count) {
+        return &graph->locations[id];
+    }
+    return NULL;
+}
+
+int find_location_by_name(const Graph* graph, const char* name) {
+    return name_index_lookup(graph, name, 0);
+}
+
+int find_location_by_name_nocase(const Graph* graph, const char* name) {
+    return name_index_lookup(graph, name, 1);
+}
+
+void print_graph_stats(const Graph* graph) {
+    printf("Graph Statistics:\n");
+    printf("  Total Nodes: %d\n", graph->node_count);
     printf("  Total Edges: %d (bidirectional counted once: %d)\n", 
-           total_edges, total_edges / 2);
+           graph->edge_count, graph->edge_count / 2);
+    if (graph->is_mapped) {
+        printf("  Mapped File: %.1f KB (read-only)\n", graph->mapping_size / 1024.0);
+    } else {
+        printf("  Edge Memory: %.1f KB in arena\n", graph->edge_arena.bytes_allocated / 1024.0);
+    }
 }
 
-void cleanup_graph(void) {
-    for (int i = 0; i < node_count; i++) {
-        Edge* edge = graph[i].edges;
-        while (edge != NULL) {
-            Edge* temp = edge;
-            edge = edge->next;
-            free(temp);
+void cleanup_graph(Graph* graph) {
+    arena_release(&graph->edge_arena);
+    free_string_table(&graph->road_types);
+    free_string_table(&graph->location_types);
+    free_string_table(&graph->districts);
+    if (graph->is_mapped) {
+        if (graph->owns_weights) {
+            free(graph->csr.weights);
+            free(graph->csr.reverse_weights);
         }
-        graph[i].edges = NULL;
+        unmap_graph_file(graph);
+        memset(graph, 0, sizeof(Graph));
+        return;
     }
-    node_count = 0;
+    free(graph->nodes.latitude);
+    free(graph->nodes.longitude);
+    free(graph->nodes.elevation);
+    free(graph->nodes.is_active);
+    free(graph->locations);
+    free(graph->edge_lists);
+    free(graph->name_slots);
+    free(graph->original_index);
+    free(graph->current_index);
+    free_csr(&graph->csr);
+    memset(graph, 0, sizeof(Graph));
 }
@@ -7,57 +7,176 @@
 #define GRAPH_H
 
 #include "gps_types.h"
+#include "arena.h"
+#include "string_table.h"
 
-// Global graph instance
-extern GraphNode graph[MAX_NODES];
-extern int node_count;
+// A road network. Every load, search and output function takes the graph
+// it works on, so one process can hold several networks. Once frozen
+// (freeze_graph), a graph is only read by searches and can be shared by
+// any number of threads.
+typedef struct {
+    NodeStore nodes;        // Hot coordinates and flags used by searches
+    Location* locations;    // Cold names, types and districts
+    Edge** edge_lists;      // Build-time adjacency lists (frozen into csr)
+    int node_count;
+    int node_capacity;
+    int edge_count;         // Directed edges (each road counts twice)
+    CSRGraph csr;           // Search-time adjacency, valid while csr.is_frozen
+
+    // Interned category names (Edge.road_type, Location.type, Location.district)
+    StringTable road_types;
+    StringTable location_types;
+    StringTable districts;
+
+    // Open-addressing index over distinct location names: slots hold node
+    // index + 1 (0 = empty) and are hashed on the case-folded name, so exact
+    // and case-insensitive lookups walk the same probe sequence
+    int* name_slots;
+    int name_slot_count;
+
+    // Insertion index <-> current index, allocated by the first renumbering
+    int* original_index;
+    int* current_index;
+
+    Arena edge_arena;       // All Edge records, released together
+
+    // Set by open_graph_file: node, CSR and name index arrays live in a
+    // read-only file mapping, there are no edge lists and only the weights
+    // can change (see writable_csr_weights)
+    int is_mapped;
+    void* mapping;
+    size_t mapping_size;
+    int owns_weights;       // Mapped graph reweighted into private weight arrays
+} Graph;
 
 /**
- * Initialize the graph
+ * Initialize an empty graph
+ * @return 0 on success, -1 if memory could not be allocated
  */
-void init_graph(void);
+int init_graph(Graph* graph);
+
+/**
+ * Make room for at least `capacity` locations without further reallocation.
+ * Loaders that know their size up front should call this so memory use is
+ * exactly proportional to the network instead of rounded up by doubling.
+ * @return 0 on success, -1 if memory could not be allocated
+ */
+int reserve_nodes(Graph* graph, int capacity);
 
 /**
  * Add a location to the graph (simple version)
+ * @return Index of the new node, or -1 if memory could not be allocated
  */
-void add_location(int id, const char* name, double lat, double lon);
+int add_location(Graph* graph, int id, const char* name, double lat, double lon);
 
 /**
  * Add an enhanced location with additional metadata
+ * @return Index of the new node, or -1 if memory could not be allocated
  */
-void add_enhanced_location(int id, const char* name, const char* type, 
-                          const char* district, double lat, double lon, 
+int add_enhanced_location(Graph* graph, int id, const char* name, const char* type,
+                          const char* district, double lat, double lon,
                           double elev, int traffic);
 
 /**
- * Add a bidirectional edge between two locations (simple version)
+ * Add a bidirectional edge between two locations (simple version).
+ * Self-loops are rejected; a road that already exists is left unchanged.
+ * @return 0 on success, -1 on invalid indices or allocation failure
+ */
+int add_edge(Graph* graph, int from, int to);
+
+/**
+ * Add an enhanced bidirectional edge with road information (self-loops
+ * rejected, existing roads left unchanged like add_edge)
+ * @return 0 on success, -1 on invalid indices or allocation failure
  */
-void add_edge(int from, int to);
+int add_enhanced_edge(Graph* graph, int from, int to, const char* road_type,
+                      int traffic_factor, double speed_limit);
 
 /**
- * Add an enhanced bidirectional edge with road information
+ * Add a one-way edge with road information (one-way streets, imports);
+ * self-loops rejected, existing edges left unchanged
+ * @return 0 on success, -1 on invalid indices or allocation failure
  */
-void add_enhanced_edge(int from, int to, const char* road_type, 
+int add_directed_edge(Graph* graph, int from, int to, const char* road_type,
                       int traffic_factor, double speed_limit);
 
 /**
- * Get location by ID
+ * Add many one-way edges at once for bulk loaders: the edges are sorted
+ * by source and destination with two counting sorts (linear in edges plus
+ * nodes, whatever the degrees) and written contiguously into one arena
+ * allocation, so freezing afterwards is a sequential scan. Self-loops and
+ * edges the graph already has are dropped; of parallel edges within the
+ * batch only the shortest is kept.
+ * @return Number of edges added, or -1 on invalid input or allocation failure
+ */
+int add_edges_bulk(Graph* graph, DirectedEdge* edges, int count);
+
+/**
+ * Build the CSR adjacency from the linked-list edges. Searches require a
+ * frozen graph; this only does work after the graph has been modified.
+ * Edge order within a node matches the order of its linked list.
+ * @return 0 on success, -1 if memory could not be allocated
+ */
+int freeze_graph(Graph* graph);
+
+/**
+ * Forward weights of a frozen graph, writable so they can be changed in
+ * place; a mapped graph gets private copies of its weight arrays the first
+ * time (the file is never written). Call sync_reverse_weights afterwards.
+ * @return csr.weights, NULL if the graph is not frozen or memory runs out
+ */
+double* writable_csr_weights(Graph* graph);
+
+/**
+ * Copy the frozen graph's forward weights into the reverse CSR and
+ * refresh the cached weight fingerprint
+ * @return 0 on success, -1 if memory could not be allocated
+ */
+int sync_reverse_weights(Graph* graph);
+
+/**
+ * Renumber nodes with an explicit permutation: node i becomes new_index[i].
+ * Rewrites every per-node array and edge destination and invalidates csr.
+ * Location.id values move with their nodes, so JSON output is unchanged.
+ * @return 0 on success, -1 on an invalid permutation or allocation failure
+ */
+int apply_node_permutation(Graph* graph, const int* new_index);
+
+/**
+ * Index a node had when it was added (identity until nodes are renumbered)
+ */
+int original_node_index(const Graph* graph, int node);
+
+/**
+ * Current index of the node that was added at position `original`
+ */
+int current_node_index(const Graph* graph, int original);
+
+/**
+ * Get location metadata by node index
+ */
+Location* get_location(Graph* graph, int id);
+
+/**
+ * Find location by exact name using the hashed name index
+ * @return Lowest node index with that name, or -1 if none
  */
-Location* get_location(int id);
+int find_location_by_name(const Graph* graph, const char* name);
 
 /**
- * Find location by name
+ * Find location by name, ignoring ASCII case
+ * @return Lowest node index with a matching name, or -1 if none
  */
-int find_location_by_name(const char* name);
+int find_location_by_name_nocase(const Graph* graph, const char* name);
 
 /**
  * Print graph statistics
  */
-void print_graph_stats(void);
+void print_graph_stats(const Graph* graph);
 
 /**
- * Clean up graph memory
+ * Clean up graph memory (or the file mapping of an opened graph file)
  */
-void cleanup_graph(void);
+void cleanup_graph(Graph* graph);
 
 #endif // GRAPH_H
@@ -0,0 +1,458 @@
+/**
+ * graph_file.c
+ * Memory-mapped binary graph file implementation
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "graph_file.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#define GRAPH_FILE_MAGIC "TMGRAPH"
+#define GRAPH_FILE_BYTE_ORDER 0x01020304u
+#define SECTION_ALIGNMENT 64        // Every section starts on a cache line
+
+// Sections in file order
+typedef enum {
+    SECTION_LATITUDE,
+    SECTION_LONGITUDE,
+    SECTION_ELEVATION,
+    SECTION_IS_ACTIVE,
+    SECTION_LOCATIONS,
+    SECTION_CSR_OFFSETS,
+    SECTION_CSR_TARGETS,
+    SECTION_CSR_WEIGHTS,
+    SECTION_REVERSE_OFFSETS,    // Transposed CSR for backward searches
+    SECTION_REVERSE_SOURCES,
+    SECTION_REVERSE_WEIGHTS,
+    SECTION_BASE_DISTANCES,     // Edge attributes in forward CSR order
+    SECTION_SPEED_LIMITS,
+    SECTION_ROAD_TYPES,
+    SECTION_TRAFFIC_FACTORS,
+    SECTION_NAME_SLOTS,
+    SECTION_ORIGINAL_INDEX,     // Empty unless the graph was renumbered
+    SECTION_CURRENT_INDEX,
+    SECTION_STRINGS,            // Road types, location types, districts, NUL-terminated
+    SECTION_COUNT
+} GraphSection;
+
+typedef struct {
+    uint64_t offset;
+    uint64_t size;
+} SectionEntry;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;        // GRAPH_FILE_BYTE_ORDER as written
+    uint32_t location_size;     // sizeof(Location) of the writing build
+    int32_t node_count;
+    int32_t edge_count;         // Directed CSR edges
+    int32_t name_slot_count;
+    int32_t road_type_count;
+    int32_t location_type_count;
+    int32_t district_count;
+    int32_t reserved;
+    uint64_t file_size;
+    uint64_t fingerprint;       // graph_fingerprint, so opening hashes nothing
+    uint64_t topology_fingerprint;
+    SectionEntry sections[SECTION_COUNT];
+    uint64_t payload_checksum;  // Over section contents in order, padding excluded
+    uint64_t header_checksum;   // Over this header with header_checksum = 0
+} GraphFileHeader;
+
+// FNV-1a over 64-bit words, then any tail bytes
+static uint64_t checksum_update(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = data;
+    size_t words = size / 8;
+    for (size_t i = 0; i < words; i++) {
+        uint64_t word;
+        memcpy(&word, bytes + i * 8, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (size_t i = words * 8; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+#define CHECKSUM_SEED 14695981039346656037ull
+
+static uint64_t header_checksum(const GraphFileHeader* header) {
+    GraphFileHeader copy = *header;
+    copy.header_checksum = 0;
+    return checksum_update(CHECKSUM_SEED, &copy, sizeof(copy));
+}
+
+uint64_t graph_topology_fingerprint(const Graph* graph) {
+    const CSRGraph* csr = &graph->csr;
+    uint64_t hash = checksum_update(CHECKSUM_SEED, &graph->node_count, sizeof(int));
+    hash = checksum_update(hash, csr->offsets, (size_t)(graph->node_count + 1) * sizeof(int));
+    return checksum_update(hash, csr->targets, (size_t)csr->edge_count * sizeof(int));
+}
+
+uint64_t graph_fingerprint(const Graph* graph) {
+    const CSRGraph* csr = &graph->csr;
+    return checksum_update(graph_topology_fingerprint(graph), csr->weights,
+                           (size_t)csr->edge_count * sizeof(double));
+}
+
+void update_graph_fingerprints(Graph* graph) {
+    CSRGraph* csr = &graph->csr;
+    csr->topology_fingerprint = graph_topology_fingerprint(graph);
+    csr->fingerprint = checksum_update(csr->topology_fingerprint, csr->weights,
+                                       (size_t)csr->edge_count * sizeof(double));
+}
+
+static uint64_t align_offset(uint64_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) & ~(uint64_t)(SECTION_ALIGNMENT - 1);
+}
+
+// Category tables back to back, each string NUL-terminated
+static char* pack_strings(const StringTable* tables[3], size_t* size) {
+    *size = 0;
+    for (int t = 0; t < 3; t++) {
+        for (int i = 0; i < tables[t]->count; i++) {
+            *size += strlen(tables[t]->strings[i]) + 1;
+        }
+    }
+    char* packed = malloc(*size > 0 ? *size : 1);
+    if (!packed) {
+        return NULL;
+    }
+    char* cursor = packed;
+    for (int t = 0; t < 3; t++) {
+        for (int i = 0; i < tables[t]->count; i++) {
+            size_t length = strlen(tables[t]->strings[i]) + 1;
+            memcpy(cursor, tables[t]->strings[i], length);
+            cursor += length;
+        }
+    }
+    return packed;
+}
+
+static int write_padding(FILE* file, uint64_t from, uint64_t to) {
+    static const char zeros[SECTION_ALIGNMENT];
+    if (to > from && fwrite(zeros, 1, (size_t)(to - from), file) != (size_t)(to - from)) {
+        return -1;
+    }
+    return 0;
+}
+
+int save_graph_file(Graph* graph, const char* filename) {
+    if (freeze_graph(graph) != 0) {
+        return -1;
+    }
+
+    const StringTable* tables[3] = { &graph->road_types, &graph->location_types, &graph->districts };
+    size_t strings_size;
+    char* strings = pack_strings(tables, &strings_size);
+    if (!strings) {
+        printf("Error: Out of memory while writing %s\n", filename);
+        return -1;
+    }
+
+    size_t nodes = (size_t)graph->node_count;
+    size_t edges = (size_t)graph->csr.edge_count;
+    size_t index_maps = graph->original_index ? nodes : 0;
+    const void* data[SECTION_COUNT] = {
+        graph->nodes.latitude, graph->nodes.longitude, graph->nodes.elevation,
+        graph->nodes.is_active, graph->locations,
+        graph->csr.offsets, graph->csr.targets, graph->csr.weights,
+        graph->csr.reverse_offsets, graph->csr.reverse_sources, graph->csr.reverse_weights,
+        graph->csr.base_distances, graph->csr.speed_limits,
+        graph->csr.road_types, graph->csr.traffic_factors,
+        graph->name_slots, graph->original_index, graph->current_index, strings
+    };
+
+    GraphFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC));
+    header.version = GRAPH_FILE_VERSION;
+    header.byte_order = GRAPH_FILE_BYTE_ORDER;
+    header.location_size = sizeof(Location);
+    header.node_count = graph->node_count;
+    header.edge_count = graph->csr.edge_count;
+    header.name_slot_count = graph->name_slot_count;
+    header.road_type_count = graph->road_types.count;
+    header.location_type_count = graph->location_types.count;
+    header.district_count = graph->districts.count;
+    header.fingerprint = graph->csr.fingerprint;
+    header.topology_fingerprint = graph->csr.topology_fingerprint;
+    header.sections[SECTION_LATITUDE].size = nodes * sizeof(double);
+    header.sections[SECTION_LONGITUDE].size = nodes * sizeof(double);
+    header.sections[SECTION_ELEVATION].size = nodes * sizeof(double);
+    header.sections[SECTION_IS_ACTIVE].size = nodes * sizeof(unsigned char);
+    header.sections[SECTION_LOCATIONS].size = nodes * sizeof(Location);
+    header.sections[SECTION_CSR_OFFSETS].size = (nodes + 1) * sizeof(int);
+    header.sections[SECTION_CSR_TARGETS].size = edges * sizeof(int);
+    header.sections[SECTION_CSR_WEIGHTS].size = edges * sizeof(double);
+    header.sections[SECTION_REVERSE_OFFSETS].size = (nodes + 1) * sizeof(int);
+    header.sections[SECTION_REVERSE_SOURCES].size = edges * sizeof(int);
+    header.sections[SECTION_REVERSE_WEIGHTS].size = edges * sizeof(double);
+    header.sections[SECTION_BASE_DISTANCES].size = edges * sizeof(double);
+    header.sections[SECTION_SPEED_LIMITS].size = edges * sizeof(float);
+    header.sections[SECTION_ROAD_TYPES].size = edges * sizeof(unsigned char);
+    header.sections[SECTION_TRAFFIC_FACTORS].size = edges * sizeof(unsigned char);
+    header.sections[SECTION_NAME_SLOTS].size = (size_t)graph->name_slot_count * sizeof(int);
+    header.sections[SECTION_ORIGINAL_INDEX].size = index_maps * sizeof(int);
+    header.sections[SECTION_CURRENT_INDEX].size = index_maps * sizeof(int);
+    header.sections[SECTION_STRINGS].size = strings_size;
+
+    uint64_t offset = align_offset(sizeof(header));
+    uint64_t checksum = CHECKSUM_SEED;
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        header.sections[s].offset = offset;
+        offset = align_offset(offset + header.sections[s].size);
+        checksum = checksum_update(checksum, data[s], (size_t)header.sections[s].size);
+    }
+    header.file_size = offset;
+    header.payload_checksum = checksum;
+    header.header_checksum = header_checksum(&header);
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Could not create %s\n", filename);
+        free(strings);
+        return -1;
+    }
+
+    int result = fwrite(&header, sizeof(header), 1, file) == 1 ? 0 : -1;
+    uint64_t position = sizeof(header);
+    for (int s = 0; s < SECTION_COUNT && result == 0; s++) {
+        const SectionEntry* section = &header.sections[s];
+        if (write_padding(file, position, section->offset) != 0 ||
+            (section->size > 0 &&
+             fwrite(data[s], 1, (size_t)section->size, file) != (size_t)section->size)) {
+            result = -1;
+        }
+        position = section->offset + section->size;
+    }
+    if (result == 0 && write_padding(file, position, header.file_size) != 0) {
+        result = -1;
+    }
+    if (fclose(file) != 0) {
+        result = -1;
+    }
+    free(strings);
+
+    if (result != 0) {
+        printf("Error: Could not write %s\n", filename);
+        remove(filename);
+    }
+    return result;
+}
+
+// Map the whole file read-only; the fallback without mmap reads it instead
+void* map_file(const char* filename, size_t* size) {
+#ifndef _WIN32
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        return NULL;
+    }
+    struct stat info;
+    void* base = NULL;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        *size = (size_t)info.st_size;
+        base = mmap(NULL, *size, PROT_READ, MAP_SHARED, fd, 0);
+        if (base == MAP_FAILED) {
+            base = NULL;
+        }
+    }
+    close(fd);
+    return base;
+#else
+    FILE* file = fopen(filename, "rb");
+    if (!file) {
+        return NULL;
+    }
+    void* base = NULL;
+    long length;
+    if (fseek(file, 0, SEEK_END) == 0 && (length = ftell(file)) > 0 &&
+        fseek(file, 0, SEEK_SET) == 0 && (base = malloc((size_t)length)) != NULL) {
+        *size = (size_t)length;
+        if (fread(base, 1, *size, file) != *size) {
+            free(base);
+            base = NULL;
+        }
+    }
+    fclose(file);
+    return base;
+#endif
+}
+
+void unmap_file(void* base, size_t size) {
+#ifndef _WIN32
+    munmap(base, size);
+#else
+    (void)size;
+    free(base);
+#endif
+}
+
+static int check_header(const GraphFileHeader* header, size_t file_size) {
+    if (memcmp(header->magic, GRAPH_FILE_MAGIC, sizeof(GRAPH_FILE_MAGIC)) != 0 ||
+        header->header_checksum != header_checksum(header)) {
+        return -1;
+    }
+    if (header->version != GRAPH_FILE_VERSION || header->byte_order != GRAPH_FILE_BYTE_ORDER ||
+        header->location_size != sizeof(Location) || header->file_size != file_size) {
+        return -1;
+    }
+    if (header->node_count < 0 || header->edge_count < 0 || header->name_slot_count < 0 ||
+        (header->name_slot_count & (header->name_slot_count - 1)) != 0 ||
+        header->road_type_count < ROAD_TYPE_BUILTIN_COUNT ||
+        header->location_type_count < 1 || header->district_count < 1) {
+        return -1;
+    }
+
+    uint64_t nodes = (uint64_t)header->node_count;
+    uint64_t edges = (uint64_t)header->edge_count;
+    uint64_t expected[SECTION_COUNT] = {
+        nodes * sizeof(double), nodes * sizeof(double), nodes * sizeof(double),
+        nodes * sizeof(unsigned char), nodes * sizeof(Location),
+        (nodes + 1) * sizeof(int), edges * sizeof(int), edges * sizeof(double),
+        (nodes + 1) * sizeof(int), edges * sizeof(int), edges * sizeof(double),
+        edges * sizeof(double), edges * sizeof(float),
+        edges * sizeof(unsigned char), edges * sizeof(unsigned char),
+        (uint64_t)header->name_slot_count * sizeof(int),
+        header->sections[SECTION_ORIGINAL_INDEX].size,
+        header->sections[SECTION_ORIGINAL_INDEX].size,
+        header->sections[SECTION_STRINGS].size
+    };
+    if (expected[SECTION_ORIGINAL_INDEX] != 0 &&
+        expected[SECTION_ORIGINAL_INDEX] != nodes * sizeof(int)) {
+        return -1;
+    }
+    for (int s = 0; s < SECTION_COUNT; s++) {
+        const SectionEntry* section = &header->sections[s];
+        if (section->size != expected[s] || section->offset % SECTION_ALIGNMENT != 0 ||
+            section->offset < sizeof(GraphFileHeader) || section->offset > file_size ||
+            section->size > file_size - section->offset) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Rebuild the category tables from the strings section, keeping their IDs
+static int load_strings(Graph* graph, const GraphFileHeader* header, const char* strings) {
+    StringTable* tables[3] = { &graph->road_types, &graph->location_types, &graph->districts };
+    int counts[3] = { header->road_type_count, header->location_type_count, header->district_count };
+    const char* end = strings + header->sections[SECTION_STRINGS].size;
+
+    for (int t = 0; t < 3; t++) {
+        for (int i = 0; i < counts[t]; i++) {
+            const char* terminator = memchr(strings, '\0', (size_t)(end - strings));
+            if (!terminator || intern_string(tables[t], strings) != i) {
+                return -1;
+            }
+            strings = terminator + 1;
+        }
+    }
+    return 0;
+}
+
+int open_graph_file(Graph* graph, const char* filename, int verify_checksum) {
+    size_t size = 0;
+    unsigned char* base = map_file(filename, &size);
+    if (!base) {
+        printf("Error: Could not open graph file %s\n", filename);
+        return -1;
+    }
+
+    const GraphFileHeader* header = (const GraphFileHeader*)base;
+    if (size < sizeof(GraphFileHeader) || check_header(header, size) != 0) {
+        printf("Error: %s is not a compatible graph file (version %d)\n",
+               filename, GRAPH_FILE_VERSION);
+        unmap_file(base, size);
+        return -1;
+    }
+
+    if (verify_checksum) {
+        uint64_t checksum = CHECKSUM_SEED;
+        for (int s = 0; s < SECTION_COUNT; s++) {
+            checksum = checksum_update(checksum, base + header->sections[s].offset,
+                                       (size_t)header->sections[s].size);
+        }
+        if (checksum != header->payload_checksum) {
+            printf("Error: Graph file %s is corrupt (checksum mismatch)\n", filename);
+            unmap_file(base, size);
+            return -1;
+        }
+    }
+
+    const SectionEntry* sections = header->sections;
+    const int* offsets = (const int*)(base + sections[SECTION_CSR_OFFSETS].offset);
+    const int* reverse_offsets = (const int*)(base + sections[SECTION_REVERSE_OFFSETS].offset);
+    if (offsets[0] != 0 || offsets[header->node_count] != header->edge_count ||
+        reverse_offsets[0] != 0 || reverse_offsets[header->node_count] != header->edge_count) {
+        printf("Error: Graph file %s has an inconsistent edge table\n", filename);
+        unmap_file(base, size);
+        return -1;
+    }
+
+    memset(graph, 0, sizeof(Graph));
+    arena_init(&graph->edge_arena);
+    init_string_table(&graph->road_types);
+    init_string_table(&graph->location_types);
+    init_string_table(&graph->districts);
+    graph->is_mapped = 1;
+    graph->mapping = base;
+    graph->mapping_size = size;
+    if (load_strings(graph, header, (const char*)(base + sections[SECTION_STRINGS].offset)) != 0) {
+        printf("Error: Graph file %s has an invalid string table\n", filename);
+        cleanup_graph(graph);
+        return -1;
+    }
+
+    // The mapping is read-only: mutators refuse mapped graphs
+    graph->nodes.latitude = (double*)(base + sections[SECTION_LATITUDE].offset);
+    graph->nodes.longitude = (double*)(base + sections[SECTION_LONGITUDE].offset);
+    graph->nodes.elevation = (double*)(base + sections[SECTION_ELEVATION].offset);
+    graph->nodes.is_active = base + sections[SECTION_IS_ACTIVE].offset;
+    graph->locations = (Location*)(base + sections[SECTION_LOCATIONS].offset);
+    graph->node_count = header->node_count;
+    graph->node_capacity = header->node_count;
+    graph->edge_count = header->edge_count;
+    graph->csr.offsets = (int*)(base + sections[SECTION_CSR_OFFSETS].offset);
+    graph->csr.targets = (int*)(base + sections[SECTION_CSR_TARGETS].offset);
+    graph->csr.weights = (double*)(base + sections[SECTION_CSR_WEIGHTS].offset);
+    graph->csr.reverse_offsets = (int*)(base + sections[SECTION_REVERSE_OFFSETS].offset);
+    graph->csr.reverse_sources = (int*)(base + sections[SECTION_REVERSE_SOURCES].offset);
+    graph->csr.reverse_weights = (double*)(base + sections[SECTION_REVERSE_WEIGHTS].offset);
+    graph->csr.base_distances = (double*)(base + sections[SECTION_BASE_DISTANCES].offset);
+    graph->csr.speed_limits = (float*)(base + sections[SECTION_SPEED_LIMITS].offset);
+    graph->csr.road_types = base + sections[SECTION_ROAD_TYPES].offset;
+    graph->csr.traffic_factors = base + sections[SECTION_TRAFFIC_FACTORS].offset;
+    graph->csr.edge_count = header->edge_count;
+    graph->csr.is_frozen = 1;
+    graph->csr.fingerprint = header->fingerprint;
+    graph->csr.topology_fingerprint = header->topology_fingerprint;
+    graph->name_slots = (int*)(base + sections[SECTION_NAME_SLOTS].offset);
+    graph->name_slot_count = header->name_slot_count;
+    if (sections[SECTION_ORIGINAL_INDEX].size > 0) {
+        graph->original_index = (int*)(base + sections[SECTION_ORIGINAL_INDEX].offset);
+        graph->current_index = (int*)(base + sections[SECTION_CURRENT_INDEX].offset);
+    }
+    return 0;
+}
+
+void unmap_graph_file(Graph* graph) {
+    if (graph->is_mapped) {
+        unmap_file(graph->mapping, graph->mapping_size);
+        graph->mapping = NULL;
+        graph->mapping_size = 0;
+        graph->is_mapped = 0;
+    }
+}
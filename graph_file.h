@@ -0,0 +1,78 @@
+/**
+ * graph_file.h
+ * Memory-mapped binary graph files for fast startup
+ */
+
+#ifndef GRAPH_FILE_H
+#define GRAPH_FILE_H
+
+#include "graph.h"
+
+#define GRAPH_FILE_VERSION 3
+
+/**
+ * Write a frozen snapshot of the graph: node coordinates, location
+ * metadata, forward and reverse CSR adjacency with precomputed edge
+ * weights, each edge's distance, speed limit, road type and traffic
+ * factor, the name index, the category string tables and the graph's
+ * fingerprints. Freezes the graph first if needed.
+ * Files are tied to the byte order and struct layout of the writing build.
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+int save_graph_file(Graph* graph, const char* filename);
+
+/**
+ * Open a file written by save_graph_file as a frozen, read-only graph.
+ * Node, location, CSR and name index arrays point straight into a shared
+ * read-only mapping, so nothing is parsed or copied and processes mapping
+ * the same file share its pages; only the small category string tables
+ * are rebuilt. Adding locations or edges and renumbering are refused on
+ * a mapped graph; traffic reweighting works on private copies of the
+ * weights. Release it with cleanup_graph.
+ * @param verify_checksum Nonzero to checksum the whole payload, which reads
+ *        every page up front; the header is always checked
+ * @return 0 on success, -1 if the file is missing, corrupt or was written
+ *         by an incompatible version or build
+ */
+int open_graph_file(Graph* graph, const char* filename, int verify_checksum);
+
+/**
+ * Checksum of the frozen graph's node count and CSR adjacency with its
+ * weights; files derived from a graph (contraction hierarchies) record it
+ * so they are not reused after the roads or their weights change
+ */
+uint64_t graph_fingerprint(const Graph* graph);
+
+/**
+ * The same checksum without the weights: unchanged by traffic
+ * reweighting, for structures that only depend on which roads exist
+ */
+uint64_t graph_topology_fingerprint(const Graph* graph);
+
+/**
+ * Recompute both fingerprints into csr.fingerprint and
+ * csr.topology_fingerprint (called by freeze_graph and
+ * sync_reverse_weights); per-query checks read those fields
+ */
+void update_graph_fingerprints(Graph* graph);
+
+/**
+ * Map a whole file read-only (read into memory where mmap is missing),
+ * for other files derived from a graph that are opened in place
+ * @param size Set to the file size
+ * @return Base address, NULL if the file is missing or empty
+ */
+void* map_file(const char* filename, size_t* size);
+
+/**
+ * Release a region returned by map_file
+ */
+void unmap_file(void* base, size_t size);
+
+/**
+ * Release the mapping behind a graph opened with open_graph_file
+ * (called by cleanup_graph)
+ */
+void unmap_graph_file(Graph* graph);
+
+#endif // GRAPH_FILE_H
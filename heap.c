@@ -1,43 +1,113 @@
 /**
  * heap.c
- * Min-heap implementation for priority queue
+ * Indexed d-ary min-heap implementation for priority queue
  */
 
+#include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include "heap.h"
 #include "gps_types.h"
 
-static void swap_nodes(PQNode* a, PQNode* b) {
-    PQNode temp = *a;
-    *a = *b;
-    *b = temp;
+#define CACHE_LINE 64
+
+// Float keys decide; the exact keys only break float ties, so the order
+// is the same as comparing the doubles
+static inline int entry_less(const MinHeap* heap, HeapEntry a, HeapEntry b) {
+    return a.key < b.key ||
+           (a.key == b.key && heap->distance[a.vertex] < heap->distance[b.vertex]);
 }
 
+// Move the entry at index up to its place, shifting parents down into the hole
 static void heapify_up(MinHeap* heap, int index) {
-    if (index && heap->nodes[index].distance < heap->nodes[(index-1)/2].distance) {
-        swap_nodes(&heap->nodes[index], &heap->nodes[(index-1)/2]);
-        heapify_up(heap, (index-1)/2);
+    HeapEntry entry = heap->entries[index];
+    while (index > 0) {
+        int parent = (index - 1) >> heap->arity_shift;
+        if (!entry_less(heap, entry, heap->entries[parent])) {
+            break;
+        }
+        heap->entries[index] = heap->entries[parent];
+        heap->position[heap->entries[index].vertex] = index;
+        index = parent;
     }
+    heap->entries[index] = entry;
+    heap->position[entry.vertex] = index;
 }
 
+// Move the entry at index down to its place, shifting the smallest child up
 static void heapify_down(MinHeap* heap, int index) {
-    int smallest = index;
-    int left = 2*index + 1;
-    int right = 2*index + 2;
-    
-    if (left < heap->size && heap->nodes[left].distance < heap->nodes[smallest].distance)
-        smallest = left;
-    
-    if (right < heap->size && heap->nodes[right].distance < heap->nodes[smallest].distance)
-        smallest = right;
-    
-    if (smallest != index) {
-        swap_nodes(&heap->nodes[index], &heap->nodes[smallest]);
-        heapify_down(heap, smallest);
+    HeapEntry entry = heap->entries[index];
+    int arity = 1 << heap->arity_shift;
+    for (;;) {
+        int first = (index << heap->arity_shift) + 1;
+        if (first >= heap->size) {
+            break;
+        }
+        int last = first + arity < heap->size ? first + arity : heap->size;
+        int smallest = first;
+        for (int child = first + 1; child < last; child++) {
+            if (entry_less(heap, heap->entries[child], heap->entries[smallest])) {
+                smallest = child;
+            }
+        }
+        if (!entry_less(heap, heap->entries[smallest], entry)) {
+            break;
+        }
+        heap->entries[index] = heap->entries[smallest];
+        heap->position[heap->entries[index].vertex] = index;
+        index = smallest;
+    }
+    heap->entries[index] = entry;
+    heap->position[entry.vertex] = index;
+}
+
+int init_heap(MinHeap* heap, int vertex_count) {
+    return init_heap_arity(heap, vertex_count, HEAP_ARITY);
+}
+
+int init_heap_arity(MinHeap* heap, int vertex_count, int arity) {
+    memset(heap, 0, sizeof(MinHeap));
+    int shift = 1;
+    while ((1 << shift) < arity && shift < 4) {
+        shift++;
+    }
+    if ((1 << shift) != arity) {
+        return -1;
+    }
+    heap->arity_shift = shift;
+    if (vertex_count < 1) {
+        vertex_count = 1;
     }
+
+    // Offset entries by arity - 1 slots from a cache-line boundary: the
+    // children of node i then start at byte (i + 1) * arity * 8 of the line
+    heap->storage = malloc((size_t)(vertex_count + arity - 1) * sizeof(HeapEntry) + CACHE_LINE);
+    heap->distance = malloc((size_t)vertex_count * sizeof(double));
+    heap->position = malloc((size_t)vertex_count * sizeof(int));
+    if (!heap->storage || !heap->distance || !heap->position) {
+        free_heap(heap);
+        return -1;
+    }
+    uintptr_t aligned = ((uintptr_t)heap->storage + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+    heap->entries = (HeapEntry*)aligned + (arity - 1);
+    for (int i = 0; i < vertex_count; i++) {
+        heap->position[i] = -1;
+    }
+    heap->capacity = vertex_count;
+    return 0;
+}
+
+void free_heap(MinHeap* heap) {
+    free(heap->storage);
+    free(heap->distance);
+    free(heap->position);
+    memset(heap, 0, sizeof(MinHeap));
 }
 
-void init_heap(MinHeap* heap) {
+void clear_heap(MinHeap* heap) {
+    for (int i = 0; i < heap->size; i++) {
+        heap->position[heap->entries[i].vertex] = -1;
+    }
     heap->size = 0;
 }
 
@@ -45,41 +115,51 @@ int is_empty(MinHeap* heap) {
     return heap->size == 0;
 }
 
-void insert_heap(MinHeap* heap, int vertex, double distance) {
-    heap->nodes[heap->size].vertex = vertex;
-    heap->nodes[heap->size].distance = distance;
-    heap->nodes[heap->size].f_cost = distance;
-    heapify_up(heap, heap->size);
-    heap->size++;
+int in_heap(const MinHeap* heap, int vertex) {
+    return vertex >= 0 && vertex < heap->capacity && heap->position[vertex] >= 0;
 }
 
-void insert_heap_astar(MinHeap* heap, int vertex, double g_cost, double h_cost, int parent) {
-    heap->nodes[heap->size].vertex = vertex;
-    heap->nodes[heap->size].g_cost = g_cost;
-    heap->nodes[heap->size].h_cost = h_cost;
-    heap->nodes[heap->size].f_cost = g_cost + h_cost;
-    heap->nodes[heap->size].distance = g_cost + h_cost; // For comparison
-    heap->nodes[heap->size].parent = parent;
-    heapify_up(heap, heap->size);
-    heap->size++;
+double peek_min_key(const MinHeap* heap) {
+    return heap->size > 0 ? heap->distance[heap->entries[0].vertex] : INF;
+}
+
+int insert_heap(MinHeap* heap, int vertex, double distance) {
+    if (vertex < 0 || vertex >= heap->capacity) {
+        return -1;
+    }
+    if (heap->position[vertex] >= 0) {
+        decrease_key(heap, vertex, distance);
+        return 0;
+    }
+    heap->entries[heap->size].key = (float)distance;
+    heap->entries[heap->size].vertex = vertex;
+    heap->distance[vertex] = distance;
+    heap->pushes++;
+    heapify_up(heap, heap->size++);
+    return 0;
 }
 
 PQNode extract_min(MinHeap* heap) {
-    PQNode min_node = heap->nodes[0];
-    heap->nodes[0] = heap->nodes[heap->size-1];
+    PQNode min_node;
+    min_node.vertex = heap->entries[0].vertex;
+    min_node.distance = heap->distance[min_node.vertex];
+    heap->position[min_node.vertex] = -1;
+    heap->pops++;
     heap->size--;
-    heapify_down(heap, 0);
+    if (heap->size > 0) {
+        heap->entries[0] = heap->entries[heap->size];
+        heapify_down(heap, 0);
+    }
     return min_node;
 }
 
 void decrease_key(MinHeap* heap, int vertex, double new_distance) {
-    // Find the vertex in heap
-    for (int i = 0; i < heap->size; i++) {
-        if (heap->nodes[i].vertex == vertex) {
-            heap->nodes[i].distance = new_distance;
-            heap->nodes[i].f_cost = new_distance;
-            heapify_up(heap, i);
-            break;
-        }
+    if (!in_heap(heap, vertex) || !(new_distance < heap->distance[vertex])) {
+        return;
     }
+    int index = heap->position[vertex];
+    heap->entries[index].key = (float)new_distance;
+    heap->distance[vertex] = new_distance;
+    heap->decreases++;
+    heapify_up(heap, index);
 }
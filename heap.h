@@ -1,6 +1,6 @@
 /**
  * heap.h
- * Min-heap implementation for priority queue in pathfinding algorithms
+ * Indexed d-ary min-heap for priority queue in pathfinding algorithms
  */
 
 #ifndef HEAP_H
@@ -9,9 +9,31 @@
 #include "gps_types.h"
 
 /**
- * Initialize an empty min-heap
+ * Initialize an empty indexed min-heap for vertices 0..vertex_count-1
+ * with the default fan-out (HEAP_ARITY). A vertex is queued at most once,
+ * so the heap never holds more than vertex_count entries and never grows.
+ * @return 0 on success, -1 if memory could not be allocated
  */
-void init_heap(MinHeap* heap);
+int init_heap(MinHeap* heap, int vertex_count);
+
+/**
+ * Initialize an empty indexed min-heap with a given fan-out
+ * @param arity Children per node: 2, 4, 8 or 16 (4 and 8 keep all
+ *              children of a node on one 64-byte cache line)
+ * @return 0 on success, -1 for an unsupported arity or if memory could not
+ *         be allocated
+ */
+int init_heap_arity(MinHeap* heap, int vertex_count, int arity);
+
+/**
+ * Release the memory held by a heap
+ */
+void free_heap(MinHeap* heap);
+
+/**
+ * Remove all entries, leaving the heap ready for the next search
+ */
+void clear_heap(MinHeap* heap);
 
 /**
  * Check if heap is empty
@@ -19,14 +41,22 @@ void init_heap(MinHeap* heap);
 int is_empty(MinHeap* heap);
 
 /**
- * Insert a node into the heap (for Dijkstra)
+ * Check if a vertex is currently queued
+ */
+int in_heap(const MinHeap* heap, int vertex);
+
+/**
+ * Exact key of the minimum element without removing it, INF if empty
  */
-void insert_heap(MinHeap* heap, int vertex, double distance);
+double peek_min_key(const MinHeap* heap);
 
 /**
- * Insert a node into the heap (for A*)
+ * Insert a vertex with a key (distance for Dijkstra, g + h for A*). If
+ * the vertex is already queued its key is lowered instead (kept if the
+ * new one is not smaller).
+ * @return 0 on success, -1 if the vertex is out of range
  */
-void insert_heap_astar(MinHeap* heap, int vertex, double g_cost, double h_cost, int parent);
+int insert_heap(MinHeap* heap, int vertex, double distance);
 
 /**
  * Extract the minimum element from the heap
@@ -34,7 +64,8 @@ void insert_heap_astar(MinHeap* heap, int vertex, double g_cost, double h_cost,
 PQNode extract_min(MinHeap* heap);
 
 /**
- * Update the distance of an existing node (decrease key operation)
+ * Lower the distance of a queued vertex in O(log n); vertices that are
+ * not queued, or keys that would increase, are ignored
  */
 void decrease_key(MinHeap* heap, int vertex, double new_distance);
 
@@ -0,0 +1,493 @@
+/**
+ * hub_labels.c
+ * Hub label construction, label files and label intersection queries
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "hub_labels.h"
+#include "graph_file.h"
+#include "pathfinding.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define HUB_LABEL_FILE_MAGIC "TMHUBS"
+#define HUB_LABEL_FILE_BYTE_ORDER 0x01020304u
+#define LABEL_ALIGNMENT 64          // Every array starts on a cache line
+
+// Label of one node while building, before packing
+typedef struct {
+    int count;
+    int32_t* hubs;
+    double* distances;
+} Label;
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;            // HUB_LABEL_FILE_BYTE_ORDER as written
+    int32_t node_count;
+    int32_t reserved;
+    uint64_t fingerprint;           // graph_fingerprint of the source graph
+    uint64_t entry_counts[2];       // Forward, backward
+    uint64_t file_size;
+} HubLabelFileHeader;
+
+// Arrays in file order: offsets, hubs, distances of each direction
+#define LABEL_SECTION_COUNT 6
+
+static uint64_t align_offset(uint64_t offset) {
+    return (offset + LABEL_ALIGNMENT - 1) & ~(uint64_t)(LABEL_ALIGNMENT - 1);
+}
+
+// Offset of each array after the header; returns the file size
+static uint64_t label_layout(int node_count, const uint64_t entry_counts[2],
+                             uint64_t offsets[LABEL_SECTION_COUNT]) {
+    uint64_t cursor = align_offset(sizeof(HubLabelFileHeader));
+    for (int side = 0; side < 2; side++) {
+        uint64_t sizes[3] = {
+            ((uint64_t)node_count + 1) * sizeof(uint64_t),
+            entry_counts[side] * sizeof(int32_t),
+            entry_counts[side] * sizeof(double)
+        };
+        for (int k = 0; k < 3; k++) {
+            offsets[side * 3 + k] = cursor;
+            cursor = align_offset(cursor + sizes[k]);
+        }
+    }
+    return cursor;
+}
+
+// Smallest da[i] + db[j] over a[i] == b[j] in two ascending hub lists
+static double intersect_scalar(const int32_t* a, const double* da, size_t na,
+                               const int32_t* b, const double* db, size_t nb) {
+    double best = INF;
+    size_t i = 0, j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            if (da[i] + db[j] < best) {
+                best = da[i] + db[j];
+            }
+            i++;
+            j++;
+        }
+    }
+    return best;
+}
+
+// The same with SSE2: four hubs of a against all four rotations of four
+// hubs of b per step, advancing the block with the smaller last hub.
+// The four compare masks fold into one word, visited one set bit (one
+// shared hub) at a time, so steps without a match do not branch.
+static double intersect_labels(const int32_t* a, const double* da, size_t na,
+                               const int32_t* b, const double* db, size_t nb) {
+#ifdef __SSE2__
+    double best = INF;
+    size_t i = 0, j = 0;
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i*)(b + j));
+        // Bit 4r + k: a[i + k] == b[j + (k + r) % 4]
+        int matches = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(va, vb))) |
+            _mm_movemask_ps(_mm_castsi128_ps(
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))))) << 4 |
+            _mm_movemask_ps(_mm_castsi128_ps(
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))))) << 8 |
+            _mm_movemask_ps(_mm_castsi128_ps(
+                _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))))) << 12;
+        while (matches) {
+            int bit = __builtin_ctz((unsigned int)matches);
+            int k = bit & 3, r = bit >> 2;
+            double d = da[i + k] + db[j + ((k + r) & 3)];
+            if (d < best) {
+                best = d;
+            }
+            matches &= matches - 1;
+        }
+        int32_t a_last = a[i + 3], b_last = b[j + 3];
+        if (a_last <= b_last) i += 4;
+        if (b_last <= a_last) j += 4;
+    }
+    double rest = intersect_scalar(a + i, da + i, na - i, b + j, db + j, nb - j);
+    return rest < best ? rest : best;
+#else
+    return intersect_scalar(a, da, na, b, db, nb);
+#endif
+}
+
+static int compare_hubs(const void* a, const void* b) {
+    int32_t ha = *(const int32_t*)a, hb = *(const int32_t*)b;
+    return (ha > hb) - (ha < hb);
+}
+
+// Label of v from the finished labels of its higher-ranked neighbours
+// (up edges for forward labels, down edges for backward ones), then
+// pruned: a hub goes if v's candidates and the hub's opposite label
+// already give a shorter distance, which also drops inexact entries
+static int build_label(const ContractionHierarchy* ch, const int* by_rank, int v, int forward,
+                       Label* labels, const Label* opposite, double* best, int32_t* touched,
+                       unsigned char* keep) {
+    const HierarchyEdges* edges = forward ? &ch->up : &ch->down;
+    int own = ch->rank[v];
+    int count = 0;
+    best[own] = 0.0;
+    touched[count++] = own;
+    for (int e = edges->offsets[v]; e < edges->offsets[v + 1]; e++) {
+        const Label* neighbour = &labels[edges->neighbours[e]];
+        double weight = edges->weights[e];
+        for (int k = 0; k < neighbour->count; k++) {
+            int32_t hub = neighbour->hubs[k];
+            double d = neighbour->distances[k] + weight;
+            if (best[hub] >= INF) {
+                touched[count++] = hub;
+                best[hub] = d;
+            } else if (d < best[hub]) {
+                best[hub] = d;
+            }
+        }
+    }
+    qsort(touched, (size_t)count, sizeof(int32_t), compare_hubs);
+
+    int32_t* hubs = malloc((size_t)count * sizeof(int32_t));
+    double* distances = malloc((size_t)count * sizeof(double));
+    if (!hubs || !distances) {
+        free(hubs);
+        free(distances);
+        return -1;
+    }
+    for (int k = 0; k < count; k++) {
+        hubs[k] = touched[k];
+        distances[k] = best[touched[k]];
+        best[touched[k]] = INF;
+    }
+
+    int kept = 0;
+    for (int k = 0; k < count; k++) {
+        keep[k] = 1;
+        if (hubs[k] != own) {
+            const Label* other = &opposite[by_rank[hubs[k]]];
+            double via = forward ?
+                intersect_labels(hubs, distances, (size_t)count, other->hubs, other->distances, (size_t)other->count) :
+                intersect_labels(other->hubs, other->distances, (size_t)other->count, hubs, distances, (size_t)count);
+            keep[k] = via >= distances[k];
+        }
+    }
+    for (int k = 0; k < count; k++) {
+        if (keep[k]) {
+            hubs[kept] = hubs[k];
+            distances[kept] = distances[k];
+            kept++;
+        }
+    }
+    labels[v].count = kept;
+    labels[v].hubs = hubs;
+    labels[v].distances = distances;
+    return 0;
+}
+
+// Copy per-node labels into one CSR array set and free them
+static int pack_labels(Label* labels, int n, HubLabelArrays* arrays) {
+    uint64_t total = 0;
+    for (int v = 0; v < n; v++) {
+        total += (uint64_t)labels[v].count;
+    }
+    arrays->offsets = malloc(((size_t)n + 1) * sizeof(uint64_t));
+    arrays->hubs = malloc((size_t)(total > 0 ? total : 1) * sizeof(int32_t));
+    arrays->distances = malloc((size_t)(total > 0 ? total : 1) * sizeof(double));
+    if (!arrays->offsets || !arrays->hubs || !arrays->distances) {
+        return -1;
+    }
+    uint64_t cursor = 0;
+    for (int v = 0; v < n; v++) {
+        arrays->offsets[v] = cursor;
+        memcpy(arrays->hubs + cursor, labels[v].hubs, (size_t)labels[v].count * sizeof(int32_t));
+        memcpy(arrays->distances + cursor, labels[v].distances, (size_t)labels[v].count * sizeof(double));
+        cursor += (uint64_t)labels[v].count;
+        free(labels[v].hubs);
+        free(labels[v].distances);
+        labels[v].hubs = NULL;
+        labels[v].distances = NULL;
+    }
+    arrays->offsets[n] = cursor;
+    return 0;
+}
+
+void free_hub_labels(HubLabels* labels) {
+    if (labels->mapping) {
+        unmap_file(labels->mapping, labels->mapping_size);
+    } else {
+        HubLabelArrays* sides[2] = { &labels->forward, &labels->backward };
+        for (int side = 0; side < 2; side++) {
+            free(sides[side]->offsets);
+            free(sides[side]->hubs);
+            free(sides[side]->distances);
+        }
+    }
+    memset(labels, 0, sizeof(HubLabels));
+}
+
+int build_hub_labels(const ContractionHierarchy* ch, HubLabels* labels) {
+    memset(labels, 0, sizeof(HubLabels));
+    int n = ch->node_count;
+    clock_t start_time = clock();
+
+    Label* forward = calloc((size_t)(n > 0 ? n : 1), sizeof(Label));
+    Label* backward = calloc((size_t)(n > 0 ? n : 1), sizeof(Label));
+    int* by_rank = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    double* best = malloc((size_t)(n > 0 ? n : 1) * sizeof(double));
+    int32_t* touched = malloc((size_t)(n > 0 ? n : 1) * sizeof(int32_t));
+    unsigned char* keep = malloc((size_t)(n > 0 ? n : 1));
+    int result = forward && backward && by_rank && best && touched && keep ? 0 : -1;
+
+    if (result == 0) {
+        for (int v = 0; v < n; v++) {
+            by_rank[ch->rank[v]] = v;
+            best[v] = INF;
+        }
+        // Most important first: a label only uses labels of higher ranks
+        for (int r = n - 1; r >= 0 && result == 0; r--) {
+            int v = by_rank[r];
+            result = build_label(ch, by_rank, v, 1, forward, backward, best, touched, keep);
+            if (result == 0) {
+                result = build_label(ch, by_rank, v, 0, backward, forward, best, touched, keep);
+            }
+        }
+    }
+    if (result == 0) {
+        labels->node_count = n;
+        labels->fingerprint = ch->fingerprint;
+        result = pack_labels(forward, n, &labels->forward) == 0 &&
+                 pack_labels(backward, n, &labels->backward) == 0 ? 0 : -1;
+    }
+
+    for (int v = 0; forward && backward && v < n; v++) {
+        free(forward[v].hubs);
+        free(forward[v].distances);
+        free(backward[v].hubs);
+        free(backward[v].distances);
+    }
+    free(forward);
+    free(backward);
+    free(by_rank);
+    free(best);
+    free(touched);
+    free(keep);
+    if (result != 0) {
+        printf("❌ Out of memory: could not build hub labels\n");
+        free_hub_labels(labels);
+        return -1;
+    }
+
+    uint64_t entries = labels->forward.offsets[n] + labels->backward.offsets[n];
+    printf("✅ Hub labels: %.1f forward and %.1f backward hubs per node, %.1f MB (%.2fs)\n",
+           n > 0 ? (double)labels->forward.offsets[n] / n : 0.0,
+           n > 0 ? (double)labels->backward.offsets[n] / n : 0.0,
+           entries * (sizeof(int32_t) + sizeof(double)) / (1024.0 * 1024.0),
+           ((double)(clock() - start_time)) / CLOCKS_PER_SEC);
+    return 0;
+}
+
+// Write size bytes, then zeros up to the next LABEL_ALIGNMENT boundary
+static int write_aligned(FILE* file, const void* data, uint64_t size) {
+    static const unsigned char padding[LABEL_ALIGNMENT] = { 0 };
+    uint64_t pad = align_offset(size) - size;
+    return (size == 0 || fwrite(data, 1, (size_t)size, file) == size) &&
+           (pad == 0 || fwrite(padding, 1, (size_t)pad, file) == pad) ? 0 : -1;
+}
+
+int save_hub_labels(const HubLabels* labels, const char* filename) {
+    HubLabelFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, HUB_LABEL_FILE_MAGIC, sizeof(HUB_LABEL_FILE_MAGIC));
+    header.version = HUB_LABEL_FILE_VERSION;
+    header.byte_order = HUB_LABEL_FILE_BYTE_ORDER;
+    header.node_count = labels->node_count;
+    header.fingerprint = labels->fingerprint;
+    header.entry_counts[0] = labels->forward.offsets[labels->node_count];
+    header.entry_counts[1] = labels->backward.offsets[labels->node_count];
+    uint64_t offsets[LABEL_SECTION_COUNT];
+    header.file_size = label_layout(labels->node_count, header.entry_counts, offsets);
+
+    FILE* file = fopen(filename, "wb");
+    if (!file) {
+        printf("Error: Could not create %s\n", filename);
+        return -1;
+    }
+    const HubLabelArrays* sides[2] = { &labels->forward, &labels->backward };
+    int result = write_aligned(file, &header, sizeof(header));
+    for (int side = 0; side < 2 && result == 0; side++) {
+        uint64_t entries = header.entry_counts[side];
+        if (write_aligned(file, sides[side]->offsets, ((uint64_t)labels->node_count + 1) * sizeof(uint64_t)) != 0 ||
+            write_aligned(file, sides[side]->hubs, entries * sizeof(int32_t)) != 0 ||
+            write_aligned(file, sides[side]->distances, entries * sizeof(double)) != 0) {
+            result = -1;
+        }
+    }
+    if (fclose(file) != 0) {
+        result = -1;
+    }
+    if (result != 0) {
+        printf("Error: Could not write %s\n", filename);
+        remove(filename);
+    }
+    return result;
+}
+
+// Offsets must start at 0, never decrease and end at the entry count
+static int check_offsets(const uint64_t* offsets, int node_count, uint64_t entries) {
+    if (offsets[0] != 0 || offsets[node_count] != entries) {
+        return -1;
+    }
+    for (int v = 0; v < node_count; v++) {
+        if (offsets[v + 1] < offsets[v]) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int load_hub_labels(HubLabels* labels, const Graph* graph, const char* filename) {
+    memset(labels, 0, sizeof(HubLabels));
+    size_t size = 0;
+    unsigned char* base = map_file(filename, &size);
+    if (!base) {
+        return -1;
+    }
+
+    HubLabelFileHeader header;
+    uint64_t offsets[LABEL_SECTION_COUNT];
+    int compatible = size >= sizeof(header);
+    if (compatible) {
+        memcpy(&header, base, sizeof(header));
+        compatible = memcmp(header.magic, HUB_LABEL_FILE_MAGIC, sizeof(HUB_LABEL_FILE_MAGIC)) == 0 &&
+                     header.version == HUB_LABEL_FILE_VERSION &&
+                     header.byte_order == HUB_LABEL_FILE_BYTE_ORDER && header.node_count >= 0 &&
+                     header.file_size == size &&
+                     label_layout(header.node_count, header.entry_counts, offsets) == size;
+    }
+    if (!compatible) {
+        printf("Error: %s is not a compatible hub label file (version %d)\n",
+               filename, HUB_LABEL_FILE_VERSION);
+        unmap_file(base, size);
+        return -1;
+    }
+    if (header.node_count != graph->node_count || !graph->csr.is_frozen ||
+        header.fingerprint != graph_fingerprint(graph)) {
+        printf("Error: %s was built for a different graph or weights\n", filename);
+        unmap_file(base, size);
+        return -1;
+    }
+
+    HubLabelArrays* sides[2] = { &labels->forward, &labels->backward };
+    for (int side = 0; side < 2; side++) {
+        sides[side]->offsets = (uint64_t*)(base + offsets[side * 3]);
+        sides[side]->hubs = (int32_t*)(base + offsets[side * 3 + 1]);
+        sides[side]->distances = (double*)(base + offsets[side * 3 + 2]);
+        if (check_offsets(sides[side]->offsets, header.node_count, header.entry_counts[side]) != 0) {
+            printf("Error: %s is corrupt\n", filename);
+            unmap_file(base, size);
+            memset(labels, 0, sizeof(HubLabels));
+            return -1;
+        }
+    }
+    labels->node_count = header.node_count;
+    labels->fingerprint = header.fingerprint;
+    labels->mapping = base;
+    labels->mapping_size = size;
+    return 0;
+}
+
+double hub_label_distance(const HubLabels* labels, int start, int end) {
+    const HubLabelArrays* f = &labels->forward;
+    const HubLabelArrays* b = &labels->backward;
+    uint64_t fs = f->offsets[start], bs = b->offsets[end];
+    return intersect_labels(f->hubs + fs, f->distances + fs, (size_t)(f->offsets[start + 1] - fs),
+                            b->hubs + bs, b->distances + bs, (size_t)(b->offsets[end + 1] - bs));
+}
+
+double hub_label_distance_scalar(const HubLabels* labels, int start, int end) {
+    const HubLabelArrays* f = &labels->forward;
+    const HubLabelArrays* b = &labels->backward;
+    uint64_t fs = f->offsets[start], bs = b->offsets[end];
+    return intersect_scalar(f->hubs + fs, f->distances + fs, (size_t)(f->offsets[start + 1] - fs),
+                            b->hubs + bs, b->distances + bs, (size_t)(b->offsets[end + 1] - bs));
+}
+
+int hub_label_path(const Graph* graph, const HubLabels* labels, int start, int end, int path[]) {
+    if (hub_label_distance(labels, start, end) >= INF) {
+        return 0;
+    }
+    char* visited = calloc((size_t)graph->node_count, sizeof(char));
+    if (!visited) {
+        return 0;
+    }
+
+    // Each step takes the road that keeps road + remaining distance
+    // smallest. Ties on zero-weight roads could lead back to a vertex
+    // already on the path, so only unvisited vertices are candidates and
+    // a dead end steps back; the path stays simple and fits in node_count
+    const CSRGraph* csr = &graph->csr;
+    int length = 0;
+    path[length++] = start;
+    visited[start] = 1;
+    while (length > 0 && path[length - 1] != end) {
+        int u = path[length - 1];
+        int next = -1;
+        double next_cost = INF;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int x = csr->targets[e];
+            if (visited[x]) {
+                continue;
+            }
+            double cost = csr->weights[e] + hub_label_distance(labels, x, end);
+            if (cost < next_cost) {
+                next_cost = cost;
+                next = x;
+            }
+        }
+        if (next < 0) {
+            length--;
+            continue;
+        }
+        visited[next] = 1;
+        path[length++] = next;
+    }
+
+    free(visited);
+    return length;
+}
+
+int hub_label_pathfind(const Graph* graph, const HubLabels* labels, int start, int end,
+                       int path[], double* total_cost) {
+    if (!graph->csr.is_frozen || labels->node_count != graph->node_count) {
+        printf("❌ Hub labels were built for a different graph\n");
+        return 0;
+    }
+    clock_t start_time = clock();
+    printf("Starting hub label lookup: node %d → node %d\n", start, end);
+
+    int path_length = 0;
+    double cost = hub_label_distance(labels, start, end);
+    if (cost < INF) {
+        path_length = hub_label_path(graph, labels, start, end, path);
+        *total_cost = cost;
+
+        double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        printf("✅ Hub label lookup completed! Distance: %.2f km\n", *total_cost);
+        printf("   Labels merged: %llu + %llu hubs, Time: %.4fs\n",
+               (unsigned long long)(labels->forward.offsets[start + 1] - labels->forward.offsets[start]),
+               (unsigned long long)(labels->backward.offsets[end + 1] - labels->backward.offsets[end]),
+               calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+    return path_length;
+}
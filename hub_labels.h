@@ -0,0 +1,72 @@
+/**
+ * hub_labels.h
+ * Hub labeling distance oracle: exact distances from two sorted labels
+ */
+
+#ifndef HUB_LABELS_H
+#define HUB_LABELS_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define HUB_LABEL_FILE_VERSION 1
+
+/**
+ * Derive labels from a contraction hierarchy, most important node first:
+ * each label merges the labels of its upward neighbours, then drops hubs
+ * whose distance the labels already beat.
+ * @return 0 on success, -1 if memory runs out
+ */
+int build_hub_labels(const ContractionHierarchy* ch, HubLabels* labels);
+
+/**
+ * Release labels, unmapping them if they were opened from a file
+ */
+void free_hub_labels(HubLabels* labels);
+
+/**
+ * Write labels with the fingerprint of the graph they were built for,
+ * every array on a cache line boundary so the file can be mapped in place
+ * @return 0 on success, -1 on I/O failure
+ */
+int save_hub_labels(const HubLabels* labels, const char* filename);
+
+/**
+ * Map a file written by save_hub_labels read-only, refusing files built
+ * for a different graph or weights (see graph_fingerprint)
+ * @return 0 on success, -1 if the file is missing, corrupt or stale
+ */
+int load_hub_labels(HubLabels* labels, const Graph* graph, const char* filename);
+
+/**
+ * Distance from start to end: the smallest forward + backward distance
+ * over the hubs the two labels share, found with an SSE2 block
+ * intersection where available
+ * @return Distance in km, INF if there is no path
+ */
+double hub_label_distance(const HubLabels* labels, int start, int end);
+
+/**
+ * hub_label_distance with a plain merge, for tests and benchmarks
+ */
+double hub_label_distance_scalar(const HubLabels* labels, int start, int end);
+
+/**
+ * Shortest path from start to end, walking each road whose weight plus
+ * the remaining label distance is smallest and never revisiting a vertex.
+ * Written as reconstruct_path writes it (start first, end last).
+ * @param path Array to store the path vertices (node_count entries)
+ * @return Number of vertices, 0 if there is no path
+ */
+int hub_label_path(const Graph* graph, const HubLabels* labels, int start, int end, int path[]);
+
+/**
+ * Look up the distance, retrieve the path and print the query statistics
+ * @param path Array to store the path vertices (node_count entries)
+ * @param total_cost Pointer to store total path cost
+ * @return Length of the path (number of vertices)
+ */
+int hub_label_pathfind(const Graph* graph, const HubLabels* labels, int start, int end,
+                       int path[], double* total_cost);
+
+#endif // HUB_LABELS_H
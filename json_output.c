@@ -4,14 +4,15 @@
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
 #include "json_output.h"
 #include "graph.h"
 #include "pathfinding.h"
 
-void generate_json_output(int start, int end, double distances[], int previous[], 
-                         const char* filename) {
+void generate_json_output(const Graph* graph, int start, int end, double distances[],
+                          int previous[], const char* filename) {
     FILE* file = fopen(filename, "w");
     if (!file) {
         printf("Error: Could not create %s\n", filename);
@@ -19,7 +20,12 @@ void generate_json_output(int start, int end, double distances[], int previous[]
     }
     
     // Reconstruct path
-    int path[MAX_NODES];
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!path) {
+        printf("Error: Out of memory while writing %s\n", filename);
+        fclose(file);
+        return;
+    }
     int path_length = reconstruct_path(end, previous, path);
     
     // Get current timestamp
@@ -33,18 +39,18 @@ void generate_json_output(int start, int end, double distances[], int previous[]
     
     // Start location
     fprintf(file, "    \"start\": {\n");
-    fprintf(file, "      \"id\": %d,\n", graph[start].location.id);
-    fprintf(file, "      \"name\": \"%s\",\n", graph[start].location.name);
-    fprintf(file, "      \"latitude\": %.6f,\n", graph[start].location.latitude);
-    fprintf(file, "      \"longitude\": %.6f\n", graph[start].location.longitude);
+    fprintf(file, "      \"id\": %d,\n", graph->locations[start].id);
+    fprintf(file, "      \"name\": \"%s\",\n", graph->locations[start].name);
+    fprintf(file, "      \"latitude\": %.6f,\n", graph->nodes.latitude[start]);
+    fprintf(file, "      \"longitude\": %.6f\n", graph->nodes.longitude[start]);
     fprintf(file, "    },\n");
     
     // End location
     fprintf(file, "    \"end\": {\n");
-    fprintf(file, "      \"id\": %d,\n", graph[end].location.id);
-    fprintf(file, "      \"name\": \"%s\",\n", graph[end].location.name);
-    fprintf(file, "      \"latitude\": %.6f,\n", graph[end].location.latitude);
-    fprintf(file, "      \"longitude\": %.6f\n", graph[end].location.longitude);
+    fprintf(file, "      \"id\": %d,\n", graph->locations[end].id);
+    fprintf(file, "      \"name\": \"%s\",\n", graph->locations[end].name);
+    fprintf(file, "      \"latitude\": %.6f,\n", graph->nodes.latitude[end]);
+    fprintf(file, "      \"longitude\": %.6f\n", graph->nodes.longitude[end]);
     fprintf(file, "    },\n");
     
     fprintf(file, "    \"total_distance\": %.2f,\n", distances[end]);
@@ -54,10 +60,10 @@ void generate_json_output(int start, int end, double distances[], int previous[]
     for (int i = 0; i < path_length; i++) {
         int node_id = path[i];
         fprintf(file, "      {\n");
-        fprintf(file, "        \"id\": %d,\n", graph[node_id].location.id);
-        fprintf(file, "        \"name\": \"%s\",\n", graph[node_id].location.name);
-        fprintf(file, "        \"latitude\": %.6f,\n", graph[node_id].location.latitude);
-        fprintf(file, "        \"longitude\": %.6f\n", graph[node_id].location.longitude);
+        fprintf(file, "        \"id\": %d,\n", graph->locations[node_id].id);
+        fprintf(file, "        \"name\": \"%s\",\n", graph->locations[node_id].name);
+        fprintf(file, "        \"latitude\": %.6f,\n", graph->nodes.latitude[node_id]);
+        fprintf(file, "        \"longitude\": %.6f\n", graph->nodes.longitude[node_id]);
         if (i < path_length - 1) fprintf(file, "      },\n");
         else fprintf(file, "      }\n");
     }
@@ -69,12 +75,16 @@ void generate_json_output(int start, int end, double distances[], int previous[]
     fprintf(file, "  \"timestamp\": \"%s\"\n", timestamp);
     fprintf(file, "}\n");
     
+    free(path);
     fclose(file);
     printf("💾 JSON output saved to %s\n", filename);
 }
 
-void generate_enhanced_json(int start, int end, int path[], int path_length, 
-                           double total_cost, const char* filename) {
+void generate_enhanced_json(const Graph* graph, int start, int end, int path[],
+                            int path_length, double total_cost, double travel_minutes,
+                            const char* algorithm,
+                            const AlternativeRoute alternatives[], int alternative_count,
+                            const char* filename) {
     FILE* file = fopen(filename, "w");
     if (!file) {
         printf("Error: Could not create %s\n", filename);
@@ -86,33 +96,37 @@ void generate_enhanced_json(int start, int end, int path[], int path_length,
     char timestamp[64];
     strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", utc_time);
     
-    // Calculate estimated travel time
+    // Calculate estimated travel time unless the search already knows it
     double avg_speed = 45.0; // km/h average
     double estimated_minutes = (total_cost / avg_speed) * 60;
+    if (travel_minutes >= 0.0) {
+        estimated_minutes = travel_minutes;
+        avg_speed = travel_minutes > 0.0 ? total_cost / (travel_minutes / 60.0) : 0.0;
+    }
     
     fprintf(file, "{\n");
     fprintf(file, "  \"route\": {\n");
     
     // Start location
     fprintf(file, "    \"start\": {\n");
-    fprintf(file, "      \"id\": %d,\n", graph[start].location.id);
-    fprintf(file, "      \"name\": \"%s\",\n", graph[start].location.name);
-    fprintf(file, "      \"type\": \"%s\",\n", graph[start].location.type);
-    fprintf(file, "      \"district\": \"%s\",\n", graph[start].location.district);
-    fprintf(file, "      \"latitude\": %.6f,\n", graph[start].location.latitude);
-    fprintf(file, "      \"longitude\": %.6f,\n", graph[start].location.longitude);
-    fprintf(file, "      \"elevation\": %.1f\n", graph[start].location.elevation);
+    fprintf(file, "      \"id\": %d,\n", graph->locations[start].id);
+    fprintf(file, "      \"name\": \"%s\",\n", graph->locations[start].name);
+    fprintf(file, "      \"type\": \"%s\",\n", interned_string(&graph->location_types, graph->locations[start].type));
+    fprintf(file, "      \"district\": \"%s\",\n", interned_string(&graph->districts, graph->locations[start].district));
+    fprintf(file, "      \"latitude\": %.6f,\n", graph->nodes.latitude[start]);
+    fprintf(file, "      \"longitude\": %.6f,\n", graph->nodes.longitude[start]);
+    fprintf(file, "      \"elevation\": %.1f\n", graph->nodes.elevation[start]);
     fprintf(file, "    },\n");
     
     // End location
     fprintf(file, "    \"end\": {\n");
-    fprintf(file, "      \"id\": %d,\n", graph[end].location.id);
-    fprintf(file, "      \"name\": \"%s\",\n", graph[end].location.name);
-    fprintf(file, "      \"type\": \"%s\",\n", graph[end].location.type);
-    fprintf(file, "      \"district\": \"%s\",\n", graph[end].location.district);
-    fprintf(file, "      \"latitude\": %.6f,\n", graph[end].location.latitude);
-    fprintf(file, "      \"longitude\": %.6f,\n", graph[end].location.longitude);
-    fprintf(file, "      \"elevation\": %.1f\n", graph[end].location.elevation);
+    fprintf(file, "      \"id\": %d,\n", graph->locations[end].id);
+    fprintf(file, "      \"name\": \"%s\",\n", graph->locations[end].name);
+    fprintf(file, "      \"type\": \"%s\",\n", interned_string(&graph->location_types, graph->locations[end].type));
+    fprintf(file, "      \"district\": \"%s\",\n", interned_string(&graph->districts, graph->locations[end].district));
+    fprintf(file, "      \"latitude\": %.6f,\n", graph->nodes.latitude[end]);
+    fprintf(file, "      \"longitude\": %.6f,\n", graph->nodes.longitude[end]);
+    fprintf(file, "      \"elevation\": %.1f\n", graph->nodes.elevation[end]);
     fprintf(file, "    },\n");
     
     // Route statistics
@@ -121,7 +135,7 @@ void generate_enhanced_json(int start, int end, int path[], int path_length,
     fprintf(file, "      \"estimated_time_minutes\": %.1f,\n", estimated_minutes);
     fprintf(file, "      \"waypoint_count\": %d,\n", path_length);
     fprintf(file, "      \"average_speed_kmh\": %.1f,\n", avg_speed);
-    fprintf(file, "      \"algorithm_used\": \"A*\"\n");
+    fprintf(file, "      \"algorithm_used\": \"%s\"\n", algorithm);
     fprintf(file, "    },\n");
     
     // Path details
@@ -129,26 +143,57 @@ void generate_enhanced_json(int start, int end, int path[], int path_length,
     for (int i = 0; i < path_length; i++) {
         int node_id = path[i];
         fprintf(file, "      {\n");
-        fprintf(file, "        \"id\": %d,\n", graph[node_id].location.id);
-        fprintf(file, "        \"name\": \"%s\",\n", graph[node_id].location.name);
-        fprintf(file, "        \"type\": \"%s\",\n", graph[node_id].location.type);
-        fprintf(file, "        \"district\": \"%s\",\n", graph[node_id].location.district);
-        fprintf(file, "        \"latitude\": %.6f,\n", graph[node_id].location.latitude);
-        fprintf(file, "        \"longitude\": %.6f,\n", graph[node_id].location.longitude);
-        fprintf(file, "        \"elevation\": %.1f,\n", graph[node_id].location.elevation);
-        fprintf(file, "        \"traffic_level\": %d,\n", graph[node_id].location.traffic_level);
+        fprintf(file, "        \"id\": %d,\n", graph->locations[node_id].id);
+        fprintf(file, "        \"name\": \"%s\",\n", graph->locations[node_id].name);
+        fprintf(file, "        \"type\": \"%s\",\n", interned_string(&graph->location_types, graph->locations[node_id].type));
+        fprintf(file, "        \"district\": \"%s\",\n", interned_string(&graph->districts, graph->locations[node_id].district));
+        fprintf(file, "        \"latitude\": %.6f,\n", graph->nodes.latitude[node_id]);
+        fprintf(file, "        \"longitude\": %.6f,\n", graph->nodes.longitude[node_id]);
+        fprintf(file, "        \"elevation\": %.1f,\n", graph->nodes.elevation[node_id]);
+        fprintf(file, "        \"traffic_level\": %d,\n", graph->locations[node_id].traffic_level);
         fprintf(file, "        \"step\": %d\n", i + 1);
         if (i < path_length - 1) fprintf(file, "      },\n");
         else fprintf(file, "      }\n");
     }
-    fprintf(file, "    ]\n");
+    fprintf(file, "    ]%s\n", alternative_count > 0 ? "," : "");
+    
+    // Alternative routes, each with its own waypoints
+    if (alternative_count > 0) {
+        fprintf(file, "    \"alternatives\": [\n");
+        for (int r = 0; r < alternative_count; r++) {
+            const AlternativeRoute* route = &alternatives[r];
+            fprintf(file, "      {\n");
+            fprintf(file, "        \"total_distance\": %.2f,\n", route->distance);
+            fprintf(file, "        \"estimated_time_minutes\": %.1f,\n", (route->distance / 45.0) * 60);
+            fprintf(file, "        \"extra_distance_percent\": %.1f,\n",
+                    total_cost > 0.0 ? (route->distance / total_cost - 1.0) * 100.0 : 0.0);
+            fprintf(file, "        \"shared_distance\": %.2f,\n", route->shared);
+            fprintf(file, "        \"waypoint_count\": %d,\n", route->length);
+            fprintf(file, "        \"path\": [\n");
+            for (int i = 0; i < route->length; i++) {
+                int node_id = route->path[i];
+                fprintf(file, "          {\n");
+                fprintf(file, "            \"id\": %d,\n", graph->locations[node_id].id);
+                fprintf(file, "            \"name\": \"%s\",\n", graph->locations[node_id].name);
+                fprintf(file, "            \"latitude\": %.6f,\n", graph->nodes.latitude[node_id]);
+                fprintf(file, "            \"longitude\": %.6f,\n", graph->nodes.longitude[node_id]);
+                fprintf(file, "            \"step\": %d\n", i + 1);
+                if (i < route->length - 1) fprintf(file, "          },\n");
+                else fprintf(file, "          }\n");
+            }
+            fprintf(file, "        ]\n");
+            if (r < alternative_count - 1) fprintf(file, "      },\n");
+            else fprintf(file, "      }\n");
+        }
+        fprintf(file, "    ]\n");
+    }
     fprintf(file, "  },\n");
     
     // API metadata
     fprintf(file, "  \"metadata\": {\n");
     fprintf(file, "    \"status\": \"success\",\n");
     fprintf(file, "    \"version\": \"2.0\",\n");
-    fprintf(file, "    \"algorithm\": \"A*\",\n");
+    fprintf(file, "    \"algorithm\": \"%s\",\n", algorithm);
     fprintf(file, "    \"timestamp\": \"%s\"\n", timestamp);
     fprintf(file, "  }\n");
     fprintf(file, "}\n");
@@ -157,17 +202,18 @@ void generate_enhanced_json(int start, int end, int path[], int path_length,
     printf("💾 Enhanced JSON saved to %s\n", filename);
 }
 
-void print_route_console(int path[], int path_length, double total_distance) {
+void print_route_console(const Graph* graph, int path[], int path_length,
+                         double total_distance, double travel_minutes) {
     printf("\n🗺️  Route Details:\n");
     printf("════════════════\n");
     
     for (int i = 0; i < path_length; i++) {
         int node_id = path[i];
-        printf("  %d. %s", i + 1, graph[node_id].location.name);
+        printf("  %d. %s", i + 1, graph->locations[node_id].name);
         
-        if (strlen(graph[node_id].location.type) > 0 && 
-            strcmp(graph[node_id].location.type, "general") != 0) {
-            printf(" (%s)", graph[node_id].location.type);
+        const char* type = interned_string(&graph->location_types, graph->locations[node_id].type);
+        if (graph->locations[node_id].type != LOCATION_TYPE_GENERAL && type[0] != '\0') {
+            printf(" (%s)", type);
         }
         
         if (i < path_length - 1) {
@@ -178,6 +224,10 @@ void print_route_console(int path[], int path_length, double total_distance) {
     }
     
     printf("\n📏 Total Distance: %.2f km\n", total_distance);
-    printf("⏱️  Estimated Time: %.1f minutes (at 45 km/h avg)\n", 
-           (total_distance / 45.0) * 60);
+    if (travel_minutes >= 0.0) {
+        printf("⏱️  Travel Time: %.1f minutes (time-dependent)\n", travel_minutes);
+    } else {
+        printf("⏱️  Estimated Time: %.1f minutes (at 45 km/h avg)\n", 
+               (total_distance / 45.0) * 60);
+    }
 }
@@ -6,21 +6,34 @@
 #ifndef JSON_OUTPUT_H
 #define JSON_OUTPUT_H
 
+#include "graph.h"
+
 /**
  * Generate basic JSON output for route (Dijkstra version)
  */
-void generate_json_output(int start, int end, double distances[], int previous[], 
-                         const char* filename);
+void generate_json_output(const Graph* graph, int start, int end, double distances[],
+                          int previous[], const char* filename);
 
 /**
- * Generate enhanced JSON output with full statistics (A* version)
+ * Generate enhanced JSON output with full statistics for a path
+ * @param algorithm Name recorded in the output ("A*", "Bidirectional Dijkstra")
+ * @param alternatives Other routes to list under "alternatives" (see
+ *                     find_alternatives), or NULL
+ * @param alternative_count Entries in alternatives; the list is left out when 0
+ * @param travel_minutes Travel time computed by the search (time-dependent
+ *                       routing), or negative to estimate it at 45 km/h
  */
-void generate_enhanced_json(int start, int end, int path[], int path_length, 
-                           double total_cost, const char* filename);
+void generate_enhanced_json(const Graph* graph, int start, int end, int path[],
+                            int path_length, double total_cost, double travel_minutes,
+                            const char* algorithm,
+                            const AlternativeRoute alternatives[], int alternative_count,
+                            const char* filename);
 
 /**
  * Print route to console in readable format
+ * @param travel_minutes As for generate_enhanced_json
  */
-void print_route_console(int path[], int path_length, double total_distance);
+void print_route_console(const Graph* graph, int path[], int path_length,
+                         double total_distance, double travel_minutes);
 
 #endif // JSON_OUTPUT_H
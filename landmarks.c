@@ -0,0 +1,351 @@
+/**
+ * landmarks.c
+ * Landmark selection, distance tables and the ALT heuristic
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>
+#include <time.h>
+#include "landmarks.h"
+#include "pathfinding.h"
+#include "search_workspace.h"
+
+// Settled node and its distance from the avoid root
+typedef struct {
+    double distance;
+    int node;
+} TreeNode;
+
+// Largest float not above d, so stored distances never grow
+static float round_down(double d) {
+    if (d >= INF) {
+        return (float)INF;
+    }
+    float f = (float)d;
+    return (double)f > d ? nextafterf(f, 0.0f) : f;
+}
+
+// Lower bound on d(u, t) from landmark l. Each stored value may sit up to
+// one float step below the true one, so subtracted terms are padded by
+// FLT_EPSILON to keep the bound from overestimating.
+static double landmark_bound(const LandmarkSet* set, int l, int u, int t) {
+    double to_u = set->to_landmark[(size_t)u * set->count + l];
+    double to_t = set->to_landmark[(size_t)t * set->count + l];
+    double from_u = set->from_landmark[(size_t)u * set->count + l];
+    double from_t = set->from_landmark[(size_t)t * set->count + l];
+    double bound = 0.0;
+    if (to_t < INF && to_u - to_t * (1.0 + FLT_EPSILON) > bound) {
+        bound = to_u - to_t * (1.0 + FLT_EPSILON);
+    }
+    if (from_u < INF && from_t - from_u * (1.0 + FLT_EPSILON) > bound) {
+        bound = from_t - from_u * (1.0 + FLT_EPSILON);
+    }
+    return bound;
+}
+
+// Copy the last search's distances into column l of a node-major table
+static void store_column(const SearchWorkspace* workspace, float* table, int count, int l, int n) {
+    for (int v = 0; v < n; v++) {
+        table[(size_t)v * count + l] = round_down(workspace_distance(workspace, v));
+    }
+}
+
+// Node farthest (out and back) from the nearest chosen landmark; nodes a
+// landmark cannot reach or be reached from count as farthest of all
+static int pick_farthest(const Graph* graph, const LandmarkSet* set, int chosen,
+                         SearchWorkspace* workspace) {
+    int n = graph->node_count;
+    int best = 0;
+    double best_score = -1.0;
+    if (chosen == 0) {
+        // No landmarks yet: the node farthest from node 0
+        dijkstra_search(graph, workspace, 0, -1);
+        for (int v = 0; v < n; v++) {
+            double d = workspace_distance(workspace, v);
+            if (d < INF && d > best_score) {
+                best_score = d;
+                best = v;
+            }
+        }
+        return best;
+    }
+    for (int v = 0; v < n; v++) {
+        double score = INF * 2.0;
+        for (int l = 0; l < chosen; l++) {
+            double round_trip = (double)set->to_landmark[(size_t)v * set->count + l] +
+                                set->from_landmark[(size_t)v * set->count + l];
+            if (round_trip < score) {
+                score = round_trip;
+            }
+        }
+        if (score > best_score) {
+            best_score = score;
+            best = v;
+        }
+    }
+    return best;
+}
+
+static int compare_tree_nodes(const void* a, const void* b) {
+    double da = ((const TreeNode*)a)->distance, db = ((const TreeNode*)b)->distance;
+    return da < db ? 1 : (da > db ? -1 : 0);
+}
+
+// Goldberg and Werneck's avoid: grow a shortest path tree from a root,
+// weigh each node by how far the current landmarks underestimate its
+// distance from the root, and descend into the heaviest subtree that has
+// no landmark yet down to a leaf. -1 if every subtree has one.
+static int pick_avoid(const Graph* graph, const LandmarkSet* set, int chosen,
+                      SearchWorkspace* workspace, int root) {
+    int n = graph->node_count;
+    TreeNode* order = malloc((size_t)n * sizeof(TreeNode));
+    double* size = malloc((size_t)n * sizeof(double));
+    unsigned char* covered = calloc((size_t)n, 1);
+    int* child_offsets = calloc((size_t)n + 1, sizeof(int));
+    int* children = malloc((size_t)n * sizeof(int));
+    int result = -1;
+    if (!order || !size || !covered || !child_offsets || !children) {
+        goto done;
+    }
+
+    dijkstra_search(graph, workspace, root, -1);
+    int reached = 0;
+    for (int v = 0; v < n; v++) {
+        double d = workspace_distance(workspace, v);
+        if (d >= INF) {
+            continue;
+        }
+        double bound = 0.0;
+        for (int l = 0; l < chosen; l++) {
+            double b = landmark_bound(set, l, root, v);
+            if (b > bound) {
+                bound = b;
+            }
+        }
+        size[v] = d - bound;
+        order[reached].distance = d;
+        order[reached].node = v;
+        reached++;
+        int parent = workspace_previous(workspace, v);
+        if (parent >= 0) {
+            child_offsets[parent + 1]++;
+        }
+    }
+    for (int l = 0; l < chosen; l++) {
+        covered[set->nodes[l]] = 1;
+    }
+
+    // Children lists, then subtree sizes from the leaves up
+    for (int v = 0; v < n; v++) {
+        child_offsets[v + 1] += child_offsets[v];
+    }
+    int* fill = malloc((size_t)n * sizeof(int));
+    if (!fill) {
+        goto done;
+    }
+    memcpy(fill, child_offsets, (size_t)n * sizeof(int));
+    qsort(order, (size_t)reached, sizeof(TreeNode), compare_tree_nodes);
+    for (int i = 0; i < reached; i++) {
+        int v = order[i].node;
+        int parent = workspace_previous(workspace, v);
+        if (parent < 0) {
+            continue;
+        }
+        children[fill[parent]++] = v;
+        if (covered[v]) {
+            covered[parent] = 1;
+        } else {
+            size[parent] += size[v];
+        }
+    }
+    free(fill);
+
+    int v = root;
+    for (;;) {
+        int next = -1;
+        for (int c = child_offsets[v]; c < child_offsets[v + 1]; c++) {
+            int child = children[c];
+            if (!covered[child] && (next < 0 || size[child] > size[next])) {
+                next = child;
+            }
+        }
+        if (next < 0) {
+            break;
+        }
+        v = next;
+    }
+    result = v == root && covered[root] ? -1 : v;
+
+done:
+    free(order);
+    free(size);
+    free(covered);
+    free(child_offsets);
+    free(children);
+    return result;
+}
+
+void free_landmarks(LandmarkSet* set) {
+    free(set->nodes);
+    free(set->to_landmark);
+    free(set->from_landmark);
+    memset(set, 0, sizeof(LandmarkSet));
+}
+
+int select_landmarks(const Graph* graph, LandmarkSet* set, int count, LandmarkSelection method) {
+    memset(set, 0, sizeof(LandmarkSet));
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before selecting landmarks\n");
+        return -1;
+    }
+    int n = graph->node_count;
+    if (count > MAX_LANDMARKS) count = MAX_LANDMARKS;
+    if (count > n) count = n;
+    if (count < 1) {
+        return -1;
+    }
+
+    clock_t start_time = clock();
+    SearchWorkspace workspace;
+    set->node_count = n;
+    set->count = count;
+    set->nodes = malloc((size_t)count * sizeof(int));
+    set->to_landmark = malloc((size_t)n * count * sizeof(float));
+    set->from_landmark = malloc((size_t)n * count * sizeof(float));
+    if (!set->nodes || !set->to_landmark || !set->from_landmark ||
+        init_search_workspace(&workspace, n) != 0) {
+        printf("❌ Out of memory: could not allocate %d landmark distance tables\n", count);
+        free_landmarks(set);
+        return -1;
+    }
+
+    for (int l = 0; l < count; l++) {
+        int landmark = -1;
+        if (method == LANDMARKS_AVOID) {
+            int root = (int)(((long long)l * 7919 + 104729) % n);
+            landmark = pick_avoid(graph, set, l, &workspace, root);
+        }
+        if (landmark < 0) {
+            landmark = pick_farthest(graph, set, l, &workspace);
+        }
+        set->nodes[l] = landmark;
+
+        dijkstra_search(graph, &workspace, landmark, -1);
+        store_column(&workspace, set->from_landmark, count, l, n);
+        reverse_dijkstra_search(graph, &workspace, landmark);
+        store_column(&workspace, set->to_landmark, count, l, n);
+    }
+    free_search_workspace(&workspace);
+
+    printf("✅ Selected %d landmarks (%s) in %.2fs: %.1f KB of distances\n", count,
+           method == LANDMARKS_AVOID ? "avoid" : "farthest",
+           ((double)(clock() - start_time)) / CLOCKS_PER_SEC,
+           (double)n * count * 2 * sizeof(float) / 1024.0);
+    return 0;
+}
+
+void init_landmark_query(LandmarkQuery* query, const LandmarkSet* set, int start, int end,
+                         int active_count) {
+    if (active_count > MAX_ACTIVE_LANDMARKS) active_count = MAX_ACTIVE_LANDMARKS;
+    if (active_count > set->count) active_count = set->count;
+    query->set = set;
+    query->target = end;
+    query->active_count = 0;
+    if (active_count <= 0) {
+        return;     // No bound: the heuristic is 0 and A* searches like Dijkstra
+    }
+
+    // Keep the landmarks with the best start bound, best first
+    double bounds[MAX_ACTIVE_LANDMARKS];
+    for (int l = 0; l < set->count; l++) {
+        double bound = landmark_bound(set, l, start, end);
+        int slot = query->active_count;
+        if (slot == active_count && bound <= bounds[slot - 1]) {
+            continue;
+        }
+        if (slot == active_count) {
+            slot--;
+        } else {
+            query->active_count++;
+        }
+        while (slot > 0 && bounds[slot - 1] < bound) {
+            bounds[slot] = bounds[slot - 1];
+            query->active[slot] = query->active[slot - 1];
+            slot--;
+        }
+        bounds[slot] = bound;
+        query->active[slot] = l;
+    }
+    for (int i = 0; i < query->active_count; i++) {
+        query->target_to[i] = set->to_landmark[(size_t)end * set->count + query->active[i]];
+        query->target_from[i] = set->from_landmark[(size_t)end * set->count + query->active[i]];
+    }
+}
+
+double landmark_heuristic(const void* context, int v, int target) {
+    const LandmarkQuery* query = context;
+    const LandmarkSet* set = query->set;
+    const float* to = set->to_landmark + (size_t)v * set->count;
+    const float* from = set->from_landmark + (size_t)v * set->count;
+    (void)target;   // Fixed by init_landmark_query
+
+    // landmark_bound with the target's values cached
+    double best = 0.0;
+    for (int i = 0; i < query->active_count; i++) {
+        int l = query->active[i];
+        double to_t = query->target_to[i], from_v = from[l];
+        if (to_t < INF && to[l] - to_t * (1.0 + FLT_EPSILON) > best) {
+            best = to[l] - to_t * (1.0 + FLT_EPSILON);
+        }
+        if (from_v < INF && query->target_from[i] - from_v * (1.0 + FLT_EPSILON) > best) {
+            best = query->target_from[i] - from_v * (1.0 + FLT_EPSILON);
+        }
+    }
+    return best;
+}
+
+int alt_pathfind(const Graph* graph, const LandmarkSet* set, int start, int end,
+                 int path[], double* total_cost, int* nodes_settled) {
+    *nodes_settled = 0;
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+    if (set->node_count != graph->node_count) {
+        printf("❌ Landmarks were selected on a different graph\n");
+        return 0;
+    }
+
+    clock_t start_time = clock();
+
+    SearchWorkspace workspace;
+    if (init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate A* search state\n");
+        return 0;
+    }
+
+    LandmarkQuery query;
+    init_landmark_query(&query, set, start, end, DEFAULT_ACTIVE_LANDMARKS);
+    printf("Starting A* with landmarks (%d of %d active): node %d → node %d\n",
+           query.active_count, set->count, start, end);
+
+    int path_length = 0;
+    double cost = astar_search_with(graph, &workspace, start, end, landmark_heuristic, &query);
+    if (cost < INF) {
+        path_length = workspace_path(&workspace, end, path);
+        *total_cost = cost;
+        *nodes_settled = workspace.settled;
+
+        double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        printf("✅ A* (ALT) completed! Distance: %.2f km\n", *total_cost);
+        printf("   Nodes explored: %d, Time: %.4fs\n", workspace.settled, calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+
+    free_search_workspace(&workspace);
+    return path_length;
+}
@@ -0,0 +1,73 @@
+/**
+ * landmarks.h
+ * ALT heuristic: A* with landmark lower bounds from the triangle inequality
+ */
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define MAX_LANDMARKS 64
+#define MAX_ACTIVE_LANDMARKS 8
+#define DEFAULT_ACTIVE_LANDMARKS 4
+
+typedef enum {
+    LANDMARKS_FARTHEST,     // Each landmark as far as possible from the others
+    LANDMARKS_AVOID         // Cover the shortest path tree regions with the weakest bounds
+} LandmarkSelection;
+
+// Per-query state of the landmark heuristic: the landmarks giving the
+// best start-end bound and the target's distances to them
+typedef struct {
+    const LandmarkSet* set;
+    int target;
+    int active[MAX_ACTIVE_LANDMARKS];
+    float target_to[MAX_ACTIVE_LANDMARKS];     // target -> landmark
+    float target_from[MAX_ACTIVE_LANDMARKS];   // landmark -> target
+    int active_count;
+} LandmarkQuery;
+
+/**
+ * Pick count landmarks and store every node's distance to and from each
+ * (two full searches per landmark over the CSR and reverse CSR). The
+ * graph must be frozen; the distances follow its current weights, so
+ * traffic reweighting needs new landmarks.
+ * @return 0 on success, -1 if the graph is not frozen or memory runs out
+ */
+int select_landmarks(const Graph* graph, LandmarkSet* set, int count, LandmarkSelection method);
+
+/**
+ * Release the memory held by a landmark set
+ */
+void free_landmarks(LandmarkSet* set);
+
+/**
+ * Prepare a query: keep the active_count landmarks (at most
+ * MAX_ACTIVE_LANDMARKS) with the largest lower bound from start to end;
+ * none if active_count <= 0 or the set is empty (the heuristic is then 0)
+ */
+void init_landmark_query(LandmarkQuery* query, const LandmarkSet* set, int start, int end,
+                         int active_count);
+
+/**
+ * AStarHeuristic for astar_search_with: the largest triangle-inequality
+ * bound over the query's active landmarks,
+ * max(d(v,L) - d(t,L), d(L,t) - d(L,v)), never above the true distance
+ * @param query A LandmarkQuery prepared for this target
+ */
+double landmark_heuristic(const void* query, int v, int target);
+
+/**
+ * Find the shortest path with A* over landmark bounds. The graph must be
+ * frozen and the landmarks selected on its current weights.
+ * @param path Array to store the path vertices (node_count entries)
+ * @param total_cost Pointer to store total path cost
+ * @param nodes_settled Set to the nodes the search settled
+ * @return Length of the path (number of vertices)
+ */
+int alt_pathfind(const Graph* graph, const LandmarkSet* set, int start, int end,
+                 int path[], double* total_cost, int* nodes_settled);
+
+#endif // LANDMARKS_H
@@ -10,11 +10,31 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "gps_types.h"
 #include "graph.h"
 #include "pathfinding.h"
 #include "json_output.h"
 #include "data_loader.h"
+#include "graph_file.h"
+#include "network_loader.h"
+#include "contraction.h"
+#include "landmarks.h"
+#include "overlay.h"
+#include "hub_labels.h"
+#include "arc_flags.h"
+#include "distance_matrix.h"
+#include "batch_query.h"
+#include "time_dependent.h"
+#include "alternatives.h"
+
+#define DEFAULT_GRAPH_FILE "mumbai.tmg"
+#define DEFAULT_HIERARCHY_FILE "network.tmch"  // Rebuilt whenever the loaded graph differs
+#define DEFAULT_LABEL_FILE "network.tmhl"       // Hub labels, likewise
+#define DEFAULT_MATRIX_FILE "distances.tmdm"
+#define DEFAULT_BATCH_RESULTS "batch_results.txt"
+#define ALT_LANDMARKS 8              // Selected per run; 64 bytes of distances per node
+#define MAX_LISTED_LOCATIONS 20     // Imported networks are far too large to list
 
 void print_banner(void) {
     printf("\n");
@@ -25,70 +45,468 @@ void print_banner(void) {
     printf("\n");
 }
 
+/**
+ * Resolve a start/end answer: blank keeps the default, digits are a node
+ * index, anything else is looked up as a location name (any case)
+ */
+int parse_location_input(const Graph* graph, char* input, int default_index) {
+    input[strcspn(input, "\r\n")] = '\0';
+    if (input[0] == '\0') {
+        return default_index;
+    }
+    if (input[0] >= '0' && input[0] <= '9') {
+        return atoi(input);
+    }
+    
+    int index = find_location_by_name_nocase(graph, input);
+    if (index < 0) {
+        printf("❌ Unknown location: %s\n", input);
+    }
+    return index;
+}
+
 void print_menu(void) {
     printf("\n📋 Select Algorithm:\n");
     printf("══════════════════\n");
     printf("1. Dijkstra's Algorithm (Classic shortest path)\n");
     printf("2. A* Algorithm (Heuristic-based, faster)\n");
     printf("3. Compare both algorithms\n");
-    printf("4. Exit\n");
+    printf("4. Dijkstra with radix heap (integer metres)\n");
+    printf("5. Bidirectional Dijkstra (searches from both ends)\n");
+    printf("6. Contraction Hierarchies (preprocessed, %s)\n", DEFAULT_HIERARCHY_FILE);
+    printf("7. A* with landmarks (ALT heuristic)\n");
+    printf("8. Multi-level overlay (re-customized for traffic)\n");
+    printf("9. Hub labels (distance oracle, %s)\n", DEFAULT_LABEL_FILE);
+    printf("10. Dijkstra and A* with arc flags (region pruning)\n");
+    printf("11. Time-dependent route (choose a departure time)\n");
+    printf("12. Alternative routes (shortest plus up to %d alternatives)\n", MAX_ALTERNATIVE_ROUTES - 1);
+    printf("0. Exit\n");
     printf("\nChoice: ");
 }
 
-void run_dijkstra(int start, int end) {
-    printf("\n🔍 Running Dijkstra's Algorithm\n");
+void run_dijkstra(const Graph* graph, int start, int end, int use_radix_heap) {
+    printf("\n🔍 Running Dijkstra's Algorithm%s\n", use_radix_heap ? " (radix heap)" : "");
     printf("═══════════════════════════════\n");
     
-    double distances[MAX_NODES];
-    int previous[MAX_NODES];
+    double* distances = malloc((size_t)graph->node_count * sizeof(double));
+    int* previous = malloc((size_t)graph->node_count * sizeof(int));
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!distances || !previous || !path) {
+        printf("❌ Out of memory!\n");
+        free(distances);
+        free(previous);
+        free(path);
+        return;
+    }
     
-    dijkstra(start, end, distances, previous);
+    if (use_radix_heap) {
+        dijkstra_radix(graph, start, end, distances, previous);
+    } else {
+        dijkstra(graph, start, end, distances, previous);
+    }
     
     // Reconstruct and display path
-    int path[MAX_NODES];
     int path_length = reconstruct_path(end, previous, path);
     
-    print_route_console(path, path_length, distances[end]);
+    print_route_console(graph, path, path_length, distances[end], -1.0);
     
     // Generate JSON output
-    generate_json_output(start, end, distances, previous, "route_data.json");
+    generate_json_output(graph, start, end, distances, previous, "route_data.json");
+    
+    free(distances);
+    free(previous);
+    free(path);
 }
 
-void run_astar(int start, int end) {
+void run_astar(const Graph* graph, int start, int end) {
     printf("\n🎯 Running A* Algorithm\n");
     printf("═══════════════════════\n");
     
-    int path[MAX_NODES];
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    double total_cost;
+    if (!path) {
+        printf("❌ Out of memory!\n");
+        return;
+    }
+    
+    int path_length = astar_pathfind(graph, start, end, path, &total_cost);
+    
+    if (path_length > 0) {
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0, "A*",
+                             NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free(path);
+}
+
+void run_bidirectional(const Graph* graph, int start, int end) {
+    printf("\n↔️  Running Bidirectional Dijkstra\n");
+    printf("═════════════════════════════════\n");
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    double total_cost;
+    SearchWorkspace workspace;
+    if (!path || init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        free(path);
+        return;
+    }
+    
+    int bidirectional_settled;
+    int path_length = bidirectional_pathfind(graph, start, end, path, &total_cost,
+                                             &bidirectional_settled);
+    
+    if (path_length > 0) {
+        // Same query searching forward only, for the settled-node comparison
+        dijkstra_search(graph, &workspace, start, end);
+        printf("   Forward-only Dijkstra settles %d nodes; bidirectional settles %d (%.0f%%)\n",
+               workspace.settled, bidirectional_settled,
+               100.0 * bidirectional_settled / workspace.settled);
+        
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0,
+                               "Bidirectional Dijkstra", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free_search_workspace(&workspace);
+    free(path);
+}
+
+// Load the saved hierarchy for this graph, or build and save one
+int prepare_hierarchy(const Graph* graph, ContractionHierarchy* ch) {
+    if (load_contraction_hierarchy(ch, graph, DEFAULT_HIERARCHY_FILE) == 0) {
+        printf("📂 Loaded hierarchy from %s (%d shortcuts)\n", DEFAULT_HIERARCHY_FILE, ch->shortcut_count);
+        return 0;
+    }
+    printf("🔧 Preprocessing: contracting %d nodes...\n", graph->node_count);
+    if (build_contraction_hierarchy(graph, ch, 0) != 0) {
+        return -1;
+    }
+    if (save_contraction_hierarchy(ch, DEFAULT_HIERARCHY_FILE) == 0) {
+        printf("💾 Hierarchy saved to %s\n", DEFAULT_HIERARCHY_FILE);
+    }
+    return 0;
+}
+
+void run_contraction_hierarchies(const Graph* graph, int start, int end) {
+    printf("\n🏔️  Running Contraction Hierarchies\n");
+    printf("══════════════════════════════════\n");
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!path) {
+        printf("❌ Out of memory!\n");
+        return;
+    }
+    
+    ContractionHierarchy ch;
+    if (prepare_hierarchy(graph, &ch) != 0) {
+        free(path);
+        return;
+    }
+    
+    double total_cost;
+    int path_length = ch_pathfind(graph, &ch, start, end, path, &total_cost);
+    
+    if (path_length > 0) {
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0,
+                               "Contraction Hierarchies", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free_contraction_hierarchy(&ch);
+    free(path);
+}
+
+void run_alt(const Graph* graph, int start, int end) {
+    printf("\n📍 Running A* with Landmarks (ALT)\n");
+    printf("══════════════════════════════════\n");
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    SearchWorkspace workspace;
+    if (!path || init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        free(path);
+        return;
+    }
+    
+    LandmarkSet landmarks;
+    if (select_landmarks(graph, &landmarks, ALT_LANDMARKS, LANDMARKS_AVOID) != 0) {
+        free_search_workspace(&workspace);
+        free(path);
+        return;
+    }
+    
+    double total_cost;
+    int alt_settled;
+    int path_length = alt_pathfind(graph, &landmarks, start, end, path, &total_cost, &alt_settled);
+    
+    if (path_length > 0) {
+        // Same query with the straight-line heuristic, for the settled-node comparison
+        astar_search(graph, &workspace, start, end);
+        printf("   Straight-line A* settles %d nodes; ALT settles %d (%.0f%%)\n",
+               workspace.settled, alt_settled, 100.0 * alt_settled / workspace.settled);
+        
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0,
+                               "A* (ALT)", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free_landmarks(&landmarks);
+    free_search_workspace(&workspace);
+    free(path);
+}
+
+void run_overlay(const Graph* graph, MultiLevelOverlay* overlay, int start, int end) {
+    printf("\n🧩 Running Multi-Level Overlay Search\n");
+    printf("════════════════════════════════════\n");
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!path) {
+        printf("❌ Out of memory!\n");
+        return;
+    }
+    
+    // Customization applies the current weights; it only reruns when
+    // traffic changed them since the overlay was last customized
+    if (!overlay_is_customized(graph, overlay)) {
+        clock_t customize_start = clock();
+        if (customize_overlay(graph, overlay, 0) != 0) {
+            free(path);
+            return;
+        }
+        printf("⚙️  Customized for current weights in %.3fs\n",
+               ((double)(clock() - customize_start)) / CLOCKS_PER_SEC);
+    }
+    
+    double total_cost;
+    int settled;
+    int path_length = overlay_pathfind(graph, overlay, start, end, path, &total_cost, &settled);
+    
+    if (path_length > 0) {
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0,
+                               "Multi-Level Overlay", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free(path);
+}
+
+void run_hub_labels(const Graph* graph, int start, int end) {
+    printf("\n🏷️  Running Hub Label Lookup\n");
+    printf("═══════════════════════════\n");
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!path) {
+        printf("❌ Out of memory!\n");
+        return;
+    }
+    
+    // Labels come from a hierarchy; the saved file is mapped, not read
+    HubLabels labels;
+    if (load_hub_labels(&labels, graph, DEFAULT_LABEL_FILE) == 0) {
+        printf("📂 Mapped hub labels from %s\n", DEFAULT_LABEL_FILE);
+    } else {
+        ContractionHierarchy ch;
+        if (prepare_hierarchy(graph, &ch) != 0) {
+            free(path);
+            return;
+        }
+        int built = build_hub_labels(&ch, &labels) == 0;
+        free_contraction_hierarchy(&ch);
+        if (!built) {
+            free(path);
+            return;
+        }
+        if (save_hub_labels(&labels, DEFAULT_LABEL_FILE) == 0) {
+            printf("💾 Hub labels saved to %s\n", DEFAULT_LABEL_FILE);
+        }
+    }
+    
+    double total_cost;
+    int path_length = hub_label_pathfind(graph, &labels, start, end, path, &total_cost);
+    
+    if (path_length > 0) {
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0,
+                               "Hub Labels", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free_hub_labels(&labels);
+    free(path);
+}
+
+// Sum of the road lengths along a path, in km
+static double path_distance(const Graph* graph, const int path[], int path_length) {
+    const CSRGraph* csr = &graph->csr;
+    double total = 0.0;
+    for (int i = 1; i < path_length; i++) {
+        for (int e = csr->offsets[path[i - 1]]; e < csr->offsets[path[i - 1] + 1]; e++) {
+            if (csr->targets[e] == path[i]) {
+                total += csr->base_distances[e];
+                break;
+            }
+        }
+    }
+    return total;
+}
+
+void run_time_dependent(const Graph* graph, const TimeProfiles* profiles, int start, int end,
+                        const char* departure_text) {
+    printf("\n🕒 Running Time-Dependent Route\n");
+    printf("══════════════════════════════\n");
+    
+    // The clock is read here, once per query, never inside the search
+    char input[32] = "";
+    if (!departure_text) {
+        printf("Departure time (HH:MM) [default=now]: ");
+        if (fgets(input, sizeof(input), stdin) != NULL) {
+            departure_text = input;
+        }
+    }
+    int hour, minute;
+    double departure;
+    if (departure_text && sscanf(departure_text, "%d:%d", &hour, &minute) == 2 &&
+        hour >= 0 && hour < 24 && minute >= 0 && minute < 60) {
+        departure = hour * 60.0 + minute;
+    } else {
+        time_t now = time(NULL);
+        struct tm* local_time = localtime(&now);
+        departure = local_time->tm_hour * 60.0 + local_time->tm_min;
+    }
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!path) {
+        printf("❌ Out of memory!\n");
+        return;
+    }
+    
+    double minutes;
+    int path_length = td_pathfind(graph, profiles, start, end, departure, path, &minutes);
+    
+    if (path_length > 0) {
+        double total_distance = path_distance(graph, path, path_length);
+        print_route_console(graph, path, path_length, total_distance, minutes);
+        generate_enhanced_json(graph, start, end, path, path_length, total_distance, minutes,
+                               "Time-dependent A*", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free(path);
+}
+
+void run_arc_flags(const Graph* graph, int start, int end) {
+    printf("\n🚩 Running Searches with Arc Flags\n");
+    printf("═════════════════════════════════\n");
+    
+    int* path = malloc((size_t)graph->node_count * sizeof(int));
+    SearchWorkspace workspace;
+    if (!path || init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        free(path);
+        return;
+    }
+    
+    int regions = graph->node_count < DEFAULT_ARC_FLAG_REGIONS ? graph->node_count
+                                                               : DEFAULT_ARC_FLAG_REGIONS;
+    ArcFlags flags;
+    if (compute_arc_flags(graph, &flags, regions > 0 ? regions : 1, 0) != 0) {
+        free_search_workspace(&workspace);
+        free(path);
+        return;
+    }
+    
     double total_cost;
+    int dijkstra_settled, astar_settled;
+    arc_flags_pathfind(graph, &flags, start, end, 0, path, &total_cost, &dijkstra_settled);
+    int path_length = arc_flags_pathfind(graph, &flags, start, end, 1, path, &total_cost,
+                                         &astar_settled);
     
-    int path_length = astar_pathfind(start, end, path, &total_cost);
+    if (path_length > 0) {
+        // Same queries without pruning, for the settled-node comparison
+        dijkstra_search(graph, &workspace, start, end);
+        printf("   Dijkstra settles %d nodes; with arc flags %d\n",
+               workspace.settled, dijkstra_settled);
+        astar_search(graph, &workspace, start, end);
+        printf("   A* settles %d nodes; with arc flags %d\n", workspace.settled, astar_settled);
+        
+        print_route_console(graph, path, path_length, total_cost, -1.0);
+        generate_enhanced_json(graph, start, end, path, path_length, total_cost, -1.0,
+                               "A* (arc flags)", NULL, 0, "enhanced_route_data.json");
+    } else {
+        printf("No path found!\n");
+    }
+    
+    free_arc_flags(&flags);
+    free_search_workspace(&workspace);
+    free(path);
+}
+
+void run_alternatives(const Graph* graph, int start, int end) {
+    printf("\n🔀 Running Alternative Routes\n");
+    printf("════════════════════════════\n");
+    
+    AlternativeWorkspace workspace;
+    if (init_alternative_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory!\n");
+        return;
+    }
+    
+    int route_count;
+    int path_length = alternatives_pathfind(graph, &workspace, start, end, &route_count);
     
     if (path_length > 0) {
-        print_route_console(path, path_length, total_cost);
-        generate_enhanced_json(start, end, path, path_length, total_cost, 
-                             "enhanced_route_data.json");
+        const AlternativeRoute* routes = workspace.routes;
+        print_route_console(graph, routes[0].path, path_length, routes[0].distance, -1.0);
+        generate_enhanced_json(graph, start, end, routes[0].path, path_length, routes[0].distance, -1.0,
+                               "Alternative routes", routes + 1, route_count - 1,
+                               "enhanced_route_data.json");
     } else {
         printf("No path found!\n");
     }
+    
+    free_alternative_workspace(&workspace);
 }
 
-void compare_algorithms(int start, int end) {
+void compare_algorithms(const Graph* graph, int start, int end) {
     printf("\n⚖️  Comparing Dijkstra vs A*\n");
     printf("════════════════════════════\n\n");
     
     // Run Dijkstra
+    double* distances = malloc((size_t)graph->node_count * sizeof(double));
+    int* previous = malloc((size_t)graph->node_count * sizeof(int));
+    int* dijkstra_path = malloc((size_t)graph->node_count * sizeof(int));
+    int* astar_path = malloc((size_t)graph->node_count * sizeof(int));
+    if (!distances || !previous || !dijkstra_path || !astar_path) {
+        printf("❌ Out of memory!\n");
+        free(distances);
+        free(previous);
+        free(dijkstra_path);
+        free(astar_path);
+        return;
+    }
+    
     printf("--- Dijkstra's Algorithm ---\n");
-    double distances[MAX_NODES];
-    int previous[MAX_NODES];
-    dijkstra(start, end, distances, previous);
+    dijkstra(graph, start, end, distances, previous);
     
-    int dijkstra_path[MAX_NODES];
     int dijkstra_length = reconstruct_path(end, previous, dijkstra_path);
     
     printf("\n--- A* Algorithm ---\n");
-    int astar_path[MAX_NODES];
-    double astar_cost;
-    int astar_length = astar_pathfind(start, end, astar_path, &astar_cost);
+    double astar_cost = INF;
+    int astar_length = astar_pathfind(graph, start, end, astar_path, &astar_cost);
     
     printf("\n📊 Comparison Results:\n");
     printf("══════════════════════\n");
@@ -98,19 +516,221 @@ void compare_algorithms(int start, int end) {
     if (astar_cost <= distances[end] + 0.01) {
         printf("✅ Both algorithms found optimal path!\n");
     }
+    
+    free(distances);
+    free(previous);
+    free(dijkstra_path);
+    free(astar_path);
+}
+
+/**
+ * Build the enhanced network once and write it as a binary graph file
+ * (./trackmate --export [file]) for near-instant startup later
+ */
+int export_network(const char* filename) {
+    Graph graph;
+    if (init_graph(&graph) != 0) {
+        return 1;
+    }
+    load_enhanced_mumbai_network(&graph);
+    int result = save_graph_file(&graph, filename);
+    if (result == 0) {
+        printf("💾 Graph file saved to %s\n", filename);
+    }
+    cleanup_graph(&graph);
+    return result == 0 ? 0 : 1;
+}
+
+/**
+ * Write the all-pairs distance matrix of the enhanced network
+ * (./trackmate --matrix [file]) and print it
+ */
+int export_matrix(const char* filename) {
+    Graph graph;
+    if (init_graph(&graph) != 0) {
+        return 1;
+    }
+    load_enhanced_mumbai_network(&graph);
+    
+    int n = graph.node_count;
+    int* nodes = malloc((size_t)n * sizeof(int));
+    ContractionHierarchy ch;
+    if (!nodes || prepare_hierarchy(&graph, &ch) != 0) {
+        free(nodes);
+        cleanup_graph(&graph);
+        return 1;
+    }
+    for (int v = 0; v < n; v++) {
+        nodes[v] = v;
+    }
+    int result = write_distance_matrix(&ch, nodes, n, nodes, n, 0, filename);
+    free_contraction_hierarchy(&ch);
+    free(nodes);
+    
+    // Read back what was written, as a fleet planner would
+    float* matrix = NULL;
+    int rows, columns;
+    if (result == 0 && load_distance_matrix(filename, &rows, &columns, &matrix) == 0) {
+        printf("💾 Distance matrix saved to %s\n", filename);
+        printf("\n%-22s", "km");
+        for (int j = 0; j < columns; j++) {
+            printf(" %7d", j);
+        }
+        printf("\n");
+        for (int i = 0; i < rows; i++) {
+            printf("%2d %-19.19s", i, graph.locations[i].name);
+            for (int j = 0; j < columns; j++) {
+                float km = matrix[(size_t)i * columns + j];
+                if (km < INF) {
+                    printf(" %7.2f", km);
+                } else {
+                    printf(" %7s", "-");
+                }
+            }
+            printf("\n");
+        }
+    } else {
+        result = -1;
+    }
+    
+    free(matrix);
+    cleanup_graph(&graph);
+    return result == 0 ? 0 : 1;
+}
+
+/**
+ * Answer a file of queries on all cores (./trackmate --batch queries.txt
+ * [results] [graph file]); "-" reads the queries from standard input.
+ * Without a graph file the enhanced network is used.
+ */
+int run_batch(const char* query_filename, const char* results_filename, const char* graph_filename) {
+    Graph graph;
+    if (init_graph(&graph) != 0) {
+        return 1;
+    }
+    if (graph_filename) {
+        cleanup_graph(&graph);
+        if (open_graph_file(&graph, graph_filename, 1) != 0) {
+            return 1;
+        }
+    } else {
+        load_enhanced_mumbai_network(&graph);
+    }
+    
+    FILE* input = strcmp(query_filename, "-") == 0 ? stdin : fopen(query_filename, "r");
+    if (!input) {
+        printf("Error: Could not open %s\n", query_filename);
+        cleanup_graph(&graph);
+        return 1;
+    }
+    BatchQuery* queries;
+    int count;
+    int result = read_batch_queries(input, &graph, &queries, &count);
+    if (input != stdin) {
+        fclose(input);
+    }
+    if (result != 0) {
+        cleanup_graph(&graph);
+        return 1;
+    }
+    printf("📥 Read %d queries from %s\n", count, query_filename);
+    
+    // The hierarchy is only prepared when some query asks for it
+    int needs_hierarchy = 0;
+    for (int i = 0; i < count; i++) {
+        needs_hierarchy |= queries[i].algorithm == QUERY_CH;
+    }
+    ContractionHierarchy ch;
+    BatchResult* results = malloc((count > 0 ? count : 1) * sizeof(BatchResult));
+    if (!results || (needs_hierarchy && prepare_hierarchy(&graph, &ch) != 0)) {
+        free(results);
+        free(queries);
+        cleanup_graph(&graph);
+        return 1;
+    }
+    
+    BatchStats stats;
+    result = run_batch_queries(&graph, needs_hierarchy ? &ch : NULL, queries, count, 0, results, &stats);
+    if (result == 0) {
+        print_batch_stats(&stats);
+        FILE* output = fopen(results_filename, "w");
+        if (output) {
+            write_batch_results(output, queries, results, count);
+            result = fclose(output);
+        }
+        if (output && result == 0) {
+            printf("💾 Results saved to %s\n", results_filename);
+        } else {
+            printf("Error: Could not write %s\n", results_filename);
+            result = -1;
+        }
+    }
+    
+    if (needs_hierarchy) {
+        free_contraction_hierarchy(&ch);
+    }
+    free(results);
+    free(queries);
+    cleanup_graph(&graph);
+    return result == 0 ? 0 : 1;
+}
+
+/**
+ * Import an OpenStreetMap extract (./trackmate --import map.osm [file]) or
+ * node and edge files (./trackmate --import-network nodes.csv edges.csv
+ * [file]) and write it as a binary graph file; edges_filename is NULL for OSM
+ */
+int import_network(const char* source_filename, const char* edges_filename, const char* filename) {
+    Graph graph;
+    if (init_graph(&graph) != 0) {
+        return 1;
+    }
+    int result = edges_filename ? load_network_files(&graph, source_filename, edges_filename, 0)
+                                : load_custom_network(&graph, source_filename);
+    if (result == 0) {
+        print_graph_stats(&graph);
+        result = save_graph_file(&graph, filename);
+    }
+    if (result == 0) {
+        printf("💾 Graph file saved to %s\n", filename);
+    }
+    cleanup_graph(&graph);
+    return result == 0 ? 0 : 1;
 }
 
 int main(int argc, char* argv[]) {
     print_banner();
     
+    if (argc > 1 && strcmp(argv[1], "--export") == 0) {
+        return export_network(argc > 2 ? argv[2] : DEFAULT_GRAPH_FILE);
+    }
+    if (argc > 1 && strcmp(argv[1], "--matrix") == 0) {
+        return export_matrix(argc > 2 ? argv[2] : DEFAULT_MATRIX_FILE);
+    }
+    if (argc > 2 && strcmp(argv[1], "--batch") == 0) {
+        return run_batch(argv[2], argc > 3 ? argv[3] : DEFAULT_BATCH_RESULTS, argc > 4 ? argv[4] : NULL);
+    }
+    if (argc > 2 && strcmp(argv[1], "--import") == 0) {
+        return import_network(argv[2], NULL, argc > 3 ? argv[3] : DEFAULT_GRAPH_FILE);
+    }
+    if (argc > 3 && strcmp(argv[1], "--import-network") == 0) {
+        return import_network(argv[2], argv[3], argc > 4 ? argv[4] : DEFAULT_GRAPH_FILE);
+    }
+    
     // Initialize graph
-    init_graph();
+    Graph graph;
+    if (init_graph(&graph) != 0) {
+        return 1;
+    }
     
     // Load network data
     printf("📦 Select Network Dataset:\n");
     printf("═════════════════════════\n");
     printf("1. Basic Mumbai Network (7 locations)\n");
     printf("2. Enhanced Mumbai Network (10 locations)\n");
+    printf("3. Binary Graph File (%s, see --export)\n", DEFAULT_GRAPH_FILE);
+    printf("4. OpenStreetMap Extract (.osm file)\n");
+    printf("5. Node + Edge Files (.csv or GeoJSON)\n");
     printf("\nChoice [default=2]: ");
     
     int network_choice = 2;
@@ -119,51 +739,86 @@ int main(int argc, char* argv[]) {
     } else {
         char input[10];
         if (fgets(input, sizeof(input), stdin) != NULL) {
-            if (input[0] >= '1' && input[0] <= '2') {
+            if (input[0] >= '1' && input[0] <= '5') {
                 network_choice = input[0] - '0';
             }
         }
     }
     
     if (network_choice == 1) {
-        load_basic_mumbai_network();
+        load_basic_mumbai_network(&graph);
+    } else if (network_choice == 3) {
+        cleanup_graph(&graph);
+        if (open_graph_file(&graph, DEFAULT_GRAPH_FILE, 1) != 0) {
+            return 1;
+        }
+        printf("✅ Mapped %d locations from %s\n\n", graph.node_count, DEFAULT_GRAPH_FILE);
+    } else if (network_choice == 4) {
+        char filename[256] = "";
+        printf("\nOSM file path: ");
+        if (fgets(filename, sizeof(filename), stdin) != NULL) {
+            filename[strcspn(filename, "\r\n")] = '\0';
+        }
+        if (load_custom_network(&graph, filename) != 0) {
+            cleanup_graph(&graph);
+            return 1;
+        }
+    } else if (network_choice == 5) {
+        char nodes_filename[256] = "";
+        char edges_filename[256] = "";
+        printf("\nNodes file path: ");
+        if (fgets(nodes_filename, sizeof(nodes_filename), stdin) != NULL) {
+            nodes_filename[strcspn(nodes_filename, "\r\n")] = '\0';
+        }
+        printf("Edges file path: ");
+        if (fgets(edges_filename, sizeof(edges_filename), stdin) != NULL) {
+            edges_filename[strcspn(edges_filename, "\r\n")] = '\0';
+        }
+        if (load_network_files(&graph, nodes_filename, edges_filename, 0) != 0) {
+            cleanup_graph(&graph);
+            return 1;
+        }
     } else {
-        load_enhanced_mumbai_network();
+        load_enhanced_mumbai_network(&graph);
     }
     
-    print_graph_stats();
+    print_graph_stats(&graph);
     
     // Select start and end points
     printf("\n📍 Route Configuration:\n");
     printf("══════════════════════\n");
     printf("Available locations:\n");
-    for (int i = 0; i < node_count; i++) {
-        printf("  %d. %s\n", i, graph[i].location.name);
+    for (int i = 0; i < graph.node_count && i < MAX_LISTED_LOCATIONS; i++) {
+        printf("  %d. %s\n", i, graph.locations[i].name);
+    }
+    if (graph.node_count > MAX_LISTED_LOCATIONS) {
+        printf("  ... and %d more (enter an index or name)\n",
+               graph.node_count - MAX_LISTED_LOCATIONS);
     }
     
     int start = 0;
     int end = 3;
     
-    printf("\nStart location [default=0]: ");
-    char input[10];
-    if (fgets(input, sizeof(input), stdin) != NULL && input[0] >= '0' && input[0] <= '9') {
-        start = atoi(input);
+    printf("\nStart location (index or name) [default=0]: ");
+    char input[64];
+    if (fgets(input, sizeof(input), stdin) != NULL) {
+        start = parse_location_input(&graph, input, start);
     }
     
-    printf("End location [default=3]: ");
-    if (fgets(input, sizeof(input), stdin) != NULL && input[0] >= '0' && input[0] <= '9') {
-        end = atoi(input);
+    printf("End location (index or name) [default=3]: ");
+    if (fgets(input, sizeof(input), stdin) != NULL) {
+        end = parse_location_input(&graph, input, end);
     }
     
-    if (start < 0 || start >= node_count || end < 0 || end >= node_count) {
+    if (start < 0 || start >= graph.node_count || end < 0 || end >= graph.node_count) {
         printf("❌ Invalid location indices!\n");
-        cleanup_graph();
+        cleanup_graph(&graph);
         return 1;
     }
     
     printf("\n🎯 Route: %s → %s\n", 
-           graph[start].location.name, 
-           graph[end].location.name);
+           graph.locations[start].name, 
+           graph.locations[end].name);
     
     // Algorithm selection
     int choice = 0;
@@ -174,24 +829,69 @@ int main(int argc, char* argv[]) {
         if (scanf("%d", &choice) != 1) {
             choice = 2; // Default to A*
         }
+        int c;
+        while ((c = getchar()) != '\n' && c != EOF) {
+            // Drop the rest of the line before any further prompt
+        }
     }
     
+    // Travel time profiles are built once for the loaded network (only when
+    // the chosen search uses them) and every time-dependent query reuses them
+    TimeProfiles profiles;
+    int has_profiles = choice == 11 && build_time_profiles(&graph, &profiles) == 0;
+    
+    // Likewise the overlay partition only depends on the roads, so it is
+    // built once and kept for every overlay query on this network
+    MultiLevelOverlay overlay;
+    int has_overlay = choice == 8 && build_overlay(&graph, &overlay, 0) == 0;
+    
     switch (choice) {
         case 1:
-            run_dijkstra(start, end);
+            run_dijkstra(&graph, start, end, 0);
             break;
         case 2:
-            run_astar(start, end);
+            run_astar(&graph, start, end);
             break;
         case 3:
-            compare_algorithms(start, end);
+            compare_algorithms(&graph, start, end);
             break;
         case 4:
+            run_dijkstra(&graph, start, end, 1);
+            break;
+        case 5:
+            run_bidirectional(&graph, start, end);
+            break;
+        case 6:
+            run_contraction_hierarchies(&graph, start, end);
+            break;
+        case 7:
+            run_alt(&graph, start, end);
+            break;
+        case 8:
+            if (has_overlay) {
+                run_overlay(&graph, &overlay, start, end);
+            }
+            break;
+        case 9:
+            run_hub_labels(&graph, start, end);
+            break;
+        case 10:
+            run_arc_flags(&graph, start, end);
+            break;
+        case 11:
+            if (has_profiles) {
+                run_time_dependent(&graph, &profiles, start, end, argc > 3 ? argv[3] : NULL);
+            }
+            break;
+        case 12:
+            run_alternatives(&graph, start, end);
+            break;
+        case 0:
             printf("\n👋 Goodbye!\n");
             break;
         default:
             printf("\n⚠️  Invalid choice, running A* by default\n");
-            run_astar(start, end);
+            run_astar(&graph, start, end);
     }
     
     printf("\n🌐 Visualization Ready!\n");
@@ -199,7 +899,13 @@ int main(int argc, char* argv[]) {
     printf("   JSON data: route_data.json or enhanced_route_data.json\n\n");
     
     // Cleanup
-    cleanup_graph();
+    if (has_profiles) {
+        free_time_profiles(&profiles);
+    }
+    if (has_overlay) {
+        free_overlay(&overlay);
+    }
+    cleanup_graph(&graph);
     
     return 0;
 }
@@ -0,0 +1,889 @@
+/**
+ * network_loader.c
+ * Parallel CSV / GeoJSON network loader implementation
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <limits.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "network_loader.h"
+#include "distance.h"
+#include "parallel.h"
+
+#define LOADER_CHUNK_SIZE (1 << 20)     // Read window per parser thread
+#define LOADER_MAX_THREADS 64
+#define FIELD_SIZE 64                   // Longest field value kept
+#define MAX_FIELDS 8
+#define MAX_CSV_COLUMNS 64
+
+typedef enum {
+    FORMAT_CSV,
+    FORMAT_GEOJSON
+} FileFormat;
+
+typedef enum {
+    NODE_ID, NODE_NAME, NODE_TYPE, NODE_DISTRICT, NODE_LAT, NODE_LON,
+    NODE_ELEVATION, NODE_TRAFFIC, NODE_FIELD_COUNT
+} NodeField;
+
+typedef enum {
+    EDGE_FROM, EDGE_TO, EDGE_ROAD_TYPE, EDGE_TRAFFIC_FACTOR, EDGE_SPEED_LIMIT,
+    EDGE_ONEWAY, EDGE_FIELD_COUNT
+} EdgeField;
+
+static const char* const NODE_FIELDS[NODE_FIELD_COUNT] = {
+    "id", "name", "type", "district", "lat", "lon", "elevation", "traffic"
+};
+
+static const char* const EDGE_FIELDS[EDGE_FIELD_COUNT] = {
+    "from", "to", "road_type", "traffic_factor", "speed_limit", "oneway"
+};
+
+// Field values of one row, in NodeField / EdgeField order
+typedef struct {
+    char value[MAX_FIELDS][FIELD_SIZE];
+    int present[MAX_FIELDS];
+} Row;
+
+typedef struct {
+    int id;
+    int traffic;
+    double latitude;
+    double longitude;
+    double elevation;
+    unsigned short type;            // Worker-local category IDs
+    unsigned short district;
+    char name[50];
+} NodeRow;
+
+// Node id -> row sequence number while merging, then -> node index
+typedef struct {
+    int id;
+    int index;
+} IdEntry;
+
+// One input file, shared by all workers of a pass
+typedef struct {
+    const char* filename;
+    FileFormat format;
+    int is_edges;
+    const char* const* field_names;
+    int field_count;
+    int columns[MAX_FIELDS];        // CSV column of each field, -1 if absent
+} FileSpec;
+
+// One parser thread's byte range and results
+typedef struct {
+    const FileSpec* spec;
+    long long start;                // Lines starting in [start, end) belong here
+    long long end;
+    long long rows;
+    long long malformed;
+    int error;
+
+    // Nodes: rows plus local location type / district tables
+    NodeRow* nodes;
+    int node_count, node_capacity;
+    StringTable categories[2];
+
+    // Edges: resolved against the loaded nodes; road_type is a local ID
+    // into road_types until the merge remaps it
+    const Graph* graph;
+    const IdEntry* ids;
+    int id_count;
+    StringTable road_types;
+    DirectedEdge* edges;
+    int edge_count, edge_capacity;
+    long long self_loops;
+    long long unknown_endpoints;
+} LoadWorker;
+
+typedef struct {
+    FILE* file;
+    char* buffer;
+    size_t length;                  // Bytes in buffer
+    size_t position;                // Start of the next line
+    long long offset;               // File offset of buffer[0]
+    int eof;
+    int error;
+} LineStream;
+
+// Double *capacity until it holds `needed` elements; leaves *array on failure
+static int ensure_capacity(void** array, int* capacity, int needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+    int new_capacity = *capacity > 0 ? *capacity : 1024;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    void* resized = realloc(*array, (size_t)new_capacity * element_size);
+    if (!resized) {
+        return -1;
+    }
+    *array = resized;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static int seek_file(FILE* file, long long offset) {
+#ifndef _WIN32
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#else
+    return _fseeki64(file, offset, SEEK_SET);
+#endif
+}
+
+static int line_stream_open(LineStream* stream, const char* filename, long long start) {
+    memset(stream, 0, sizeof(LineStream));
+    stream->file = fopen(filename, "rb");
+    stream->buffer = malloc(LOADER_CHUNK_SIZE + 1);
+    stream->offset = start;
+    if (!stream->file || !stream->buffer || seek_file(stream->file, start) != 0) {
+        if (stream->file) {
+            fclose(stream->file);
+        }
+        free(stream->buffer);
+        return -1;
+    }
+    return 0;
+}
+
+static void line_stream_close(LineStream* stream) {
+    fclose(stream->file);
+    free(stream->buffer);
+}
+
+// Next line without its line ending, NUL-terminated in place. Returns NULL
+// at end of file or on error; *line_offset is the file offset of the line.
+static char* next_line(LineStream* stream, long long* line_offset) {
+    for (;;) {
+        char* begin = stream->buffer + stream->position;
+        char* newline = memchr(begin, '\n', stream->length - stream->position);
+        if (newline || (stream->eof && stream->position < stream->length)) {
+            char* end = newline ? newline : stream->buffer + stream->length;
+            *line_offset = stream->offset + (long long)stream->position;
+            stream->position = (size_t)(end - stream->buffer) + (newline ? 1 : 0);
+            if (end > begin && end[-1] == '\r') {
+                end--;
+            }
+            *end = '\0';
+            return begin;
+        }
+        if (stream->eof) {
+            return NULL;
+        }
+
+        size_t keep = stream->length - stream->position;
+        if (keep == LOADER_CHUNK_SIZE) {
+            stream->error = 1;      // One line larger than the whole window
+            return NULL;
+        }
+        memmove(stream->buffer, stream->buffer + stream->position, keep);
+        stream->offset += (long long)stream->position;
+        stream->length = keep;
+        stream->position = 0;
+
+        size_t read = fread(stream->buffer + keep, 1, LOADER_CHUNK_SIZE - keep, stream->file);
+        if (read == 0) {
+            stream->eof = 1;
+            stream->error = ferror(stream->file);
+        }
+        stream->length += read;
+    }
+}
+
+static void copy_field(char* destination, const char* source) {
+    snprintf(destination, FIELD_SIZE, "%s", source);
+}
+
+// Split a CSV line in place; quoted fields may hold commas and "" escapes
+static int split_csv(char* line, char** fields, int max_fields) {
+    int count = 0;
+    char* p = line;
+    for (;;) {
+        char* field = p;
+        char* out = p;
+        if (*p == '"') {
+            p++;
+            while (*p && !(*p == '"' && p[1] != '"')) {
+                if (*p == '"') {
+                    p++;            // "" -> "
+                }
+                *out++ = *p++;
+            }
+            if (*p == '"') {
+                p++;
+            }
+        }
+        while (*p && *p != ',') {
+            *out++ = *p++;
+        }
+        int more = *p == ',';
+        *out = '\0';
+        if (count < max_fields) {
+            fields[count++] = field;
+        }
+        if (!more) {
+            return count;
+        }
+        p++;
+    }
+}
+
+static void trim(char* text) {
+    size_t length = strlen(text);
+    while (length > 0 && isspace((unsigned char)text[length - 1])) {
+        text[--length] = '\0';
+    }
+    size_t start = 0;
+    while (isspace((unsigned char)text[start])) {
+        start++;
+    }
+    memmove(text, text + start, length - start + 1);
+}
+
+static int read_csv_row(const FileSpec* spec, char* line, Row* row) {
+    char* columns[MAX_CSV_COLUMNS];
+    int column_count = split_csv(line, columns, MAX_CSV_COLUMNS);
+    for (int f = 0; f < spec->field_count; f++) {
+        int column = spec->columns[f];
+        row->present[f] = column >= 0 && column < column_count && columns[column][0] != '\0';
+        if (row->present[f]) {
+            copy_field(row->value[f], columns[column]);
+        }
+    }
+    return 1;
+}
+
+// Find the value of "key" in [begin, end): strings are unescaped, numbers
+// and literals copied as written
+static int json_value(const char* begin, const char* end, const char* key, char* value) {
+    size_t key_length = strlen(key);
+    for (const char* p = strstr(begin, key); p != NULL && p < end; p = strstr(p + 1, key)) {
+        if (p == begin || p[-1] != '"' || p[key_length] != '"') {
+            continue;
+        }
+        const char* cursor = p + key_length + 1;
+        while (isspace((unsigned char)*cursor)) {
+            cursor++;
+        }
+        if (*cursor != ':') {
+            continue;
+        }
+        cursor++;
+        while (isspace((unsigned char)*cursor)) {
+            cursor++;
+        }
+
+        size_t n = 0;
+        if (*cursor == '"') {
+            for (cursor++; *cursor && *cursor != '"'; cursor++) {
+                char c = *cursor;
+                if (c == '\\' && cursor[1]) {
+                    c = *++cursor;
+                    if (c == 'n' || c == 't' || c == 'r') {
+                        c = ' ';
+                    } else if (c == 'u') {
+                        c = '?';    // Non-ASCII escapes are not decoded
+                        for (int i = 0; i < 4 && isxdigit((unsigned char)cursor[1]); i++) {
+                            cursor++;
+                        }
+                    }
+                }
+                if (n + 1 < FIELD_SIZE) {
+                    value[n++] = c;
+                }
+            }
+        } else {
+            while (*cursor && *cursor != ',' && *cursor != '}' && *cursor != ']' &&
+                   !isspace((unsigned char)*cursor)) {
+                if (n + 1 < FIELD_SIZE) {
+                    value[n++] = *cursor;
+                }
+                cursor++;
+            }
+            if (n == 4 && strncmp(value, "null", 4) == 0) {
+                n = 0;
+            }
+        }
+        value[n] = '\0';
+        return n > 0;
+    }
+    return 0;
+}
+
+// The {...} value of "key"; *end is set just past its closing brace
+static const char* json_object(const char* line, const char* key, const char** end) {
+    const char* p = strstr(line, key);
+    while (p && (p == line || p[-1] != '"')) {
+        p = strstr(p + 1, key);
+    }
+    if (!p || !(p = strchr(p, '{'))) {
+        return NULL;
+    }
+
+    int depth = 0, in_string = 0;
+    for (const char* c = p; *c; c++) {
+        if (in_string) {
+            if (*c == '\\' && c[1]) {
+                c++;
+            } else if (*c == '"') {
+                in_string = 0;
+            }
+        } else if (*c == '"') {
+            in_string = 1;
+        } else if (*c == '{') {
+            depth++;
+        } else if (*c == '}' && --depth == 0) {
+            *end = c + 1;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// Up to three numbers of a Point's "coordinates" array (lon, lat, elevation)
+static int json_coordinates(const char* line, char values[3][FIELD_SIZE]) {
+    const char* p = strstr(line, "\"coordinates\"");
+    if (!p || !(p = strchr(p, '['))) {
+        return 0;
+    }
+    int count = 0;
+    p++;
+    while (count < 3) {
+        while (isspace((unsigned char)*p) || *p == '[') {
+            p++;
+        }
+        size_t n = 0;
+        while (*p && (isdigit((unsigned char)*p) || strchr("+-.eE", *p))) {
+            if (n + 1 < FIELD_SIZE) {
+                values[count][n++] = *p;
+            }
+            p++;
+        }
+        if (n == 0) {
+            break;
+        }
+        values[count++][n] = '\0';
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (*p != ',') {
+            break;
+        }
+        p++;
+    }
+    return count;
+}
+
+// A GeoJSON Feature on one line; other lines (collection wrapper) are skipped
+static int read_geojson_row(const FileSpec* spec, const char* line, Row* row) {
+    const char* end;
+    const char* properties = json_object(line, "properties", &end);
+    if (!properties) {
+        return 0;
+    }
+    for (int f = 0; f < spec->field_count; f++) {
+        row->present[f] = json_value(properties, end, spec->field_names[f], row->value[f]);
+    }
+    if (!spec->is_edges) {
+        if (!row->present[NODE_ID]) {
+            row->present[NODE_ID] = json_value(line, line + strlen(line), "id", row->value[NODE_ID]);
+        }
+        char coordinates[3][FIELD_SIZE];
+        int count = json_coordinates(line, coordinates);
+        if (count >= 2) {
+            copy_field(row->value[NODE_LON], coordinates[0]);
+            copy_field(row->value[NODE_LAT], coordinates[1]);
+            row->present[NODE_LON] = row->present[NODE_LAT] = 1;
+        }
+        if (count == 3 && !row->present[NODE_ELEVATION]) {
+            copy_field(row->value[NODE_ELEVATION], coordinates[2]);
+            row->present[NODE_ELEVATION] = 1;
+        }
+    }
+    return 1;
+}
+
+static int parse_int(const char* text, int* value) {
+    char* end;
+    long number = strtol(text, &end, 10);
+    if (end == text || number < INT_MIN || number > INT_MAX) {
+        return 0;
+    }
+    *value = (int)number;
+    return 1;
+}
+
+static int parse_double(const char* text, double* value) {
+    char* end;
+    *value = strtod(text, &end);
+    return end != text;
+}
+
+// @return 1 if added, 0 if malformed, -1 on allocation failure
+static int add_node_row(LoadWorker* worker, const Row* row) {
+    NodeRow node;
+    if (!row->present[NODE_ID] || !row->present[NODE_LAT] || !row->present[NODE_LON] ||
+        !parse_int(row->value[NODE_ID], &node.id) ||
+        !parse_double(row->value[NODE_LAT], &node.latitude) ||
+        !parse_double(row->value[NODE_LON], &node.longitude)) {
+        return 0;
+    }
+    if (!row->present[NODE_ELEVATION] || !parse_double(row->value[NODE_ELEVATION], &node.elevation)) {
+        node.elevation = 0.0;
+    }
+    if (!row->present[NODE_TRAFFIC] || !parse_int(row->value[NODE_TRAFFIC], &node.traffic)) {
+        node.traffic = 1;
+    }
+
+    int type = intern_string(&worker->categories[0],
+                             row->present[NODE_TYPE] ? row->value[NODE_TYPE] : "general");
+    int district = intern_string(&worker->categories[1],
+                                 row->present[NODE_DISTRICT] ? row->value[NODE_DISTRICT] : "unknown");
+    if (type < 0 || district < 0 || type > USHRT_MAX || district > USHRT_MAX ||
+        ensure_capacity((void**)&worker->nodes, &worker->node_capacity,
+                        worker->node_count + 1, sizeof(NodeRow)) != 0) {
+        return -1;
+    }
+    node.type = (unsigned short)type;
+    node.district = (unsigned short)district;
+    if (row->present[NODE_NAME]) {
+        strncpy(node.name, row->value[NODE_NAME], sizeof(node.name) - 1);
+        node.name[sizeof(node.name) - 1] = '\0';
+    } else {
+        snprintf(node.name, sizeof(node.name), "node %d", node.id);
+    }
+    worker->nodes[worker->node_count++] = node;
+    return 1;
+}
+
+static int compare_id_entries(const void* a, const void* b) {
+    const IdEntry* x = a;
+    const IdEntry* y = b;
+    if (x->id != y->id) {
+        return (x->id > y->id) - (x->id < y->id);
+    }
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+static int find_node(const IdEntry* ids, int count, int id) {
+    int low = 0, high = count - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        if (ids[middle].id < id) {
+            low = middle + 1;
+        } else if (ids[middle].id > id) {
+            high = middle - 1;
+        } else {
+            return ids[middle].index;
+        }
+    }
+    return -1;
+}
+
+static int push_edge(LoadWorker* worker, int from, int to, double distance,
+                     float speed_limit, int road_type, int traffic_factor) {
+    if (ensure_capacity((void**)&worker->edges, &worker->edge_capacity,
+                        worker->edge_count + 1, sizeof(DirectedEdge)) != 0) {
+        return -1;
+    }
+    DirectedEdge* edge = &worker->edges[worker->edge_count++];
+    edge->from = from;
+    edge->to = to;
+    edge->distance = distance;
+    edge->speed_limit = speed_limit;
+    edge->road_type = (unsigned char)road_type;
+    edge->traffic_factor = (unsigned char)traffic_factor;
+    return 0;
+}
+
+// Resolve endpoints and compute the distance right away, in this thread
+// @return 1 if handled, 0 if malformed, -1 on allocation failure
+static int add_edge_row(LoadWorker* worker, const Row* row) {
+    int from_id, to_id;
+    if (!row->present[EDGE_FROM] || !row->present[EDGE_TO] ||
+        !parse_int(row->value[EDGE_FROM], &from_id) || !parse_int(row->value[EDGE_TO], &to_id)) {
+        return 0;
+    }
+    int from = find_node(worker->ids, worker->id_count, from_id);
+    int to = find_node(worker->ids, worker->id_count, to_id);
+    if (from < 0 || to < 0) {
+        worker->unknown_endpoints++;
+        return 1;
+    }
+    if (from == to) {
+        worker->self_loops++;
+        return 1;
+    }
+
+    int road_type = intern_string(&worker->road_types,
+                                  row->present[EDGE_ROAD_TYPE] ? row->value[EDGE_ROAD_TYPE] : "main");
+    int traffic_factor = 1;
+    double speed_limit = 50.0;
+    if (row->present[EDGE_TRAFFIC_FACTOR]) {
+        parse_int(row->value[EDGE_TRAFFIC_FACTOR], &traffic_factor);
+    }
+    if (row->present[EDGE_SPEED_LIMIT]) {
+        parse_double(row->value[EDGE_SPEED_LIMIT], &speed_limit);
+    }
+    if (road_type < 0 || road_type >= MAX_ROAD_TYPES || traffic_factor < 0 || traffic_factor > 255) {
+        return road_type < 0 ? -1 : 0;
+    }
+    const char* oneway = row->present[EDGE_ONEWAY] ? row->value[EDGE_ONEWAY] : "0";
+    int direction = strcmp(oneway, "1") == 0 || strcmp(oneway, "yes") == 0 ||
+                    strcmp(oneway, "true") == 0 ? 1 : strcmp(oneway, "-1") == 0 ? -1 : 0;
+
+    const NodeStore* nodes = &worker->graph->nodes;
+    double distance = enhanced_haversine_distance(
+        nodes->latitude[from], nodes->longitude[from], nodes->elevation[from],
+        nodes->latitude[to], nodes->longitude[to], nodes->elevation[to]
+    );
+    if ((direction >= 0 &&
+         push_edge(worker, from, to, distance, (float)speed_limit, road_type, traffic_factor) != 0) ||
+        (direction <= 0 &&
+         push_edge(worker, to, from, distance, (float)speed_limit, road_type, traffic_factor) != 0)) {
+        return -1;
+    }
+    return 1;
+}
+
+// Parse the lines that start in this worker's byte range
+static void* scan_rows(void* arg) {
+    LoadWorker* worker = arg;
+    const FileSpec* spec = worker->spec;
+    LineStream stream;
+    if (line_stream_open(&stream, spec->filename, worker->start > 0 ? worker->start - 1 : 0) != 0) {
+        worker->error = 1;
+        return NULL;
+    }
+
+    long long line_offset;
+    char* line;
+    if (worker->start > 0) {
+        next_line(&stream, &line_offset);   // Finish the line the previous range owns
+    }
+    Row row;
+    while (!worker->error && (line = next_line(&stream, &line_offset)) != NULL) {
+        if (line_offset >= worker->end) {
+            break;
+        }
+        if (line[0] == '\x1e') {
+            line++;                         // RFC 8142 record separator
+        }
+        if ((spec->format == FORMAT_CSV && line_offset == 0) || line[0] == '\0') {
+            continue;                       // Header row, blank line
+        }
+        int is_row = spec->format == FORMAT_CSV ? read_csv_row(spec, line, &row)
+                                                : read_geojson_row(spec, line, &row);
+        if (!is_row) {
+            continue;
+        }
+
+        worker->rows++;
+        int result = spec->is_edges ? add_edge_row(worker, &row) : add_node_row(worker, &row);
+        if (result == 0) {
+            worker->malformed++;
+        } else if (result < 0) {
+            worker->error = 1;
+        }
+    }
+
+    if (stream.error) {
+        worker->error = 1;
+    }
+    line_stream_close(&stream);
+    return NULL;
+}
+
+// Split the file into one byte range per worker and parse them in parallel
+static int run_workers(LoadWorker* workers, int worker_count, const FileSpec* spec) {
+    struct stat info;
+    if (stat(spec->filename, &info) != 0) {
+        printf("Error: Could not open %s\n", spec->filename);
+        return -1;
+    }
+    long long file_size = (long long)info.st_size;
+
+    for (int i = 0; i < worker_count; i++) {
+        workers[i].spec = spec;
+        workers[i].start = file_size * i / worker_count;
+        workers[i].end = file_size * (i + 1) / worker_count;
+    }
+    run_parallel(scan_rows, workers, sizeof(LoadWorker), worker_count);
+
+    int result = 0;
+    for (int i = 0; i < worker_count; i++) {
+        if (workers[i].error) {
+            result = -1;
+        }
+    }
+    if (result != 0) {
+        printf("Error: Could not parse %s\n", spec->filename);
+    }
+    return result;
+}
+
+static int prepare_spec(FileSpec* spec, const char* filename, int is_edges) {
+    const char* extension = strrchr(filename, '.');
+    spec->filename = filename;
+    spec->format = extension && strcmp(extension, ".csv") == 0 ? FORMAT_CSV : FORMAT_GEOJSON;
+    spec->is_edges = is_edges;
+    spec->field_names = is_edges ? EDGE_FIELDS : NODE_FIELDS;
+    spec->field_count = is_edges ? EDGE_FIELD_COUNT : NODE_FIELD_COUNT;
+    for (int f = 0; f < MAX_FIELDS; f++) {
+        spec->columns[f] = -1;
+    }
+    if (spec->format != FORMAT_CSV) {
+        return 0;
+    }
+
+    LineStream stream;
+    long long offset;
+    char* header;
+    if (line_stream_open(&stream, filename, 0) != 0) {
+        printf("Error: Could not open %s\n", filename);
+        return -1;
+    }
+    if ((header = next_line(&stream, &offset)) != NULL) {
+        char* columns[MAX_CSV_COLUMNS];
+        int column_count = split_csv(header, columns, MAX_CSV_COLUMNS);
+        for (int c = 0; c < column_count; c++) {
+            trim(columns[c]);
+            for (int f = 0; f < spec->field_count; f++) {
+                if (strcmp(columns[c], spec->field_names[f]) == 0) {
+                    spec->columns[f] = c;
+                }
+            }
+        }
+    }
+    line_stream_close(&stream);
+
+    int required[2][3] = { { NODE_ID, NODE_LAT, NODE_LON }, { EDGE_FROM, EDGE_TO, EDGE_TO } };
+    for (int i = 0; i < 3; i++) {
+        if (spec->columns[required[is_edges][i]] < 0) {
+            printf("Error: %s has no '%s' column\n", filename, spec->field_names[required[is_edges][i]]);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// Add the parsed nodes in file order, first occurrence of each id only.
+// Returns the sorted id -> node index table used to resolve edges.
+static IdEntry* merge_nodes(Graph* graph, LoadWorker* workers, int worker_count,
+                            int* id_count, long long* duplicate_ids) {
+    int total = 0;
+    for (int w = 0; w < worker_count; w++) {
+        total += workers[w].node_count;
+    }
+    IdEntry* ids = malloc((size_t)(total > 0 ? total : 1) * sizeof(IdEntry));
+    int* node_of_row = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    if (!ids || !node_of_row) {
+        free(ids);
+        free(node_of_row);
+        return NULL;
+    }
+
+    int row = 0;
+    for (int w = 0; w < worker_count; w++) {
+        for (int i = 0; i < workers[w].node_count; i++, row++) {
+            ids[row].id = workers[w].nodes[i].id;
+            ids[row].index = row;
+            node_of_row[row] = 0;
+        }
+    }
+    qsort(ids, (size_t)total, sizeof(IdEntry), compare_id_entries);
+
+    // Keep the first row of each id; node_of_row marks rows to add
+    int unique = 0;
+    for (int i = 0; i < total; i++) {
+        if (unique == 0 || ids[i].id != ids[unique - 1].id) {
+            node_of_row[ids[i].index] = 1;
+            ids[unique++] = ids[i];
+        }
+    }
+    *duplicate_ids = total - unique;
+
+    if (reserve_nodes(graph, graph->node_count + unique) != 0) {
+        free(ids);
+        free(node_of_row);
+        return NULL;
+    }
+    row = 0;
+    for (int w = 0; w < worker_count; w++) {
+        for (int i = 0; i < workers[w].node_count; i++, row++) {
+            if (!node_of_row[row]) {
+                node_of_row[row] = -1;
+                continue;
+            }
+            const NodeRow* node = &workers[w].nodes[i];
+            node_of_row[row] = add_enhanced_location(
+                graph, node->id, node->name,
+                interned_string(&workers[w].categories[0], node->type),
+                interned_string(&workers[w].categories[1], node->district),
+                node->latitude, node->longitude, node->elevation, node->traffic);
+            if (node_of_row[row] < 0) {
+                free(ids);
+                free(node_of_row);
+                return NULL;
+            }
+        }
+    }
+    for (int i = 0; i < unique; i++) {
+        ids[i].index = node_of_row[ids[i].index];
+    }
+    free(node_of_row);
+    *id_count = unique;
+    return ids;
+}
+
+// Concatenate the workers' edges with road types remapped to graph IDs
+static DirectedEdge* merge_edges(Graph* graph, LoadWorker* workers, int worker_count, int* count) {
+    long long total = 0;
+    for (int w = 0; w < worker_count; w++) {
+        total += workers[w].edge_count;
+    }
+    DirectedEdge* edges = total <= INT_MAX ?
+        malloc((size_t)(total > 0 ? total : 1) * sizeof(DirectedEdge)) : NULL;
+    if (!edges) {
+        return NULL;
+    }
+
+    int n = 0;
+    for (int w = 0; w < worker_count; w++) {
+        int road_type_map[MAX_ROAD_TYPES];
+        for (int t = 0; t < workers[w].road_types.count; t++) {
+            road_type_map[t] = intern_string(&graph->road_types,
+                                             interned_string(&workers[w].road_types, t));
+            if (road_type_map[t] < 0 || road_type_map[t] >= MAX_ROAD_TYPES) {
+                printf("Error: Too many road types\n");
+                free(edges);
+                return NULL;
+            }
+        }
+        for (int i = 0; i < workers[w].edge_count; i++) {
+            edges[n] = workers[w].edges[i];
+            edges[n].road_type = (unsigned char)road_type_map[edges[n].road_type];
+            n++;
+        }
+    }
+    *count = n;
+    return edges;
+}
+
+static void free_workers(LoadWorker* workers, int worker_count) {
+    for (int w = 0; w < worker_count; w++) {
+        free(workers[w].nodes);
+        free(workers[w].edges);
+        free_string_table(&workers[w].categories[0]);
+        free_string_table(&workers[w].categories[1]);
+        free_string_table(&workers[w].road_types);
+    }
+    free(workers);
+}
+
+static LoadWorker* create_workers(int worker_count) {
+    LoadWorker* workers = calloc((size_t)worker_count, sizeof(LoadWorker));
+    for (int w = 0; workers && w < worker_count; w++) {
+        init_string_table(&workers[w].categories[0]);
+        init_string_table(&workers[w].categories[1]);
+        init_string_table(&workers[w].road_types);
+    }
+    return workers;
+}
+
+int load_network_files(Graph* graph, const char* nodes_filename,
+                       const char* edges_filename, int thread_count) {
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > LOADER_MAX_THREADS) {
+        worker_count = LOADER_MAX_THREADS;
+    }
+    printf("📂 Loading network from %s and %s (%d threads)...\n",
+           nodes_filename, edges_filename, worker_count);
+
+    FileSpec node_spec, edge_spec;
+    if (prepare_spec(&node_spec, nodes_filename, 0) != 0 ||
+        prepare_spec(&edge_spec, edges_filename, 1) != 0) {
+        return -1;
+    }
+
+    // Nodes: parse in parallel, then add in file order
+    double start_time = wall_seconds();
+    LoadWorker* workers = create_workers(worker_count);
+    if (!workers) {
+        printf("Error: Out of memory while loading %s\n", nodes_filename);
+        return -1;
+    }
+    long long node_rows = 0, malformed = 0, duplicate_ids = 0;
+    int id_count = 0;
+    IdEntry* ids = NULL;
+    if (run_workers(workers, worker_count, &node_spec) == 0) {
+        for (int w = 0; w < worker_count; w++) {
+            node_rows += workers[w].rows;
+            malformed += workers[w].malformed;
+        }
+        ids = merge_nodes(graph, workers, worker_count, &id_count, &duplicate_ids);
+        if (!ids) {
+            printf("Error: Out of memory while loading %s\n", nodes_filename);
+        }
+    }
+    free_workers(workers, worker_count);
+    if (!ids) {
+        return -1;
+    }
+    double node_time = wall_seconds() - start_time;
+
+    // Edges: parse, resolve and measure in parallel, then build in bulk
+    start_time = wall_seconds();
+    workers = create_workers(worker_count);
+    if (!workers) {
+        free(ids);
+        printf("Error: Out of memory while loading %s\n", edges_filename);
+        return -1;
+    }
+    for (int w = 0; w < worker_count; w++) {
+        workers[w].graph = graph;
+        workers[w].ids = ids;
+        workers[w].id_count = id_count;
+    }
+    long long edge_rows = 0, self_loops = 0, unknown = 0;
+    int edge_count = 0, added = -1;
+    DirectedEdge* edges = NULL;
+    if (run_workers(workers, worker_count, &edge_spec) == 0) {
+        for (int w = 0; w < worker_count; w++) {
+            edge_rows += workers[w].rows;
+            malformed += workers[w].malformed;
+            self_loops += workers[w].self_loops;
+            unknown += workers[w].unknown_endpoints;
+        }
+        edges = merge_edges(graph, workers, worker_count, &edge_count);
+    }
+    free_workers(workers, worker_count);
+    free(ids);
+    if (edges) {
+        added = add_edges_bulk(graph, edges, edge_count);
+        free(edges);
+    }
+    if (added < 0 || freeze_graph(graph) != 0) {
+        printf("Error: Could not build the network from %s\n", edges_filename);
+        return -1;
+    }
+    double edge_time = wall_seconds() - start_time;
+
+    printf("✅ Loaded %d locations from %lld rows in %.2fs (%.0f rows/sec)\n",
+           id_count, node_rows, node_time, node_rows / (node_time > 0.0 ? node_time : 1e-9));
+    printf("✅ Loaded %d edges from %lld rows in %.2fs (%.0f rows/sec)\n",
+           added, edge_rows, edge_time, edge_rows / (edge_time > 0.0 ? edge_time : 1e-9));
+    printf("   Dropped: %lld self-loops, %d duplicate edges, %lld unknown endpoints, "
+           "%lld duplicate node ids, %lld malformed rows\n\n",
+           self_loops, edge_count - added, unknown, duplicate_ids, malformed);
+    return 0;
+}
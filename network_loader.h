@@ -0,0 +1,33 @@
+/**
+ * network_loader.h
+ * Parallel CSV / GeoJSON network loader
+ */
+
+#ifndef NETWORK_LOADER_H
+#define NETWORK_LOADER_H
+
+#include "graph.h"
+
+/**
+ * Load a node file and an edge file into the graph and freeze it. Files
+ * ending in .csv are CSV with a header row naming the columns; anything
+ * else is read as GeoJSON with one Feature per line (GeoJSONSeq, or a
+ * FeatureCollection written one feature per line as GDAL does).
+ *
+ * Node columns / properties: id, lat, lon (GeoJSON: Point coordinates)
+ * required; name, type, district, elevation, traffic optional.
+ * Edge columns / properties: from, to (node ids) required; road_type,
+ * traffic_factor, speed_limit, oneway (1/yes = from->to only, -1 = to->from
+ * only) optional.
+ *
+ * Both files are split into byte ranges parsed by parallel threads, edge
+ * distances are computed in parallel, and all edges are added with one
+ * add_edges_bulk call. Self-loops, duplicate edges, duplicate node ids,
+ * edges to unknown nodes and malformed rows are dropped and counted.
+ * @param thread_count Parser threads, or 0 for one per online CPU
+ * @return 0 on success, -1 on I/O or allocation failure
+ */
+int load_network_files(Graph* graph, const char* nodes_filename,
+                       const char* edges_filename, int thread_count);
+
+#endif // NETWORK_LOADER_H
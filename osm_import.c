@@ -0,0 +1,695 @@
+/**
+ * osm_import.c
+ * Streaming OpenStreetMap XML importer implementation
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "osm_import.h"
+#include "parallel.h"
+
+#define OSM_CHUNK_SIZE (1 << 20)    // Read window per parser thread
+#define OSM_MAX_THREADS 64
+#define OSM_VALUE_SIZE 64           // Longest tag value kept (names are cut to fit Location)
+
+// Car-routable highway classes; ways with any other highway tag are skipped
+typedef struct {
+    const char* tag;
+    const char* road_type;
+    float speed_limit;              // km/h when the way has no maxspeed tag
+    unsigned char traffic_factor;
+    unsigned char implies_oneway;
+} HighwayClass;
+
+static const HighwayClass HIGHWAY_CLASSES[] = {
+    { "motorway",       "highway", 100.0f, 1, 1 },
+    { "motorway_link",  "highway",  60.0f, 1, 1 },
+    { "trunk",          "highway",  80.0f, 1, 0 },
+    { "trunk_link",     "highway",  50.0f, 1, 0 },
+    { "primary",        "main",     60.0f, 2, 0 },
+    { "primary_link",   "main",     40.0f, 2, 0 },
+    { "secondary",      "main",     50.0f, 2, 0 },
+    { "secondary_link", "main",     40.0f, 2, 0 },
+    { "tertiary",       "main",     40.0f, 2, 0 },
+    { "tertiary_link",  "main",     30.0f, 2, 0 },
+    { "unclassified",   "local",    40.0f, 2, 0 },
+    { "residential",    "local",    30.0f, 2, 0 },
+    { "living_street",  "local",    10.0f, 2, 0 },
+    { "service",        "local",    20.0f, 2, 0 },
+    { "road",           "local",    30.0f, 2, 0 }
+};
+
+#define HIGHWAY_CLASS_COUNT ((int)(sizeof(HIGHWAY_CLASSES) / sizeof(HIGHWAY_CLASSES[0])))
+
+// A routable way; its node refs are ref_count entries of the worker's refs
+typedef struct {
+    int first_ref;
+    int ref_count;
+    float speed_limit;
+    unsigned char highway;          // Index into HIGHWAY_CLASSES
+    signed char direction;          // 1 = forward only, -1 = backward only, 0 = both
+} OsmWay;
+
+typedef struct {
+    int position;                   // Index into the sorted node ids
+    char name[50];
+} OsmName;
+
+// One parser thread's byte range and results
+typedef struct {
+    const char* filename;
+    long long start;                // Elements starting in [start, end) belong here
+    long long end;
+    int error;
+
+    // Pass 1: routable ways
+    OsmWay* ways;
+    int way_count, way_capacity;
+    long long* refs;
+    int ref_count, ref_capacity;
+
+    // Pass 2: coordinates of referenced nodes, written at disjoint positions
+    const long long* node_ids;
+    int node_id_count;
+    double* latitude;
+    double* longitude;
+    unsigned char* found;
+    OsmName* names;
+    int name_count, name_capacity;
+} OsmWorker;
+
+typedef struct {
+    FILE* file;
+    char* buffer;
+    size_t length;                  // Bytes in buffer
+    size_t position;                // Next unscanned byte
+    long long offset;               // File offset of buffer[0]
+    int eof;
+    int error;
+} XmlStream;
+
+// Double *capacity until it holds `needed` elements; leaves *array on failure
+static int ensure_capacity(void** array, int* capacity, int needed, size_t element_size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+    int new_capacity = *capacity > 0 ? *capacity : 1024;
+    while (new_capacity < needed) {
+        new_capacity *= 2;
+    }
+    void* resized = realloc(*array, (size_t)new_capacity * element_size);
+    if (!resized) {
+        return -1;
+    }
+    *array = resized;
+    *capacity = new_capacity;
+    return 0;
+}
+
+static int seek_file(FILE* file, long long offset) {
+#ifndef _WIN32
+    return fseeko(file, (off_t)offset, SEEK_SET);
+#else
+    return _fseeki64(file, offset, SEEK_SET);
+#endif
+}
+
+static int stream_open(XmlStream* stream, const char* filename, long long start) {
+    memset(stream, 0, sizeof(XmlStream));
+    stream->file = fopen(filename, "rb");
+    stream->buffer = malloc(OSM_CHUNK_SIZE);
+    stream->offset = start;
+    if (!stream->file || !stream->buffer || seek_file(stream->file, start) != 0) {
+        if (stream->file) {
+            fclose(stream->file);
+        }
+        free(stream->buffer);
+        return -1;
+    }
+    return 0;
+}
+
+static void stream_close(XmlStream* stream) {
+    fclose(stream->file);
+    free(stream->buffer);
+}
+
+// Next markup element as the text between '<' and '>', NUL-terminated in
+// place. Returns NULL at end of file or on error; *element_offset is the
+// file offset of the '<'.
+static char* next_element(XmlStream* stream, long long* element_offset) {
+    for (;;) {
+        char* buffer = stream->buffer;
+        char* start = memchr(buffer + stream->position, '<', stream->length - stream->position);
+        if (start) {
+            char* end = memchr(start + 1, '>', (size_t)(buffer + stream->length - (start + 1)));
+            if (end) {
+                *end = '\0';
+                *element_offset = stream->offset + (start - buffer);
+                stream->position = (size_t)(end + 1 - buffer);
+                return start + 1;
+            }
+            stream->position = (size_t)(start - buffer);   // Keep the partial element
+        } else {
+            stream->position = stream->length;
+        }
+        if (stream->eof) {
+            return NULL;
+        }
+
+        size_t keep = stream->length - stream->position;
+        if (keep == OSM_CHUNK_SIZE) {
+            stream->error = 1;      // One element larger than the whole window
+            return NULL;
+        }
+        memmove(buffer, buffer + stream->position, keep);
+        stream->offset += (long long)stream->position;
+        stream->length = keep;
+        stream->position = 0;
+
+        size_t read = fread(buffer + keep, 1, OSM_CHUNK_SIZE - keep, stream->file);
+        if (read == 0) {
+            stream->eof = 1;
+            stream->error = ferror(stream->file);
+        }
+        stream->length += read;
+    }
+}
+
+static int element_is(const char* element, const char* name) {
+    size_t length = strlen(name);
+    return strncmp(element, name, length) == 0 &&
+           (element[length] == '\0' || element[length] == '/' ||
+            isspace((unsigned char)element[length]));
+}
+
+static int self_closing(const char* element) {
+    size_t length = strlen(element);
+    while (length > 0 && isspace((unsigned char)element[length - 1])) {
+        length--;
+    }
+    return length > 0 && element[length - 1] == '/';
+}
+
+// Decode one XML entity at *text (just past '&'), advancing past it
+static char decode_entity(const char** text) {
+    static const struct { const char* name; char value; } ENTITIES[] = {
+        { "amp;", '&' }, { "lt;", '<' }, { "gt;", '>' }, { "quot;", '"' }, { "apos;", '\'' }
+    };
+    for (int i = 0; i < 5; i++) {
+        size_t length = strlen(ENTITIES[i].name);
+        if (strncmp(*text, ENTITIES[i].name, length) == 0) {
+            *text += length;
+            return ENTITIES[i].value;
+        }
+    }
+    return '&';
+}
+
+// Copy attribute `name` into value (entities decoded, cut to size)
+// @return 1 if the element has the attribute, 0 otherwise
+static int attribute(const char* element, const char* name, char* value, size_t size) {
+    size_t length = strlen(name);
+    for (const char* p = strstr(element, name); p != NULL; p = strstr(p + length, name)) {
+        if (p == element || !isspace((unsigned char)p[-1]) || p[length] != '=' ||
+            (p[length + 1] != '"' && p[length + 1] != '\'')) {
+            continue;
+        }
+        char quote = p[length + 1];
+        const char* text = p + length + 2;
+        size_t n = 0;
+        while (*text && *text != quote) {
+            char c = *text++;
+            if (c == '&') {
+                c = decode_entity(&text);
+            }
+            if (n + 1 < size) {
+                value[n++] = c;
+            }
+        }
+        value[n] = '\0';
+        return 1;
+    }
+    return 0;
+}
+
+static int find_highway_class(const char* tag) {
+    for (int i = 0; i < HIGHWAY_CLASS_COUNT; i++) {
+        if (strcmp(HIGHWAY_CLASSES[i].tag, tag) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// maxspeed values such as "50" or "30 mph"; 0 for "none", "walk" etc.
+static float parse_maxspeed(const char* value) {
+    char* end;
+    double speed = strtod(value, &end);
+    if (speed <= 0.0) {
+        return 0.0f;
+    }
+    while (isspace((unsigned char)*end)) {
+        end++;
+    }
+    return (float)(strncmp(end, "mph", 3) == 0 ? speed * 1.609344 : speed);
+}
+
+// Tags of the way being parsed
+typedef struct {
+    int highway;
+    int oneway;                     // 2 = no oneway tag
+    int roundabout;
+    int area;
+    float maxspeed;
+} WayTags;
+
+static void reset_way_tags(WayTags* tags) {
+    tags->highway = -1;
+    tags->oneway = 2;
+    tags->roundabout = 0;
+    tags->area = 0;
+    tags->maxspeed = 0.0f;
+}
+
+static void apply_way_tag(WayTags* tags, const char* element) {
+    char key[OSM_VALUE_SIZE], value[OSM_VALUE_SIZE];
+    if (!attribute(element, "k", key, sizeof(key)) || !attribute(element, "v", value, sizeof(value))) {
+        return;
+    }
+    if (strcmp(key, "highway") == 0) {
+        tags->highway = find_highway_class(value);
+    } else if (strcmp(key, "oneway") == 0) {
+        if (strcmp(value, "yes") == 0 || strcmp(value, "true") == 0 || strcmp(value, "1") == 0) {
+            tags->oneway = 1;
+        } else if (strcmp(value, "-1") == 0 || strcmp(value, "reverse") == 0) {
+            tags->oneway = -1;
+        } else if (strcmp(value, "no") == 0 || strcmp(value, "false") == 0 || strcmp(value, "0") == 0) {
+            tags->oneway = 0;
+        }
+    } else if (strcmp(key, "junction") == 0) {
+        tags->roundabout = strcmp(value, "roundabout") == 0 || strcmp(value, "circular") == 0;
+    } else if (strcmp(key, "area") == 0) {
+        tags->area = strcmp(value, "yes") == 0;
+    } else if (strcmp(key, "maxspeed") == 0) {
+        tags->maxspeed = parse_maxspeed(value);
+    }
+}
+
+// Keep the way if it is routable, otherwise drop the refs it collected
+static int finish_way(OsmWorker* worker, const WayTags* tags, int first_ref) {
+    int ref_count = worker->ref_count - first_ref;
+    if (tags->highway < 0 || tags->area || ref_count < 2) {
+        worker->ref_count = first_ref;
+        return 0;
+    }
+    if (ensure_capacity((void**)&worker->ways, &worker->way_capacity,
+                        worker->way_count + 1, sizeof(OsmWay)) != 0) {
+        return -1;
+    }
+
+    const HighwayClass* highway = &HIGHWAY_CLASSES[tags->highway];
+    OsmWay* way = &worker->ways[worker->way_count++];
+    way->first_ref = first_ref;
+    way->ref_count = ref_count;
+    way->highway = (unsigned char)tags->highway;
+    way->speed_limit = tags->maxspeed > 0.0f ? tags->maxspeed : highway->speed_limit;
+    if (tags->oneway != 2) {
+        way->direction = (signed char)tags->oneway;
+    } else {
+        way->direction = (signed char)(highway->implies_oneway || tags->roundabout);
+    }
+    return 0;
+}
+
+// Pass 1: collect routable ways that start in this worker's byte range
+static void* scan_ways(void* arg) {
+    OsmWorker* worker = arg;
+    XmlStream stream;
+    if (stream_open(&stream, worker->filename, worker->start) != 0) {
+        worker->error = 1;
+        return NULL;
+    }
+
+    int in_way = 0;
+    int first_ref = 0;
+    WayTags tags;
+    reset_way_tags(&tags);
+    char value[OSM_VALUE_SIZE];
+    long long element_offset;
+    char* element;
+    while (!worker->error && (element = next_element(&stream, &element_offset)) != NULL) {
+        if (!in_way) {
+            if (element_offset >= worker->end) {
+                break;
+            }
+            if (element_is(element, "way") && !self_closing(element)) {
+                in_way = 1;
+                first_ref = worker->ref_count;
+                reset_way_tags(&tags);
+            }
+            continue;
+        }
+
+        if (element_is(element, "nd")) {
+            if (attribute(element, "ref", value, sizeof(value))) {
+                if (ensure_capacity((void**)&worker->refs, &worker->ref_capacity,
+                                    worker->ref_count + 1, sizeof(long long)) != 0) {
+                    worker->error = 1;
+                    break;
+                }
+                worker->refs[worker->ref_count++] = strtoll(value, NULL, 10);
+            }
+        } else if (element_is(element, "tag")) {
+            apply_way_tag(&tags, element);
+        } else if (element_is(element, "/way")) {
+            in_way = 0;
+            if (finish_way(worker, &tags, first_ref) != 0) {
+                worker->error = 1;
+            }
+        }
+    }
+
+    if (stream.error) {
+        worker->error = 1;
+    }
+    stream_close(&stream);
+    return NULL;
+}
+
+static int find_node_position(const long long* ids, int count, long long id) {
+    int low = 0, high = count - 1;
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+        if (ids[middle] < id) {
+            low = middle + 1;
+        } else if (ids[middle] > id) {
+            high = middle - 1;
+        } else {
+            return middle;
+        }
+    }
+    return -1;
+}
+
+// Pass 2: coordinates and names of referenced nodes in this byte range
+static void* scan_nodes(void* arg) {
+    OsmWorker* worker = arg;
+    XmlStream stream;
+    if (stream_open(&stream, worker->filename, worker->start) != 0) {
+        worker->error = 1;
+        return NULL;
+    }
+
+    int in_node = 0;
+    int position = -1;
+    char value[OSM_VALUE_SIZE];
+    long long element_offset;
+    char* element;
+    while (!worker->error && (element = next_element(&stream, &element_offset)) != NULL) {
+        if (!in_node) {
+            if (element_offset >= worker->end) {
+                break;
+            }
+            if (!element_is(element, "node") || !attribute(element, "id", value, sizeof(value))) {
+                continue;
+            }
+            position = find_node_position(worker->node_ids, worker->node_id_count,
+                                          strtoll(value, NULL, 10));
+            if (position >= 0) {
+                char lat[OSM_VALUE_SIZE], lon[OSM_VALUE_SIZE];
+                if (attribute(element, "lat", lat, sizeof(lat)) &&
+                    attribute(element, "lon", lon, sizeof(lon))) {
+                    worker->latitude[position] = strtod(lat, NULL);
+                    worker->longitude[position] = strtod(lon, NULL);
+                    worker->found[position] = 1;
+                }
+            }
+            in_node = !self_closing(element);
+            continue;
+        }
+
+        if (element_is(element, "/node")) {
+            in_node = 0;
+        } else if (position >= 0 && element_is(element, "tag") &&
+                   attribute(element, "k", value, sizeof(value)) && strcmp(value, "name") == 0) {
+            if (ensure_capacity((void**)&worker->names, &worker->name_capacity,
+                                worker->name_count + 1, sizeof(OsmName)) != 0) {
+                worker->error = 1;
+                break;
+            }
+            OsmName* name = &worker->names[worker->name_count];
+            if (attribute(element, "v", name->name, sizeof(name->name))) {
+                name->position = position;
+                worker->name_count++;
+            }
+        }
+    }
+
+    if (stream.error) {
+        worker->error = 1;
+    }
+    stream_close(&stream);
+    return NULL;
+}
+
+// Run one pass over all workers' byte ranges in parallel
+static int run_pass(OsmWorker* workers, int worker_count, void* (*scan)(void*)) {
+    run_parallel(scan, workers, sizeof(OsmWorker), worker_count);
+    int result = 0;
+    for (int i = 0; i < worker_count; i++) {
+        if (workers[i].error) {
+            result = -1;
+        }
+    }
+    return result;
+}
+
+static int compare_ids(const void* a, const void* b) {
+    long long x = *(const long long*)a, y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_names(const void* a, const void* b) {
+    return ((const OsmName*)a)->position - ((const OsmName*)b)->position;
+}
+
+// Sorted, distinct ids of every node referenced by a routable way
+static long long* collect_node_ids(const OsmWorker* workers, int worker_count, int* count) {
+    long long total = 0;
+    for (int i = 0; i < worker_count; i++) {
+        total += workers[i].ref_count;
+    }
+    long long* ids = malloc((size_t)(total > 0 ? total : 1) * sizeof(long long));
+    if (!ids || total > 0x7fffffff) {
+        free(ids);
+        return NULL;
+    }
+
+    size_t n = 0;
+    for (int i = 0; i < worker_count; i++) {
+        memcpy(ids + n, workers[i].refs, (size_t)workers[i].ref_count * sizeof(long long));
+        n += (size_t)workers[i].ref_count;
+    }
+    qsort(ids, n, sizeof(long long), compare_ids);
+
+    size_t unique = 0;
+    for (size_t i = 0; i < n; i++) {
+        if (unique == 0 || ids[i] != ids[unique - 1]) {
+            ids[unique++] = ids[i];
+        }
+    }
+    *count = (int)unique;
+    return ids;
+}
+
+// Add the found nodes as locations; graph_index maps sorted position -> node.
+// Coordinate arrays are shared by all workers, so workers[0] has them all.
+static int add_osm_locations(Graph* graph, OsmWorker* workers, int worker_count,
+                             const long long* ids, int id_count, int* graph_index) {
+    OsmName* names = NULL;
+    int name_count = 0, name_capacity = 0;
+    for (int i = 0; i < worker_count; i++) {
+        if (ensure_capacity((void**)&names, &name_capacity, name_count + workers[i].name_count,
+                            sizeof(OsmName)) != 0) {
+            free(names);
+            return -1;
+        }
+        memcpy(names + name_count, workers[i].names, (size_t)workers[i].name_count * sizeof(OsmName));
+        name_count += workers[i].name_count;
+    }
+    if (name_count > 0) {
+        qsort(names, (size_t)name_count, sizeof(OsmName), compare_names);
+    }
+
+    int found_count = 0;
+    for (int p = 0; p < id_count; p++) {
+        found_count += workers[0].found[p];
+    }
+    if (reserve_nodes(graph, graph->node_count + found_count) != 0) {
+        free(names);
+        return -1;
+    }
+
+    int next_name = 0;
+    for (int p = 0; p < id_count; p++) {
+        graph_index[p] = -1;
+        while (next_name < name_count && names[next_name].position < p) {
+            next_name++;
+        }
+        if (!workers[0].found[p]) {
+            continue;
+        }
+
+        char generated[50];
+        const char* name = generated;
+        if (next_name < name_count && names[next_name].position == p) {
+            name = names[next_name].name;
+        } else {
+            snprintf(generated, sizeof(generated), "node %lld", ids[p]);
+        }
+        graph_index[p] = add_enhanced_location(graph, graph->node_count, name, "general", "unknown",
+                                               workers[0].latitude[p], workers[0].longitude[p],
+                                               0.0, 1);
+        if (graph_index[p] < 0) {
+            free(names);
+            return -1;
+        }
+    }
+    free(names);
+    return 0;
+}
+
+// Turn each way into edges between consecutive nodes present in the extract
+static int add_osm_edges(Graph* graph, const OsmWorker* workers, int worker_count,
+                         const long long* ids, int id_count, const int* graph_index,
+                         long long* segments) {
+    for (int w = 0; w < worker_count; w++) {
+        const OsmWorker* worker = &workers[w];
+        for (int i = 0; i < worker->way_count; i++) {
+            const OsmWay* way = &worker->ways[i];
+            const HighwayClass* highway = &HIGHWAY_CLASSES[way->highway];
+            const long long* refs = worker->refs + way->first_ref;
+            int previous = graph_index[find_node_position(ids, id_count, refs[0])];
+
+            for (int r = 1; r < way->ref_count; r++) {
+                int current = graph_index[find_node_position(ids, id_count, refs[r])];
+                if (previous >= 0 && current >= 0 && previous != current) {
+                    if ((way->direction >= 0 &&
+                         add_directed_edge(graph, previous, current, highway->road_type,
+                                           highway->traffic_factor, way->speed_limit) != 0) ||
+                        (way->direction <= 0 &&
+                         add_directed_edge(graph, current, previous, highway->road_type,
+                                           highway->traffic_factor, way->speed_limit) != 0)) {
+                        return -1;
+                    }
+                    (*segments)++;
+                }
+                previous = current;
+            }
+        }
+    }
+    return 0;
+}
+
+int import_osm_xml(Graph* graph, const char* filename, int thread_count) {
+    double start_time = wall_seconds();
+    struct stat info;
+    if (stat(filename, &info) != 0) {
+        printf("Error: Could not open %s\n", filename);
+        return -1;
+    }
+    long long file_size = (long long)info.st_size;
+
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > OSM_MAX_THREADS) {
+        worker_count = OSM_MAX_THREADS;
+    }
+    // Tiny files are not worth splitting
+    if (file_size < (long long)worker_count * OSM_CHUNK_SIZE) {
+        worker_count = (int)(file_size / OSM_CHUNK_SIZE) + 1;
+    }
+
+    OsmWorker* workers = calloc((size_t)worker_count, sizeof(OsmWorker));
+    if (!workers) {
+        printf("Error: Out of memory while importing %s\n", filename);
+        return -1;
+    }
+    for (int i = 0; i < worker_count; i++) {
+        workers[i].filename = filename;
+        workers[i].start = file_size * i / worker_count;
+        workers[i].end = file_size * (i + 1) / worker_count;
+    }
+
+    printf("🗺️  Importing OpenStreetMap extract %s (%.1f MB, %d threads)...\n",
+           filename, file_size / (1024.0 * 1024.0), worker_count);
+
+    int id_count = 0;
+    long long* ids = NULL;
+    double* latitude = NULL;
+    double* longitude = NULL;
+    unsigned char* found = NULL;
+    int* graph_index = NULL;
+    long long way_count = 0, segments = 0;
+    int result = run_pass(workers, worker_count, scan_ways);
+
+    if (result == 0) {
+        ids = collect_node_ids(workers, worker_count, &id_count);
+        latitude = malloc((size_t)(id_count > 0 ? id_count : 1) * sizeof(double));
+        longitude = malloc((size_t)(id_count > 0 ? id_count : 1) * sizeof(double));
+        found = calloc((size_t)(id_count > 0 ? id_count : 1), sizeof(unsigned char));
+        graph_index = malloc((size_t)(id_count > 0 ? id_count : 1) * sizeof(int));
+        if (!ids || !latitude || !longitude || !found || !graph_index) {
+            result = -1;
+        }
+    }
+    if (result == 0) {
+        for (int i = 0; i < worker_count; i++) {
+            workers[i].node_ids = ids;
+            workers[i].node_id_count = id_count;
+            workers[i].latitude = latitude;
+            workers[i].longitude = longitude;
+            workers[i].found = found;
+            way_count += workers[i].way_count;
+        }
+        result = run_pass(workers, worker_count, scan_nodes);
+    }
+    if (result == 0) {
+        result = add_osm_locations(graph, workers, worker_count, ids, id_count, graph_index);
+    }
+    if (result == 0) {
+        result = add_osm_edges(graph, workers, worker_count, ids, id_count, graph_index, &segments);
+    }
+    if (result == 0) {
+        result = freeze_graph(graph);
+    }
+
+    for (int i = 0; i < worker_count; i++) {
+        free(workers[i].ways);
+        free(workers[i].refs);
+        free(workers[i].names);
+    }
+    free(workers);
+    free(ids);
+    free(latitude);
+    free(longitude);
+    free(found);
+    free(graph_index);
+
+    if (result != 0) {
+        printf("Error: Could not import %s\n", filename);
+        return -1;
+    }
+
+    double elapsed = wall_seconds() - start_time;
+    printf("✅ Imported %d locations and %lld road segments from %lld ways in %.2fs (%.1f MB/s)\n\n",
+           graph->node_count, segments, way_count, elapsed,
+           file_size / (1024.0 * 1024.0) / (elapsed > 0.0 ? elapsed : 1e-9));
+    return 0;
+}
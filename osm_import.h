@@ -0,0 +1,27 @@
+/**
+ * osm_import.h
+ * Streaming OpenStreetMap XML importer
+ */
+
+#ifndef OSM_IMPORT_H
+#define OSM_IMPORT_H
+
+#include "graph.h"
+
+/**
+ * Import the car-routable roads of an OpenStreetMap XML extract (.osm)
+ * into the graph and freeze it. The file is streamed twice in fixed-size
+ * chunks, ways first and then only the nodes they reference, so memory
+ * grows with the road network kept rather than with the file. Each pass
+ * splits the file into byte ranges parsed by parallel threads.
+ *
+ * highway tags map onto road types, traffic factors and default speeds
+ * (a maxspeed tag overrides the speed); oneway and roundabout tags give
+ * one-way edges. Location.id is the node's import order, because OSM ids
+ * do not fit an int; named nodes keep their name, others are "node <osm id>".
+ * @param thread_count Parser threads, or 0 for one per online CPU
+ * @return 0 on success, -1 on I/O, parse or allocation failure
+ */
+int import_osm_xml(Graph* graph, const char* filename, int thread_count);
+
+#endif // OSM_IMPORT_H
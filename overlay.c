@@ -0,0 +1,496 @@
+/**
+ * overlay.c
+ * Multi-level overlay: partition, parallel customization and queries
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "overlay.h"
+#include "heap.h"
+#include "search_workspace.h"
+#include "parallel.h"
+
+#define CUSTOMIZE_MAX_THREADS 64
+
+// Node and the coordinate it is split on
+typedef struct {
+    double key;
+    int node;
+} SortKey;
+
+// Cells of one level handed to a customization thread: first, then
+// every stride-th, so large and small cells mix across threads
+typedef struct {
+    const Graph* graph;
+    MultiLevelOverlay* overlay;
+    int level;
+    int first;
+    int stride;
+    SearchWorkspace workspace;
+} CustomizeWorker;
+
+static int compare_keys(const void* a, const void* b) {
+    const SortKey* ka = a;
+    const SortKey* kb = b;
+    if (ka->key != kb->key) {
+        return ka->key < kb->key ? -1 : 1;
+    }
+    return ka->node - kb->node;
+}
+
+// Split nodes at the median of their wider coordinate span until each
+// piece is one region; the first half of the regions goes to the lower
+// coordinates, so with 2^d parts each split appends one bit to the id
+static void bisect(const Graph* graph, SortKey* keys, int* nodes, int count,
+                   unsigned int first, int parts, unsigned int* region) {
+    if (parts == 1 || count == 0) {
+        for (int i = 0; i < count; i++) {
+            region[nodes[i]] = first;
+        }
+        return;
+    }
+    const double* latitude = graph->nodes.latitude;
+    const double* longitude = graph->nodes.longitude;
+    double min_lat = latitude[nodes[0]], max_lat = min_lat;
+    double min_lon = longitude[nodes[0]], max_lon = min_lon;
+    for (int i = 1; i < count; i++) {
+        int v = nodes[i];
+        if (latitude[v] < min_lat) min_lat = latitude[v];
+        if (latitude[v] > max_lat) max_lat = latitude[v];
+        if (longitude[v] < min_lon) min_lon = longitude[v];
+        if (longitude[v] > max_lon) max_lon = longitude[v];
+    }
+    int split_latitude = max_lat - min_lat >= max_lon - min_lon;
+    for (int i = 0; i < count; i++) {
+        keys[i].key = split_latitude ? latitude[nodes[i]] : longitude[nodes[i]];
+        keys[i].node = nodes[i];
+    }
+    qsort(keys, (size_t)count, sizeof(SortKey), compare_keys);
+    for (int i = 0; i < count; i++) {
+        nodes[i] = keys[i].node;
+    }
+    int lower_parts = parts / 2;
+    int lower = (int)((long long)count * lower_parts / parts);
+    bisect(graph, keys, nodes, lower, first, lower_parts, region);
+    bisect(graph, keys, nodes + lower, count - lower, first + (unsigned int)lower_parts,
+           parts - lower_parts, region);
+}
+
+int partition_by_coordinates(const Graph* graph, int parts, unsigned int* region) {
+    int n = graph->node_count;
+    int* nodes = malloc((size_t)(n > 0 ? n : 1) * sizeof(int));
+    SortKey* keys = malloc((size_t)(n > 0 ? n : 1) * sizeof(SortKey));
+    if (!nodes || !keys) {
+        free(nodes);
+        free(keys);
+        return -1;
+    }
+    for (int v = 0; v < n; v++) {
+        nodes[v] = v;
+    }
+    bisect(graph, keys, nodes, n, 0, parts > 0 ? parts : 1, region);
+    free(nodes);
+    free(keys);
+    return 0;
+}
+
+static inline unsigned int cell_on_level(const MultiLevelOverlay* overlay, int v, int level) {
+    return overlay->cell[v] >> (OVERLAY_LEVEL_BITS * (level - 1));
+}
+
+static inline void relax(SearchWorkspace* workspace, int v, int from, double distance) {
+    if (workspace->stamp[v] != workspace->epoch || distance < workspace->distance[v]) {
+        workspace->stamp[v] = workspace->epoch;
+        workspace->distance[v] = distance;
+        workspace->previous[v] = from;
+        insert_heap(&workspace->heap, v, distance); // Queues v or lowers its key
+    }
+}
+
+// Relax the edges of v seen on a level: roads on level 0, otherwise its
+// row of its cell's matrix plus the roads leaving that cell. With
+// bound_level > 0, vertices outside bound_cell on that level are skipped.
+static void scan_vertex(const MultiLevelOverlay* overlay, const CSRGraph* csr,
+                        SearchWorkspace* workspace, int v, int level,
+                        int bound_level, unsigned int bound_cell) {
+    double base = workspace->distance[v];
+    unsigned int own = 0;
+    if (level > 0 && overlay->levels[level - 1].boundary_index[v] < 0) {
+        level = 0;  // Only boundary vertices have matrix rows
+    }
+    if (level > 0) {
+        const OverlayLevel* cells = &overlay->levels[level - 1];
+        own = cell_on_level(overlay, v, level);
+        int begin = cells->boundary_offsets[own];
+        int count = cells->boundary_offsets[own + 1] - begin;
+        const double* row = cells->weights + cells->matrix_offsets[own] +
+                            (size_t)cells->boundary_index[v] * count;
+        for (int j = 0; j < count; j++) {
+            if (row[j] < INF) {
+                relax(workspace, cells->boundary[begin + j], v, base + row[j]);
+            }
+        }
+    }
+    for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+        int x = csr->targets[e];
+        if (level > 0 && cell_on_level(overlay, x, level) == own) {
+            continue;   // Crossed by the matrix
+        }
+        if (bound_level > 0 && cell_on_level(overlay, x, bound_level) != bound_cell) {
+            continue;
+        }
+        relax(workspace, x, v, base + csr->weights[e]);
+    }
+}
+
+// Matrix of one cell on levels[level]: a search from each boundary vertex
+// over the level below, kept inside the cell, until every boundary vertex
+// of the cell is settled
+static void customize_cell(const Graph* graph, MultiLevelOverlay* overlay,
+                           SearchWorkspace* workspace, int level, unsigned int cell) {
+    const OverlayLevel* cells = &overlay->levels[level];
+    int begin = cells->boundary_offsets[cell];
+    int count = cells->boundary_offsets[cell + 1] - begin;
+    double* matrix = cells->weights + cells->matrix_offsets[cell];
+
+    for (int a = 0; a < count; a++) {
+        int u = cells->boundary[begin + a];
+        begin_search(workspace);
+        workspace->stamp[u] = workspace->epoch;
+        workspace->distance[u] = 0.0;
+        workspace->previous[u] = -1;
+        insert_heap(&workspace->heap, u, 0.0);
+
+        int remaining = count;
+        while (!is_empty(&workspace->heap)) {
+            int x = extract_min(&workspace->heap).vertex;
+            if (cells->boundary_index[x] >= 0 && --remaining == 0) {
+                clear_heap(&workspace->heap);
+                break;
+            }
+            scan_vertex(overlay, &graph->csr, workspace, x, level, level + 1, cell);
+        }
+        for (int j = 0; j < count; j++) {
+            matrix[(size_t)a * count + j] = workspace_distance(workspace, cells->boundary[begin + j]);
+        }
+    }
+}
+
+static void* run_customize_worker(void* arg) {
+    CustomizeWorker* worker = arg;
+    int cell_count = worker->overlay->levels[worker->level].cell_count;
+    for (int c = worker->first; c < cell_count; c += worker->stride) {
+        customize_cell(worker->graph, worker->overlay, &worker->workspace, worker->level, (unsigned int)c);
+    }
+    return NULL;
+}
+
+// Group the vertices marked in boundary_index (1 = boundary) by cell and
+// allocate the level's matrices
+static int index_boundary(const MultiLevelOverlay* overlay, OverlayLevel* cells, int level) {
+    int n = overlay->node_count;
+    cells->boundary_offsets = calloc((size_t)cells->cell_count + 1, sizeof(int));
+    cells->matrix_offsets = malloc(((size_t)cells->cell_count + 1) * sizeof(size_t));
+    if (!cells->boundary_offsets || !cells->matrix_offsets) {
+        return -1;
+    }
+    for (int v = 0; v < n; v++) {
+        if (cells->boundary_index[v] >= 0) {
+            cells->boundary_offsets[cell_on_level(overlay, v, level) + 1]++;
+        }
+    }
+    cells->matrix_offsets[0] = 0;
+    for (int c = 0; c < cells->cell_count; c++) {
+        size_t count = (size_t)cells->boundary_offsets[c + 1];
+        cells->matrix_offsets[c + 1] = cells->matrix_offsets[c] + count * count;
+        cells->boundary_offsets[c + 1] += cells->boundary_offsets[c];
+    }
+
+    int total = cells->boundary_offsets[cells->cell_count];
+    size_t entries = cells->matrix_offsets[cells->cell_count];
+    cells->boundary = malloc((size_t)(total > 0 ? total : 1) * sizeof(int));
+    cells->weights = malloc((entries > 0 ? entries : 1) * sizeof(double));
+    if (!cells->boundary || !cells->weights) {
+        return -1;
+    }
+    for (size_t i = 0; i < entries; i++) {
+        cells->weights[i] = INF;
+    }
+
+    // Fill in node order, numbering each cell's vertices from 0
+    int* fill = malloc((size_t)cells->cell_count * sizeof(int));
+    if (!fill) {
+        return -1;
+    }
+    memcpy(fill, cells->boundary_offsets, (size_t)cells->cell_count * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        if (cells->boundary_index[v] >= 0) {
+            unsigned int c = cell_on_level(overlay, v, level);
+            cells->boundary_index[v] = fill[c] - cells->boundary_offsets[c];
+            cells->boundary[fill[c]++] = v;
+        }
+    }
+    free(fill);
+    return 0;
+}
+
+void free_overlay(MultiLevelOverlay* overlay) {
+    free(overlay->cell);
+    for (int l = 0; l < MAX_OVERLAY_LEVELS; l++) {
+        OverlayLevel* cells = &overlay->levels[l];
+        free(cells->boundary_offsets);
+        free(cells->boundary);
+        free(cells->boundary_index);
+        free(cells->matrix_offsets);
+        free(cells->weights);
+    }
+    memset(overlay, 0, sizeof(MultiLevelOverlay));
+}
+
+int build_overlay(const Graph* graph, MultiLevelOverlay* overlay, int cell_size) {
+    memset(overlay, 0, sizeof(MultiLevelOverlay));
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before building an overlay\n");
+        return -1;
+    }
+    int n = graph->node_count;
+    if (cell_size <= 0) {
+        cell_size = OVERLAY_CELL_SIZE;
+    }
+    double start_time = wall_seconds();
+
+    // Bisect until cells hold at most cell_size nodes; every
+    // OVERLAY_LEVEL_BITS splits, counted from the bottom, start a level
+    int depth = 0;
+    while ((n >> depth) > cell_size && depth < 30) {
+        depth++;
+    }
+    int level_count = depth > 0 ? (depth - 1) / OVERLAY_LEVEL_BITS + 1 : 0;
+    if (level_count > MAX_OVERLAY_LEVELS) {
+        level_count = MAX_OVERLAY_LEVELS;
+    }
+    overlay->node_count = n;
+    overlay->level_count = level_count;
+    overlay->topology = graph->csr.topology_fingerprint;
+
+    overlay->cell = calloc((size_t)(n > 0 ? n : 1), sizeof(unsigned int));
+    int ok = overlay->cell && partition_by_coordinates(graph, 1 << depth, overlay->cell) == 0;
+
+    for (int l = 0; l < level_count && ok; l++) {
+        OverlayLevel* cells = &overlay->levels[l];
+        cells->cell_count = 1 << (depth - OVERLAY_LEVEL_BITS * l);
+        cells->boundary_index = malloc((size_t)n * sizeof(int));
+        ok = cells->boundary_index != NULL;
+        if (ok) {
+            memset(cells->boundary_index, 0xff, (size_t)n * sizeof(int));
+        }
+    }
+
+    // A road between two cells makes both ends boundary vertices of that
+    // level and of every level below, whose cells are nested inside
+    const CSRGraph* csr = &graph->csr;
+    for (int v = 0; v < n && ok; v++) {
+        for (int e = csr->offsets[v]; e < csr->offsets[v + 1]; e++) {
+            int x = csr->targets[e];
+            for (int l = 0; l < level_count; l++) {
+                if (cell_on_level(overlay, v, l + 1) == cell_on_level(overlay, x, l + 1)) {
+                    break;
+                }
+                overlay->levels[l].boundary_index[v] = 1;
+                overlay->levels[l].boundary_index[x] = 1;
+            }
+        }
+    }
+    for (int l = 0; l < level_count && ok; l++) {
+        ok = index_boundary(overlay, &overlay->levels[l], l + 1) == 0;
+    }
+    if (!ok) {
+        printf("❌ Out of memory: could not allocate the overlay\n");
+        free_overlay(overlay);
+        return -1;
+    }
+
+    size_t entries = 0;
+    for (int l = 0; l < level_count; l++) {
+        entries += overlay->levels[l].matrix_offsets[overlay->levels[l].cell_count];
+    }
+    printf("✅ Overlay: %d levels over %d cells of up to %d nodes, %.1f MB of matrices (%.2fs)\n",
+           level_count, level_count > 0 ? overlay->levels[0].cell_count : 1, cell_size,
+           entries * sizeof(double) / (1024.0 * 1024.0), wall_seconds() - start_time);
+    return 0;
+}
+
+int customize_overlay(const Graph* graph, MultiLevelOverlay* overlay, int thread_count) {
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before customizing an overlay\n");
+        return -1;
+    }
+    if (graph->node_count != overlay->node_count ||
+        graph->csr.topology_fingerprint != overlay->topology) {
+        printf("❌ Overlay was built for a different road network\n");
+        return -1;
+    }
+
+    int worker_count = thread_count > 0 ? thread_count : default_thread_count();
+    if (worker_count > CUSTOMIZE_MAX_THREADS) {
+        worker_count = CUSTOMIZE_MAX_THREADS;
+    }
+    CustomizeWorker workers[CUSTOMIZE_MAX_THREADS];
+    for (int i = 0; i < worker_count; i++) {
+        if (init_search_workspace(&workers[i].workspace, graph->node_count) != 0) {
+            printf("❌ Out of memory: could not allocate customization state\n");
+            for (int j = 0; j < i; j++) {
+                free_search_workspace(&workers[j].workspace);
+            }
+            return -1;
+        }
+        workers[i].graph = graph;
+        workers[i].overlay = overlay;
+        workers[i].first = i;
+        workers[i].stride = worker_count;
+    }
+
+    // Each level's matrices are built from the one below
+    for (int l = 0; l < overlay->level_count; l++) {
+        for (int i = 0; i < worker_count; i++) {
+            workers[i].level = l;
+        }
+        run_parallel(run_customize_worker, workers, sizeof(CustomizeWorker), worker_count);
+    }
+
+    for (int i = 0; i < worker_count; i++) {
+        free_search_workspace(&workers[i].workspace);
+    }
+    overlay->metric = graph->csr.fingerprint;
+    return 0;
+}
+
+int overlay_is_customized(const Graph* graph, const MultiLevelOverlay* overlay) {
+    return overlay->node_count == graph->node_count && overlay->metric == graph->csr.fingerprint;
+}
+
+// Highest level whose cell around v holds neither start nor end; the
+// search crosses v's cell on that level through its matrix
+static int query_level(const MultiLevelOverlay* overlay, int v, int start, int end) {
+    for (int level = overlay->level_count; level > 0; level--) {
+        unsigned int cell = cell_on_level(overlay, v, level);
+        if (cell != cell_on_level(overlay, start, level) && cell != cell_on_level(overlay, end, level)) {
+            return level;
+        }
+    }
+    return 0;
+}
+
+double overlay_search(const Graph* graph, const MultiLevelOverlay* overlay,
+                      SearchWorkspace* workspace, int start, int end) {
+    if (!graph->csr.is_frozen || overlay->node_count != graph->node_count ||
+        workspace->node_count < graph->node_count) {
+        return INF;
+    }
+    begin_search(workspace);
+    workspace->stamp[start] = workspace->epoch;
+    workspace->distance[start] = 0.0;
+    workspace->previous[start] = -1;
+    insert_heap(&workspace->heap, start, 0.0);
+
+    while (!is_empty(&workspace->heap)) {
+        int u = extract_min(&workspace->heap).vertex;
+        workspace->settled++;
+        if (u == end) {
+            clear_heap(&workspace->heap);
+            return workspace->distance[end];
+        }
+        scan_vertex(overlay, &graph->csr, workspace, u, query_level(overlay, u, start, end), 0, 0);
+    }
+    return INF;
+}
+
+int overlay_path(const Graph* graph, const MultiLevelOverlay* overlay,
+                 const SearchWorkspace* workspace, SearchWorkspace* scratch,
+                 int start, int end, int path[]) {
+    int* hops = malloc((size_t)graph->node_count * sizeof(int));
+    int hop_count = hops ? workspace_path(workspace, end, hops) : 0;
+    if (hop_count == 0) {
+        free(hops);
+        return 0;
+    }
+
+    // Matrix hops become the road path inside their cell
+    int length = 1;
+    path[0] = hops[0];
+    for (int i = 1; i < hop_count; i++) {
+        int u = hops[i - 1], v = hops[i];
+        int level = query_level(overlay, u, start, end);
+        if (level == 0 || overlay->levels[level - 1].boundary_index[u] < 0 ||
+            cell_on_level(overlay, u, level) != cell_on_level(overlay, v, level)) {
+            path[length++] = v;     // A road
+            continue;
+        }
+        unsigned int cell = cell_on_level(overlay, u, level);
+        begin_search(scratch);
+        scratch->stamp[u] = scratch->epoch;
+        scratch->distance[u] = 0.0;
+        scratch->previous[u] = -1;
+        insert_heap(&scratch->heap, u, 0.0);
+        while (!is_empty(&scratch->heap)) {
+            int x = extract_min(&scratch->heap).vertex;
+            if (x == v) {
+                clear_heap(&scratch->heap);
+                break;
+            }
+            scan_vertex(overlay, &graph->csr, scratch, x, 0, level, cell);
+        }
+        length += workspace_path(scratch, v, path + length - 1) - 1;
+    }
+    free(hops);
+    return length;
+}
+
+int overlay_pathfind(const Graph* graph, const MultiLevelOverlay* overlay, int start, int end,
+                     int path[], double* total_cost, int* nodes_settled) {
+    *nodes_settled = 0;
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+    if (!overlay_is_customized(graph, overlay)) {
+        printf("❌ Overlay is not customized for the current weights\n");
+        return 0;
+    }
+
+    clock_t start_time = clock();
+    printf("Starting overlay search: node %d → node %d\n", start, end);
+
+    SearchWorkspace workspace, scratch;
+    if (init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate overlay search state\n");
+        return 0;
+    }
+    if (init_search_workspace(&scratch, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate overlay search state\n");
+        free_search_workspace(&workspace);
+        return 0;
+    }
+
+    int path_length = 0;
+    double cost = overlay_search(graph, overlay, &workspace, start, end);
+    if (cost < INF) {
+        path_length = overlay_path(graph, overlay, &workspace, &scratch, start, end, path);
+        *total_cost = cost;
+        *nodes_settled = workspace.settled;
+
+        double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        printf("✅ Overlay search completed! Distance: %.2f km\n", *total_cost);
+        printf("   Overlay vertices settled: %d, Time: %.4fs\n", workspace.settled, calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+
+    free_search_workspace(&workspace);
+    free_search_workspace(&scratch);
+    return path_length;
+}
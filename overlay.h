@@ -0,0 +1,86 @@
+/**
+ * overlay.h
+ * Multi-level overlay (customizable route planning): a partition built
+ * once per road network, cell matrices re-customized whenever weights change
+ */
+
+#ifndef OVERLAY_H
+#define OVERLAY_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define OVERLAY_CELL_SIZE 128   // Default nodes per finest cell
+#define OVERLAY_LEVEL_BITS 3    // Each cell splits into 8 cells on the level below
+
+/**
+ * Split the nodes into parts regions of near-equal size by recursive
+ * median bisection of their coordinates. The regions of each split are
+ * numbered contiguously, so with 2^d parts every split adds one bit.
+ * @param region node_count entries, set to each node's region
+ * @return 0 on success, -1 if memory runs out
+ */
+int partition_by_coordinates(const Graph* graph, int parts, unsigned int* region);
+
+/**
+ * Metric-independent preprocessing: recursively bisect the nodes by
+ * coordinates into nested cells and find each level's boundary vertices.
+ * Runs once per road network; the graph must be frozen.
+ * @param cell_size Nodes per finest cell, or 0 for OVERLAY_CELL_SIZE
+ * @return 0 on success, -1 if the graph is not frozen or memory runs out
+ */
+int build_overlay(const Graph* graph, MultiLevelOverlay* overlay, int cell_size);
+
+/**
+ * Recompute every cell matrix from the graph's current CSR weights,
+ * bottom level first, with each level's cells shared among threads.
+ * Call after apply_traffic_weights and freeze_graph.
+ * @param thread_count Customization threads, or 0 for one per online CPU
+ * @return 0 on success, -1 if the roads changed since build_overlay or
+ *         memory runs out
+ */
+int customize_overlay(const Graph* graph, MultiLevelOverlay* overlay, int thread_count);
+
+/**
+ * Check whether the overlay's matrices match the graph's current weights
+ * @return 1 if customize_overlay ran since the weights last changed, 0 otherwise
+ */
+int overlay_is_customized(const Graph* graph, const MultiLevelOverlay* overlay);
+
+/**
+ * Release the memory held by an overlay
+ */
+void free_overlay(MultiLevelOverlay* overlay);
+
+/**
+ * Dijkstra over the overlay: each vertex is scanned on the highest level
+ * whose cell contains neither start nor end, crossing that cell through
+ * its matrix. Quiet, like dijkstra_search; the overlay must be customized
+ * for the graph's current weights.
+ * @return Distance from start to end in km, INF if there is no path
+ */
+double overlay_search(const Graph* graph, const MultiLevelOverlay* overlay,
+                      SearchWorkspace* workspace, int start, int end);
+
+/**
+ * Copy the road-level path found by the last overlay_search into path[],
+ * expanding each matrix entry with a search inside its cell
+ * @param scratch Workspace for the expansion searches (node_count entries)
+ * @return Number of vertices, 0 if end was not reached
+ */
+int overlay_path(const Graph* graph, const MultiLevelOverlay* overlay,
+                 const SearchWorkspace* workspace, SearchWorkspace* scratch,
+                 int start, int end, int path[]);
+
+/**
+ * Find the shortest path over a customized overlay and print the query
+ * statistics
+ * @param path Array to store the path vertices (node_count entries)
+ * @param total_cost Pointer to store total path cost
+ * @param nodes_settled Set to the vertices the search settled
+ * @return Length of the path (number of vertices)
+ */
+int overlay_pathfind(const Graph* graph, const MultiLevelOverlay* overlay, int start, int end,
+                     int path[], double* total_cost, int* nodes_settled);
+
+#endif // OVERLAY_H
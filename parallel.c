@@ -0,0 +1,64 @@
+/**
+ * parallel.c
+ * Worker threads and wall-clock timing implementation
+ */
+
+#define _XOPEN_SOURCE 700
+
+#include <pthread.h>
+#include <time.h>
+#include "parallel.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+int default_thread_count(void) {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    return cpus > 0 ? (int)cpus : 1;
+#else
+    return 1;
+#endif
+}
+
+double wall_seconds(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, now;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&now);
+    return (double)now.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+#endif
+}
+
+void run_parallel(void* (*run)(void*), void* workers, size_t worker_size, int worker_count) {
+    unsigned char* worker = workers;
+    pthread_t threads[MAX_PARALLEL_THREADS];
+    int started[MAX_PARALLEL_THREADS];
+    int thread_count = worker_count < MAX_PARALLEL_THREADS ? worker_count : MAX_PARALLEL_THREADS;
+    for (int i = 0; i < thread_count; i++) {
+        started[i] = worker_count > 1 &&
+                     pthread_create(&threads[i], NULL, run, worker + (size_t)i * worker_size) == 0;
+    }
+    // Started threads are already running while these go one by one
+    for (int i = 0; i < worker_count; i++) {
+        if (i >= thread_count || !started[i]) {
+            run(worker + (size_t)i * worker_size);
+        }
+    }
+    for (int i = 0; i < thread_count; i++) {
+        if (started[i]) {
+            pthread_join(threads[i], NULL);
+        }
+    }
+}
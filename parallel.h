@@ -0,0 +1,34 @@
+/**
+ * parallel.h
+ * Worker threads and wall-clock timing shared by the parallel engines
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <stddef.h>
+
+#define MAX_PARALLEL_THREADS 64
+
+/**
+ * Number of online CPUs, the default worker count of every parallel
+ * build, import and batch; 1 if the system does not say
+ */
+int default_thread_count(void);
+
+/**
+ * Monotonic wall-clock time in seconds, for timing multi-threaded work
+ * (clock() adds up the CPU time of all threads)
+ */
+double wall_seconds(void);
+
+/**
+ * Call run on each of worker_count workers (consecutive records of
+ * worker_size bytes starting at workers) and wait for all of them. With
+ * more than one worker each gets its own thread; a worker whose thread
+ * cannot be started, or beyond MAX_PARALLEL_THREADS, runs on the calling
+ * thread after the others have been started.
+ */
+void run_parallel(void* (*run)(void*), void* workers, size_t worker_size, int worker_count);
+
+#endif // PARALLEL_H
@@ -1,36 +1,153 @@
 /**
  * pathfinding.c
- * Implementation of Dijkstra and A* algorithms
+ * Implementation of Dijkstra (one- and bidirectional) and A* algorithms
  */
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <time.h>
 #include "pathfinding.h"
 #include "graph.h"
 #include "heap.h"
+#include "radix_heap.h"
+#include "search_workspace.h"
 #include "distance.h"
 
-void dijkstra(int start, int end, double distances[], int previous[]) {
-    MinHeap heap;
-    init_heap(&heap);
+// Workspace must match the graph and the graph must be frozen
+static int check_search(const Graph* graph, const SearchWorkspace* workspace) {
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return -1;
+    }
+    if (workspace->node_count < graph->node_count) {
+        printf("❌ Search workspace is smaller than the graph\n");
+        return -1;
+    }
+    return 0;
+}
+
+double dijkstra_search(const Graph* graph, SearchWorkspace* workspace, int start, int end) {
+    if (check_search(graph, workspace) != 0) {
+        return INF;
+    }
+    const CSRGraph* csr = &graph->csr;
+    unsigned int epoch;
+    unsigned int* stamp = workspace->stamp;
+    double* distance = workspace->distance;
+    int* previous = workspace->previous;
+    MinHeap* heap = &workspace->heap;
     
+    begin_search(workspace);
+    epoch = workspace->epoch;
+    stamp[start] = epoch;
+    distance[start] = 0.0;
+    previous[start] = -1;
+    insert_heap(heap, start, 0.0);
+    
+    while (!is_empty(heap)) {
+        int u = extract_min(heap).vertex;
+        workspace->settled++;
+        
+        if (u == end) {
+            return distance[end];
+        }
+        
+        // Explore all adjacent nodes
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            double alt = distance[u] + csr->weights[e];
+            
+            if (stamp[v] != epoch || alt < distance[v]) {
+                stamp[v] = epoch;
+                distance[v] = alt;
+                previous[v] = u;
+                insert_heap(heap, v, alt); // Queues v or lowers its key
+            }
+        }
+    }
+    return INF;
+}
+
+void dijkstra(const Graph* graph, int start, int end, double distances[], int previous[]) {
     // Initialize distances and previous nodes
-    for (int i = 0; i < node_count; i++) {
+    for (int i = 0; i < graph->node_count; i++) {
+        distances[i] = INF;
+        previous[i] = -1;
+    }
+    
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return;
+    }
+    
+    SearchWorkspace workspace;
+    if (init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate priority queue\n");
+        return;
+    }
+    
+    printf("Starting Dijkstra's algorithm: node %d → node %d\n", start, end);
+    
+    double distance = dijkstra_search(graph, &workspace, start, end);
+    if (distance < INF) {
+        printf("✅ Found shortest path! Distance: %.2f km\n", distance);
+        printf("   Nodes explored: %d\n", workspace.settled);
+    }
+    
+    for (int i = 0; i < graph->node_count; i++) {
+        if (workspace.stamp[i] == workspace.epoch) {
+            distances[i] = workspace.distance[i];
+            previous[i] = workspace.previous[i];
+        }
+    }
+    free_search_workspace(&workspace);
+}
+
+void dijkstra_radix(const Graph* graph, int start, int end, double distances[], int previous[]) {
+    const CSRGraph* csr = &graph->csr;
+    
+    for (int i = 0; i < graph->node_count; i++) {
         distances[i] = INF;
         previous[i] = -1;
     }
     
+    if (!csr->is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return;
+    }
+    
+    // Search on integer keys; distances[] accumulates the exact km of the
+    // tree the integer search picks
+    uint32_t* keys = malloc((size_t)graph->node_count * sizeof(uint32_t));
+    RadixHeap heap;
+    init_radix_heap(&heap);
+    if (!keys) {
+        printf("❌ Out of memory: could not allocate radix heap search state\n");
+        return;
+    }
+    for (int i = 0; i < graph->node_count; i++) {
+        keys[i] = UINT32_MAX;
+    }
+    
+    keys[start] = 0;
     distances[start] = 0.0;
-    insert_heap(&heap, start, 0.0);
+    radix_heap_push(&heap, 0, start);
     
-    printf("Starting Dijkstra's algorithm: %s → %s\n", 
-           graph[start].location.name, graph[end].location.name);
+    printf("Starting Dijkstra's algorithm (radix heap, %.0f units/km): node %d → node %d\n",
+           WEIGHT_UNITS_PER_KM, start, end);
     
     int nodes_explored = 0;
     
-    while (!is_empty(&heap)) {
-        PQNode current = extract_min(&heap);
-        int u = current.vertex;
+    while (heap.size > 0) {
+        uint32_t key;
+        int u = radix_heap_pop(&heap, &key);
+        if (u < 0) {
+            printf("❌ Out of memory: radix heap could not grow\n");
+            break;
+        }
+        if (key > keys[u]) {
+            continue;   // Stale entry: u was pushed again with a smaller key
+        }
         nodes_explored++;
         
         if (u == end) {
@@ -39,117 +156,289 @@ void dijkstra(int start, int end, double distances[], int previous[]) {
             break;
         }
         
-        // Skip if we've already found a better path
-        if (current.distance > distances[u]) {
-            continue;
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            uint64_t alt = (uint64_t)key + (uint64_t)(csr->weights[e] * WEIGHT_UNITS_PER_KM + 0.5);
+            
+            if (alt < keys[v]) {
+                keys[v] = (uint32_t)alt;
+                distances[v] = distances[u] + csr->weights[e];
+                previous[v] = u;
+                if (radix_heap_push(&heap, (uint32_t)alt, v) != 0) {
+                    printf("❌ Out of memory: radix heap could not grow\n");
+                    heap.size = 0;
+                    break;
+                }
+            }
+        }
+    }
+    
+    free_radix_heap(&heap);
+    free(keys);
+}
+
+double bidirectional_search(const Graph* graph, SearchWorkspace* forward,
+                            SearchWorkspace* backward, int start, int end, int* meeting) {
+    *meeting = -1;
+    if (check_search(graph, forward) != 0 || check_search(graph, backward) != 0) {
+        return INF;
+    }
+    const CSRGraph* csr = &graph->csr;
+    
+    begin_search(forward);
+    begin_search(backward);
+    SearchWorkspace* sides[2] = { forward, backward };
+    int ends[2] = { start, end };
+    for (int d = 0; d < 2; d++) {
+        sides[d]->stamp[ends[d]] = sides[d]->epoch;
+        sides[d]->distance[ends[d]] = 0.0;
+        sides[d]->previous[ends[d]] = -1;
+        insert_heap(&sides[d]->heap, ends[d], 0.0);
+    }
+    if (start == end) {
+        *meeting = start;
+        return 0.0;
+    }
+    
+    // best is the shortest start-end path seen where the two trees touch.
+    // Once the two queue minima sum to at least best, no unsettled vertex
+    // can lie on a shorter path. An empty queue means its side has settled
+    // everything it reaches, which relaxed the last edge of the best path.
+    double best = INF;
+    while (!is_empty(&forward->heap) && !is_empty(&backward->heap)) {
+        if (peek_min_key(&forward->heap) + peek_min_key(&backward->heap) >= best) {
+            break;
         }
         
-        // Explore all adjacent nodes
-        Edge* edge = graph[u].edges;
-        while (edge != NULL) {
-            int v = edge->destination;
-            double alt = distances[u] + edge->current_weight;
+        // Expand the side with fewer queued vertices
+        int d = forward->heap.size <= backward->heap.size ? 0 : 1;
+        SearchWorkspace* side = sides[d];
+        SearchWorkspace* other = sides[1 - d];
+        const int* offsets = d == 0 ? csr->offsets : csr->reverse_offsets;
+        const int* neighbours = d == 0 ? csr->targets : csr->reverse_sources;
+        const double* weights = d == 0 ? csr->weights : csr->reverse_weights;
+        unsigned int epoch = side->epoch;
+        
+        int u = extract_min(&side->heap).vertex;
+        side->settled++;
+        
+        for (int e = offsets[u]; e < offsets[u + 1]; e++) {
+            int v = neighbours[e];
+            double alt = side->distance[u] + weights[e];
             
-            if (alt < distances[v]) {
-                distances[v] = alt;
-                previous[v] = u;
-                insert_heap(&heap, v, alt);
+            if (side->stamp[v] != epoch || alt < side->distance[v]) {
+                side->stamp[v] = epoch;
+                side->distance[v] = alt;
+                side->previous[v] = u;
+                insert_heap(&side->heap, v, alt);
+                
+                if (other->stamp[v] == other->epoch && alt + other->distance[v] < best) {
+                    best = alt + other->distance[v];
+                    *meeting = v;
+                }
             }
-            edge = edge->next;
         }
     }
+    return best;
 }
 
-double heuristic_distance(int from, int to) {
-    return enhanced_haversine_distance(
-        graph[from].location.latitude, 
-        graph[from].location.longitude, 
-        graph[from].location.elevation,
-        graph[to].location.latitude, 
-        graph[to].location.longitude, 
-        graph[to].location.elevation
-    );
+int bidirectional_path(const SearchWorkspace* forward, const SearchWorkspace* backward,
+                       int meeting, int path[]) {
+    if (meeting < 0) {
+        return 0;
+    }
+    int path_length = workspace_path(forward, meeting, path);
+    // Backward predecessors point one step closer to the end
+    for (int v = workspace_previous(backward, meeting); v != -1; v = workspace_previous(backward, v)) {
+        path[path_length++] = v;
+    }
+    return path_length;
 }
 
-int astar_pathfind(int start, int end, int path[], double* total_cost) {
+int bidirectional_pathfind(const Graph* graph, int start, int end, int path[], double* total_cost,
+                           int* nodes_settled) {
+    *nodes_settled = 0;
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+    
     clock_t start_time = clock();
     
-    MinHeap open_set;
-    init_heap(&open_set);
+    SearchWorkspace forward, backward;
+    if (init_search_workspace(&forward, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate bidirectional search state\n");
+        return 0;
+    }
+    if (init_search_workspace(&backward, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate bidirectional search state\n");
+        free_search_workspace(&forward);
+        return 0;
+    }
     
-    double g_costs[MAX_NODES];
-    int parents[MAX_NODES];
-    int in_closed_set[MAX_NODES] = {0};
+    printf("Starting bidirectional Dijkstra: node %d → node %d\n", start, end);
     
-    for (int i = 0; i < node_count; i++) {
-        g_costs[i] = INF;
-        parents[i] = -1;
+    int meeting;
+    int path_length = 0;
+    double cost = bidirectional_search(graph, &forward, &backward, start, end, &meeting);
+    if (cost < INF) {
+        path_length = bidirectional_path(&forward, &backward, meeting, path);
+        *total_cost = cost;
+        *nodes_settled = forward.settled + backward.settled;
+        
+        clock_t end_time = clock();
+        double calc_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+        
+        printf("✅ Found shortest path! Distance: %.2f km\n", *total_cost);
+        printf("   Nodes settled: %d (forward %d + backward %d), meeting at node %d, Time: %.4fs\n",
+               forward.settled + backward.settled, forward.settled, backward.settled,
+               meeting, calc_time);
+    } else {
+        printf("❌ No path found!\n");
     }
     
-    g_costs[start] = 0;
-    double h_start = heuristic_distance(start, end);
-    insert_heap_astar(&open_set, start, 0, h_start, -1);
-    
-    printf("Starting A* algorithm: %s → %s\n", 
-           graph[start].location.name, graph[end].location.name);
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    return path_length;
+}
+
+double heuristic_distance(const Graph* graph, int from, int to) {
+    return enhanced_haversine_distance(
+        graph->nodes.latitude[from], 
+        graph->nodes.longitude[from], 
+        graph->nodes.elevation[from],
+        graph->nodes.latitude[to], 
+        graph->nodes.longitude[to], 
+        graph->nodes.elevation[to]
+    );
+}
+
+double straight_line_heuristic(const void* graph, int v, int target) {
+    return heuristic_distance(graph, v, target);
+}
+
+void reverse_dijkstra_search(const Graph* graph, SearchWorkspace* workspace, int end) {
+    if (check_search(graph, workspace) != 0) {
+        return;
+    }
+    const CSRGraph* csr = &graph->csr;
+    unsigned int epoch;
+    unsigned int* stamp = workspace->stamp;
+    double* distance = workspace->distance;
+    int* next = workspace->previous;
+    MinHeap* heap = &workspace->heap;
     
-    int nodes_explored = 0;
+    begin_search(workspace);
+    epoch = workspace->epoch;
+    stamp[end] = epoch;
+    distance[end] = 0.0;
+    next[end] = -1;
+    insert_heap(heap, end, 0.0);
     
-    while (open_set.size > 0) {
-        PQNode current = extract_min(&open_set);
-        int u = current.vertex;
-        nodes_explored++;
+    while (!is_empty(heap)) {
+        int u = extract_min(heap).vertex;
+        workspace->settled++;
         
-        if (u == end) {
-            // Reconstruct path
-            int path_length = 0;
-            int current_node = end;
-            while (current_node != -1) {
-                path[path_length++] = current_node;
-                current_node = parents[current_node];
-            }
+        // Incoming roads of u
+        for (int e = csr->reverse_offsets[u]; e < csr->reverse_offsets[u + 1]; e++) {
+            int v = csr->reverse_sources[e];
+            double alt = distance[u] + csr->reverse_weights[e];
             
-            // Reverse path
-            for (int i = 0; i < path_length / 2; i++) {
-                int temp = path[i];
-                path[i] = path[path_length - 1 - i];
-                path[path_length - 1 - i] = temp;
+            if (stamp[v] != epoch || alt < distance[v]) {
+                stamp[v] = epoch;
+                distance[v] = alt;
+                next[v] = u;
+                insert_heap(heap, v, alt);
             }
-            
-            *total_cost = g_costs[end];
-            
-            clock_t end_time = clock();
-            double calc_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
-            
-            printf("✅ A* completed! Distance: %.2f km\n", *total_cost);
-            printf("   Nodes explored: %d, Time: %.4fs\n", nodes_explored, calc_time);
-            
-            return path_length;
         }
+    }
+}
+
+double astar_search(const Graph* graph, SearchWorkspace* workspace, int start, int end) {
+    return astar_search_with(graph, workspace, start, end, straight_line_heuristic, graph);
+}
+
+double astar_search_with(const Graph* graph, SearchWorkspace* workspace, int start, int end,
+                         AStarHeuristic heuristic, const void* context) {
+    if (check_search(graph, workspace) != 0) {
+        return INF;
+    }
+    const CSRGraph* csr = &graph->csr;
+    unsigned int epoch;
+    unsigned int* stamp = workspace->stamp;
+    double* g_costs = workspace->distance;
+    int* parents = workspace->previous;
+    MinHeap* open_set = &workspace->heap;
+    
+    begin_search(workspace);
+    epoch = workspace->epoch;
+    stamp[start] = epoch;
+    g_costs[start] = 0.0;
+    parents[start] = -1;
+    insert_heap(open_set, start, heuristic(context, start, end));
+    
+    while (!is_empty(open_set)) {
+        int u = extract_min(open_set).vertex;
+        workspace->settled++;
         
-        in_closed_set[u] = 1;
+        if (u == end) {
+            return g_costs[end];
+        }
         
-        // Explore neighbors
-        Edge* edge = graph[u].edges;
-        while (edge != NULL) {
-            int v = edge->destination;
+        // Explore neighbors; reached vertices no longer queued are closed
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            int reached = stamp[v] == epoch;
             
-            if (!in_closed_set[v] && graph[v].is_active) {
-                double tentative_g = g_costs[u] + edge->current_weight;
+            if ((!reached || in_heap(open_set, v)) && graph->nodes.is_active[v]) {
+                double tentative_g = g_costs[u] + csr->weights[e];
                 
-                if (tentative_g < g_costs[v]) {
+                if (!reached || tentative_g < g_costs[v]) {
+                    stamp[v] = epoch;
                     g_costs[v] = tentative_g;
                     parents[v] = u;
-                    double h = heuristic_distance(v, end);
-                    insert_heap_astar(&open_set, v, tentative_g, h, u);
+                    double h = heuristic(context, v, end);
+                    insert_heap(open_set, v, tentative_g + h); // f = g + h
                 }
             }
-            edge = edge->next;
         }
     }
+    return INF;
+}
+
+int astar_pathfind(const Graph* graph, int start, int end, int path[], double* total_cost) {
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
     
-    printf("❌ No path found!\n");
-    return 0;
+    clock_t start_time = clock();
+    
+    SearchWorkspace workspace;
+    if (init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate A* search state\n");
+        return 0;
+    }
+    
+    printf("Starting A* algorithm: node %d → node %d\n", start, end);
+    
+    int path_length = 0;
+    double cost = astar_search(graph, &workspace, start, end);
+    if (cost < INF) {
+        path_length = workspace_path(&workspace, end, path);
+        *total_cost = cost;
+        
+        clock_t end_time = clock();
+        double calc_time = ((double)(end_time - start_time)) / CLOCKS_PER_SEC;
+        
+        printf("✅ A* completed! Distance: %.2f km\n", *total_cost);
+        printf("   Nodes explored: %d, Time: %.4fs\n", workspace.settled, calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+    
+    free_search_workspace(&workspace);
+    return path_length;
 }
 
 int reconstruct_path(int end, int previous[], int path[]) {
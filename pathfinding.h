@@ -1,42 +1,133 @@
 /**
  * pathfinding.h
- * Pathfinding algorithms (Dijkstra and A*)
+ * Pathfinding algorithms (Dijkstra, bidirectional Dijkstra and A*)
  */
 
 #ifndef PATHFINDING_H
 #define PATHFINDING_H
 
 #include "gps_types.h"
+#include "graph.h"
+#include "search_workspace.h"
 
 /**
- * Find shortest path using Dijkstra's algorithm
+ * Dijkstra's algorithm on a reusable workspace: no allocation, and setup
+ * costs O(1) instead of O(node_count), so short queries pay only for the
+ * vertices they touch. Quiet; results stay in the workspace until its next
+ * search (workspace_distance, workspace_previous, workspace_path).
+ * @param end Target vertex, or -1 to search the whole graph
+ * @return Distance to end in km, INF if it was not reached
+ */
+double dijkstra_search(const Graph* graph, SearchWorkspace* workspace, int start, int end);
+
+/**
+ * Dijkstra over the reverse CSR from end to every vertex that can reach
+ * it: afterwards workspace_distance(workspace, v) is the distance from v
+ * to end and workspace_previous the next vertex towards end
+ */
+void reverse_dijkstra_search(const Graph* graph, SearchWorkspace* workspace, int end);
+
+/**
+ * Lower bound on the distance in km from v to target used to order A*;
+ * context is passed through unchanged from astar_search_with
+ */
+typedef double (*AStarHeuristic)(const void* context, int v, int target);
+
+/**
+ * The default AStarHeuristic: straight-line distance to target
+ * @param graph The Graph being searched
+ */
+double straight_line_heuristic(const void* graph, int v, int target);
+
+/**
+ * A* on a reusable workspace, as dijkstra_search, with the straight-line
+ * heuristic; the workspace holds the g costs and parents
+ * @return Path cost in km, INF if there is no path
+ */
+double astar_search(const Graph* graph, SearchWorkspace* workspace, int start, int end);
+
+/**
+ * A* with another heuristic (e.g. landmark_heuristic). Paths are shortest
+ * as long as the heuristic never overestimates.
+ * @return Path cost in km, INF if there is no path
+ */
+double astar_search_with(const Graph* graph, SearchWorkspace* workspace, int start, int end,
+                         AStarHeuristic heuristic, const void* context);
+
+/**
+ * Find shortest path using Dijkstra's algorithm. The graph must be frozen.
+ * @param graph Frozen road network (only read, so may be shared by threads)
  * @param start Starting vertex index
  * @param end Ending vertex index
- * @param distances Array to store distances to each vertex
- * @param previous Array to store previous vertex in shortest path
+ * @param distances Array to store distances to each vertex (node_count entries)
+ * @param previous Array to store previous vertex in shortest path (node_count entries)
+ */
+void dijkstra(const Graph* graph, int start, int end, double distances[], int previous[]);
+
+/**
+ * Dijkstra's algorithm on weights quantized to integer units
+ * (WEIGHT_UNITS_PER_KM, i.e. metres) with a monotone radix heap instead of
+ * the comparison-based binary heap. Fills the same outputs as dijkstra();
+ * distances[] hold the exact km of the chosen paths, which may differ from
+ * dijkstra()'s only between routes within rounding (half a metre per edge).
  */
-void dijkstra(int start, int end, double distances[], int previous[]);
+void dijkstra_radix(const Graph* graph, int start, int end, double distances[], int previous[]);
 
 /**
- * Find shortest path using A* algorithm
+ * Find shortest path using A* algorithm. The graph must be frozen.
+ * @param graph Frozen road network (only read, so may be shared by threads)
  * @param start Starting vertex index
  * @param end Ending vertex index
- * @param path Array to store the path vertices
+ * @param path Array to store the path vertices (node_count entries)
+ * @param total_cost Pointer to store total path cost
+ * @return Length of the path (number of vertices)
+ */
+int astar_pathfind(const Graph* graph, int start, int end, int path[], double* total_cost);
+
+/**
+ * Bidirectional Dijkstra on two reusable workspaces: forward grows from
+ * start over the CSR, backward grows from end over the reverse CSR, always
+ * expanding the side with the smaller queue. Stops as soon as the two
+ * queue minima sum to at least the best start-end distance found, which
+ * keeps the result exact on directed graphs. Quiet, as dijkstra_search;
+ * settled counts are left in each workspace.
+ * @param meeting Set to the vertex where the best path crosses from the
+ *                forward tree to the backward tree, -1 if there is no path
+ * @return Distance from start to end in km, INF if there is no path
+ */
+double bidirectional_search(const Graph* graph, SearchWorkspace* forward,
+                            SearchWorkspace* backward, int start, int end, int* meeting);
+
+/**
+ * Copy the path found by the last bidirectional_search into path[]:
+ * start to meeting along the forward tree, then on to end along the
+ * backward tree
+ * @return Number of vertices, 0 if meeting is -1
+ */
+int bidirectional_path(const SearchWorkspace* forward, const SearchWorkspace* backward,
+                       int meeting, int path[]);
+
+/**
+ * Find shortest path using bidirectional Dijkstra. The graph must be frozen.
+ * Prints the nodes settled by each direction.
+ * @param path Array to store the path vertices (node_count entries)
  * @param total_cost Pointer to store total path cost
+ * @param nodes_settled Set to the nodes settled by both directions together
  * @return Length of the path (number of vertices)
  */
-int astar_pathfind(int start, int end, int path[], double* total_cost);
+int bidirectional_pathfind(const Graph* graph, int start, int end, int path[], double* total_cost,
+                           int* nodes_settled);
 
 /**
  * Heuristic function for A* (straight-line distance to goal)
  */
-double heuristic_distance(int from, int to);
+double heuristic_distance(const Graph* graph, int from, int to);
 
 /**
  * Reconstruct path from previous array
  * @param end End vertex
  * @param previous Array of previous vertices
- * @param path Array to store reconstructed path
+ * @param path Array to store reconstructed path (node_count entries)
  * @return Length of the path
  */
 int reconstruct_path(int end, int previous[], int path[]);
@@ -0,0 +1,109 @@
+/**
+ * radix_heap.c
+ * Monotone radix heap implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "radix_heap.h"
+
+// Bucket of a key relative to last: 0 if equal, else 1 + highest differing bit
+static int bucket_index(uint32_t key, uint32_t last) {
+    uint32_t diff = key ^ last;
+    if (diff == 0) {
+        return 0;
+    }
+#if defined(__GNUC__)
+    return 32 - __builtin_clz(diff);
+#else
+    int index = 0;
+    while (diff) {
+        index++;
+        diff >>= 1;
+    }
+    return index;
+#endif
+}
+
+static int append_entry(RadixHeap* heap, int bucket, RadixEntry entry) {
+    if (heap->bucket_size[bucket] == heap->bucket_capacity[bucket]) {
+        int new_capacity = heap->bucket_capacity[bucket] > 0 ? heap->bucket_capacity[bucket] * 2 : 64;
+        RadixEntry* entries = realloc(heap->buckets[bucket], (size_t)new_capacity * sizeof(RadixEntry));
+        if (!entries) {
+            return -1;
+        }
+        heap->buckets[bucket] = entries;
+        heap->bucket_capacity[bucket] = new_capacity;
+    }
+    heap->buckets[bucket][heap->bucket_size[bucket]++] = entry;
+    return 0;
+}
+
+void init_radix_heap(RadixHeap* heap) {
+    memset(heap, 0, sizeof(RadixHeap));
+}
+
+void free_radix_heap(RadixHeap* heap) {
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        free(heap->buckets[b]);
+    }
+    memset(heap, 0, sizeof(RadixHeap));
+}
+
+void clear_radix_heap(RadixHeap* heap) {
+    for (int b = 0; b < RADIX_BUCKETS; b++) {
+        heap->bucket_size[b] = 0;
+    }
+    heap->size = 0;
+    heap->last = 0;
+}
+
+int radix_heap_push(RadixHeap* heap, uint32_t key, int vertex) {
+    if (key < heap->last) {
+        return -1;
+    }
+    RadixEntry entry = { key, vertex };
+    if (append_entry(heap, bucket_index(key, heap->last), entry) != 0) {
+        return -1;
+    }
+    heap->size++;
+    heap->pushes++;
+    return 0;
+}
+
+int radix_heap_pop(RadixHeap* heap, uint32_t* key) {
+    if (heap->size == 0) {
+        return -1;
+    }
+
+    if (heap->bucket_size[0] == 0) {
+        // Move last up to the smallest key of the first non-empty bucket and
+        // spread that bucket over the lower ones; each entry only moves down
+        int b = 1;
+        while (heap->bucket_size[b] == 0) {
+            b++;
+        }
+        RadixEntry* entries = heap->buckets[b];
+        int count = heap->bucket_size[b];
+        uint32_t minimum = entries[0].key;
+        for (int i = 1; i < count; i++) {
+            if (entries[i].key < minimum) {
+                minimum = entries[i].key;
+            }
+        }
+        heap->last = minimum;
+        heap->bucket_size[b] = 0;
+        for (int i = 0; i < count; i++) {
+            // Entries land in buckets below b, so entries[] is not reallocated
+            if (append_entry(heap, bucket_index(entries[i].key, minimum), entries[i]) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    RadixEntry entry = heap->buckets[0][--heap->bucket_size[0]];
+    heap->size--;
+    heap->pops++;
+    *key = entry.key;
+    return entry.vertex;
+}
@@ -0,0 +1,43 @@
+/**
+ * radix_heap.h
+ * Monotone radix heap for Dijkstra over integer-quantized weights
+ */
+
+#ifndef RADIX_HEAP_H
+#define RADIX_HEAP_H
+
+#include "gps_types.h"
+
+/**
+ * Initialize an empty radix heap (buckets grow on demand)
+ */
+void init_radix_heap(RadixHeap* heap);
+
+/**
+ * Release the memory held by a radix heap
+ */
+void free_radix_heap(RadixHeap* heap);
+
+/**
+ * Remove all entries and reset the minimum key to 0, keeping the buckets
+ */
+void clear_radix_heap(RadixHeap* heap);
+
+/**
+ * Queue a vertex. There is no decrease-key: a vertex whose key drops is
+ * pushed again and the caller skips the stale entry when it comes out.
+ * @param key Must not be below the key most recently popped
+ * @return 0 on success, -1 if the key is too small or a bucket could not grow
+ */
+int radix_heap_push(RadixHeap* heap, uint32_t key, int vertex);
+
+/**
+ * Extract an entry with the minimum key in amortized O(log C) for key
+ * range C
+ * @param key Receives the entry's key
+ * @return The entry's vertex, or -1 if the heap is empty or a bucket could
+ *         not grow (the heap must then be cleared before reuse)
+ */
+int radix_heap_pop(RadixHeap* heap, uint32_t* key);
+
+#endif // RADIX_HEAP_H
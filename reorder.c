@@ -0,0 +1,139 @@
+/**
+ * reorder.c
+ * Locality-preserving node renumbering implementation
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "reorder.h"
+#include "graph.h"
+
+#define HILBERT_BITS 16
+
+typedef struct {
+    unsigned int key;
+    int node;
+} SortKey;
+
+// Position of (x, y) along a Hilbert curve over a 2^16 x 2^16 grid
+static unsigned int hilbert_key(unsigned int x, unsigned int y) {
+    const unsigned int n = 1u << HILBERT_BITS;
+    unsigned int d = 0;
+    for (unsigned int s = n / 2; s > 0; s /= 2) {
+        unsigned int rx = (x & s) > 0;
+        unsigned int ry = (y & s) > 0;
+        d += s * s * ((3 * rx) ^ ry);
+        
+        // Rotate the quadrant so the curve stays continuous
+        if (ry == 0) {
+            if (rx == 1) {
+                x = n - 1 - x;
+                y = n - 1 - y;
+            }
+            unsigned int t = x;
+            x = y;
+            y = t;
+        }
+    }
+    return d;
+}
+
+static int compare_keys(const void* a, const void* b) {
+    const SortKey* ka = a;
+    const SortKey* kb = b;
+    if (ka->key != kb->key) return ka->key < kb->key ? -1 : 1;
+    return ka->node - kb->node;
+}
+
+// Scale a coordinate into [0, 2^16) across the graph's bounding box
+static unsigned int grid_coordinate(double value, double min, double max) {
+    if (max <= min) {
+        return 0;
+    }
+    double scaled = (value - min) / (max - min) * ((1u << HILBERT_BITS) - 1);
+    return (unsigned int)(scaled + 0.5);
+}
+
+static int hilbert_order(const Graph* graph, int* new_index) {
+    SortKey* keys = malloc((size_t)graph->node_count * sizeof(SortKey));
+    if (!keys) {
+        return -1;
+    }
+    
+    double min_lat = graph->nodes.latitude[0], max_lat = min_lat;
+    double min_lon = graph->nodes.longitude[0], max_lon = min_lon;
+    for (int i = 1; i < graph->node_count; i++) {
+        if (graph->nodes.latitude[i] < min_lat) min_lat = graph->nodes.latitude[i];
+        if (graph->nodes.latitude[i] > max_lat) max_lat = graph->nodes.latitude[i];
+        if (graph->nodes.longitude[i] < min_lon) min_lon = graph->nodes.longitude[i];
+        if (graph->nodes.longitude[i] > max_lon) max_lon = graph->nodes.longitude[i];
+    }
+    
+    for (int i = 0; i < graph->node_count; i++) {
+        keys[i].key = hilbert_key(grid_coordinate(graph->nodes.longitude[i], min_lon, max_lon),
+                                  grid_coordinate(graph->nodes.latitude[i], min_lat, max_lat));
+        keys[i].node = i;
+    }
+    qsort(keys, (size_t)graph->node_count, sizeof(SortKey), compare_keys);
+    
+    for (int i = 0; i < graph->node_count; i++) {
+        new_index[keys[i].node] = i;
+    }
+    free(keys);
+    return 0;
+}
+
+// Number nodes in BFS visit order, starting a new search per component
+static int bfs_order(const Graph* graph, int* new_index) {
+    int* queue = malloc((size_t)graph->node_count * sizeof(int));
+    if (!queue) {
+        return -1;
+    }
+    
+    for (int i = 0; i < graph->node_count; i++) {
+        new_index[i] = -1;
+    }
+    
+    int next = 0;
+    for (int root = 0; root < graph->node_count; root++) {
+        if (new_index[root] != -1) {
+            continue;
+        }
+        int head = next;
+        queue[next] = root;
+        new_index[root] = next++;
+        
+        while (head < next) {
+            int u = queue[head++];
+            for (Edge* edge = graph->edge_lists[u]; edge != NULL; edge = edge->next) {
+                if (new_index[edge->destination] == -1) {
+                    queue[next] = edge->destination;
+                    new_index[edge->destination] = next++;
+                }
+            }
+        }
+    }
+    free(queue);
+    return 0;
+}
+
+int reorder_graph(Graph* graph, NodeOrder order) {
+    if (graph->node_count == 0) {
+        return 0;
+    }
+    
+    int* new_index = malloc((size_t)graph->node_count * sizeof(int));
+    if (!new_index) {
+        printf("Error: Out of memory while renumbering nodes\n");
+        return -1;
+    }
+    
+    int result = order == ORDER_BFS ? bfs_order(graph, new_index) : hilbert_order(graph, new_index);
+    if (result == 0) {
+        result = apply_node_permutation(graph, new_index);
+    } else {
+        printf("Error: Out of memory while renumbering nodes\n");
+    }
+    free(new_index);
+    return result;
+}
@@ -0,0 +1,26 @@
+/**
+ * reorder.h
+ * Locality-preserving node renumbering
+ */
+
+#ifndef REORDER_H
+#define REORDER_H
+
+#include "graph.h"
+
+// Node numbering strategies for reorder_graph
+typedef enum {
+    ORDER_HILBERT,      // Along a Hilbert curve over latitude/longitude
+    ORDER_BFS           // Breadth-first over the road network
+} NodeOrder;
+
+/**
+ * Renumber nodes so that neighbours in the network sit close together in
+ * memory, which cuts cache misses per settled node on large imported
+ * graphs. Location.id values are kept; node indices change, so use
+ * original_node_index/current_node_index to translate saved indices.
+ * @return 0 on success, -1 if memory could not be allocated
+ */
+int reorder_graph(Graph* graph, NodeOrder order);
+
+#endif // REORDER_H
@@ -0,0 +1,77 @@
+/**
+ * search_workspace.c
+ * Reusable per-thread search state implementation
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "search_workspace.h"
+#include "heap.h"
+
+int init_search_workspace(SearchWorkspace* workspace, int node_count) {
+    memset(workspace, 0, sizeof(SearchWorkspace));
+    if (node_count < 1) {
+        node_count = 1;
+    }
+    workspace->stamp = calloc((size_t)node_count, sizeof(unsigned int));
+    workspace->distance = malloc((size_t)node_count * sizeof(double));
+    workspace->previous = malloc((size_t)node_count * sizeof(int));
+    if (!workspace->stamp || !workspace->distance || !workspace->previous ||
+        init_heap(&workspace->heap, node_count) != 0) {
+        free_search_workspace(workspace);
+        return -1;
+    }
+    workspace->node_count = node_count;
+    return 0;
+}
+
+void free_search_workspace(SearchWorkspace* workspace) {
+    free(workspace->stamp);
+    free(workspace->distance);
+    free(workspace->previous);
+    free_heap(&workspace->heap);
+    memset(workspace, 0, sizeof(SearchWorkspace));
+}
+
+void begin_search(SearchWorkspace* workspace) {
+    workspace->epoch++;
+    if (workspace->epoch == 0) {
+        // Wrapped around: stamps from 2^32 searches ago would look current
+        memset(workspace->stamp, 0, (size_t)workspace->node_count * sizeof(unsigned int));
+        workspace->epoch = 1;
+    }
+    clear_heap(&workspace->heap);
+    workspace->settled = 0;
+}
+
+double workspace_distance(const SearchWorkspace* workspace, int v) {
+    if (v < 0 || v >= workspace->node_count || workspace->stamp[v] != workspace->epoch) {
+        return INF;
+    }
+    return workspace->distance[v];
+}
+
+int workspace_previous(const SearchWorkspace* workspace, int v) {
+    if (v < 0 || v >= workspace->node_count || workspace->stamp[v] != workspace->epoch) {
+        return -1;
+    }
+    return workspace->previous[v];
+}
+
+int workspace_path(const SearchWorkspace* workspace, int end, int path[]) {
+    if (workspace_distance(workspace, end) >= INF) {
+        return 0;
+    }
+    int path_length = 0;
+    for (int v = end; v != -1; v = workspace->previous[v]) {
+        path[path_length++] = v;
+    }
+    
+    // Reverse path
+    for (int i = 0; i < path_length / 2; i++) {
+        int temp = path[i];
+        path[i] = path[path_length - 1 - i];
+        path[path_length - 1 - i] = temp;
+    }
+    return path_length;
+}
@@ -0,0 +1,48 @@
+/**
+ * search_workspace.h
+ * Reusable per-thread search state with O(1) reset
+ */
+
+#ifndef SEARCH_WORKSPACE_H
+#define SEARCH_WORKSPACE_H
+
+#include "gps_types.h"
+
+/**
+ * Allocate a workspace for searches on graphs of node_count nodes. All
+ * memory is allocated here, so searches using it never allocate. One
+ * workspace serves one thread; create one per worker thread.
+ * @return 0 on success, -1 if memory could not be allocated
+ */
+int init_search_workspace(SearchWorkspace* workspace, int node_count);
+
+/**
+ * Release the memory held by a workspace
+ */
+void free_search_workspace(SearchWorkspace* workspace);
+
+/**
+ * Forget the previous search: bumps the epoch and empties the heap, in
+ * time proportional to the entries the last search left queued rather
+ * than to node_count (stamps are cleared once every 2^32 searches)
+ */
+void begin_search(SearchWorkspace* workspace);
+
+/**
+ * Distance (or g cost) the last search reached vertex v with, INF if it
+ * was not reached
+ */
+double workspace_distance(const SearchWorkspace* workspace, int v);
+
+/**
+ * Predecessor of v on the last search's tree, -1 if none
+ */
+int workspace_previous(const SearchWorkspace* workspace, int v);
+
+/**
+ * Copy the last search's path from its start to end into path[]
+ * @return Number of vertices, 0 if end was not reached
+ */
+int workspace_path(const SearchWorkspace* workspace, int end, int path[]);
+
+#endif // SEARCH_WORKSPACE_H
@@ -0,0 +1,109 @@
+/**
+ * string_table.c
+ * String interning implementation (FNV-1a hash, linear probing)
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "string_table.h"
+
+#define INITIAL_SLOT_COUNT 16
+
+static unsigned int hash_string(const char* text) {
+    unsigned int hash = 2166136261u;
+    while (*text) {
+        hash ^= (unsigned char)*text++;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Slot holding `text`, or the empty slot where it would be inserted
+static int probe(const StringTable* table, const char* text) {
+    int mask = table->slot_count - 1;
+    int slot = (int)(hash_string(text) & (unsigned int)mask);
+    while (table->slots[slot] != 0 &&
+           strcmp(table->strings[table->slots[slot] - 1], text) != 0) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+static int rehash(StringTable* table, int slot_count) {
+    int* slots = calloc((size_t)slot_count, sizeof(int));
+    if (!slots) {
+        return -1;
+    }
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    for (int id = 0; id < table->count; id++) {
+        table->slots[probe(table, table->strings[id])] = id + 1;
+    }
+    return 0;
+}
+
+void init_string_table(StringTable* table) {
+    table->strings = NULL;
+    table->count = 0;
+    table->capacity = 0;
+    table->slots = NULL;
+    table->slot_count = 0;
+}
+
+int find_interned(const StringTable* table, const char* text) {
+    if (table->slot_count == 0) {
+        return -1;
+    }
+    return table->slots[probe(table, text)] - 1;
+}
+
+int intern_string(StringTable* table, const char* text) {
+    int existing = find_interned(table, text);
+    if (existing >= 0) {
+        return existing;
+    }
+    
+    // Keep the load factor at or below one half
+    if ((table->count + 1) * 2 > table->slot_count &&
+        rehash(table, table->slot_count > 0 ? table->slot_count * 2 : INITIAL_SLOT_COUNT) != 0) {
+        return -1;
+    }
+    if (table->count == table->capacity) {
+        int capacity = table->capacity > 0 ? table->capacity * 2 : INITIAL_SLOT_COUNT;
+        char** strings = realloc(table->strings, (size_t)capacity * sizeof(char*));
+        if (!strings) {
+            return -1;
+        }
+        table->strings = strings;
+        table->capacity = capacity;
+    }
+    
+    size_t length = strlen(text);
+    char* copy = malloc(length + 1);
+    if (!copy) {
+        return -1;
+    }
+    memcpy(copy, text, length + 1);
+    
+    int id = table->count++;
+    table->strings[id] = copy;
+    table->slots[probe(table, text)] = id + 1;
+    return id;
+}
+
+const char* interned_string(const StringTable* table, int id) {
+    if (id >= 0 && id < table->count) {
+        return table->strings[id];
+    }
+    return "";
+}
+
+void free_string_table(StringTable* table) {
+    for (int i = 0; i < table->count; i++) {
+        free(table->strings[i]);
+    }
+    free(table->strings);
+    free(table->slots);
+    init_string_table(table);
+}
@@ -0,0 +1,46 @@
+/**
+ * string_table.h
+ * String interning: maps category names to small, stable integer IDs
+ */
+
+#ifndef STRING_TABLE_H
+#define STRING_TABLE_H
+
+// Interned strings, looked up through an open-addressing hash of IDs
+typedef struct {
+    char** strings;     // ID -> string
+    int count;
+    int capacity;
+    int* slots;         // Hash slots holding ID + 1 (0 = empty)
+    int slot_count;     // Power of two
+} StringTable;
+
+/**
+ * Initialize an empty table
+ */
+void init_string_table(StringTable* table);
+
+/**
+ * Return the ID of `text`, adding it if it has not been seen before.
+ * IDs are assigned densely from 0 in first-seen order.
+ * @return ID, or -1 if memory could not be allocated
+ */
+int intern_string(StringTable* table, const char* text);
+
+/**
+ * Look up an existing string without adding it
+ * @return ID, or -1 if `text` was never interned
+ */
+int find_interned(const StringTable* table, const char* text);
+
+/**
+ * Get the string for an ID ("" for unknown IDs)
+ */
+const char* interned_string(const StringTable* table, int id);
+
+/**
+ * Release all memory held by the table
+ */
+void free_string_table(StringTable* table);
+
+#endif // STRING_TABLE_H
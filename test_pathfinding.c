@@ -0,0 +1,1398 @@
+// test_pathfinding.c - Differential tests for the TrackMate search engines
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "gps_types.h"
+#include "graph.h"
+#include "heap.h"
+#include "radix_heap.h"
+#include "pathfinding.h"
+#include "data_loader.h"
+#include "contraction.h"
+#include "landmarks.h"
+#include "overlay.h"
+#include "hub_labels.h"
+#include "arc_flags.h"
+#include "distance_matrix.h"
+#include "batch_query.h"
+#include "time_dependent.h"
+#include "alternatives.h"
+#include "traffic.h"
+
+// Test framework macros
+#define TEST_ASSERT(condition, message) \
+    do { \
+        if (!(condition)) { \
+            printf("❌ FAIL: %s\n", message); \
+            return 0; \
+        } else { \
+            printf("✅ PASS: %s\n", message); \
+        } \
+    } while(0)
+
+#define GRID_SIDE 60
+#define TEST_HIERARCHY_FILE "test_hierarchy.tmch"
+#define TEST_LABEL_FILE "test_labels.tmhl"
+#define TEST_MATRIX_FILE "test_matrix.tmdm"
+#define ROUNDING_KM (0.5 / WEIGHT_UNITS_PER_KM)    // Worst rounding error per edge
+
+// Jittered grid with every seventh road missing, so weights differ and
+// shortest paths are not simply straight lines
+static int build_test_grid(Graph* graph, int side) {
+    if (init_graph(graph) != 0 || reserve_nodes(graph, side * side) != 0) {
+        return -1;
+    }
+    srand(7);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            add_location(graph, r * side + c, "grid",
+                         18.90 + r * 0.002 + (rand() % 100) * 0.00001,
+                         72.80 + c * 0.002 + (rand() % 100) * 0.00001);
+        }
+    }
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int u = r * side + c;
+            if (c + 1 < side && rand() % 7 != 0) add_edge(graph, u, u + 1);
+            if (r + 1 < side && rand() % 7 != 0) add_edge(graph, u, u + side);
+        }
+    }
+    return freeze_graph(graph);
+}
+
+// The same grid with every third road one-way, in a random direction
+static int build_one_way_grid(Graph* graph, int side) {
+    if (init_graph(graph) != 0 || reserve_nodes(graph, side * side) != 0) {
+        return -1;
+    }
+    srand(13);
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            add_location(graph, r * side + c, "grid",
+                         18.90 + r * 0.002 + (rand() % 100) * 0.00001,
+                         72.80 + c * 0.002 + (rand() % 100) * 0.00001);
+        }
+    }
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int u = r * side + c;
+            int neighbours[2] = { c + 1 < side ? u + 1 : -1, r + 1 < side ? u + side : -1 };
+            for (int k = 0; k < 2; k++) {
+                int v = neighbours[k];
+                if (v < 0 || rand() % 7 == 0) continue;
+                switch (rand() % 6) {
+                    case 0: add_directed_edge(graph, u, v, "local", 1, 30.0); break;
+                    case 1: add_directed_edge(graph, v, u, "local", 1, 30.0); break;
+                    default: add_edge(graph, u, v);
+                }
+            }
+        }
+    }
+    return freeze_graph(graph);
+}
+
+// Weight of the shortest u -> v edge, or -1 if there is none
+static double edge_weight(const Graph* graph, int u, int v) {
+    const CSRGraph* csr = &graph->csr;
+    double weight = -1.0;
+    for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+        if (csr->targets[e] == v && (weight < 0.0 || csr->weights[e] < weight)) {
+            weight = csr->weights[e];
+        }
+    }
+    return weight;
+}
+
+// Length of the previous[] chain ending at v, or -1 if it is not a path
+// of graph edges back to start
+static double chain_length(const Graph* graph, int start, int v, const int previous[], int* hops) {
+    double length = 0.0;
+    *hops = 0;
+    while (v != start) {
+        int u = previous[v];
+        if (u < 0 || *hops > graph->node_count) {
+            return -1.0;
+        }
+        double weight = edge_weight(graph, u, v);
+        if (weight < 0.0) {
+            return -1.0;
+        }
+        length += weight;
+        (*hops)++;
+        v = u;
+    }
+    return length;
+}
+
+// Full searches from several sources with both engines; counts nodes
+// whose distance or predecessor chain disagrees
+static int compare_searches(const Graph* graph, int sources, int* same_paths) {
+    int n = graph->node_count;
+    double* expected = malloc((size_t)n * sizeof(double));
+    double* actual = malloc((size_t)n * sizeof(double));
+    int* expected_previous = malloc((size_t)n * sizeof(int));
+    int* actual_previous = malloc((size_t)n * sizeof(int));
+    int mismatches = 0;
+    *same_paths = 1;
+    if (!expected || !actual || !expected_previous || !actual_previous) {
+        mismatches = -1;
+        sources = 0;
+    }
+
+    for (int s = 0; s < sources; s++) {
+        int start = (s * 7919) % n;
+        dijkstra(graph, start, -1, expected, expected_previous);
+        dijkstra_radix(graph, start, -1, actual, actual_previous);
+        for (int v = 0; v < n; v++) {
+            if (expected[v] >= INF || actual[v] >= INF) {
+                mismatches += (expected[v] >= INF) != (actual[v] >= INF);
+                continue;
+            }
+            // Each path's integer length is off by at most ROUNDING_KM per edge
+            int hops, expected_hops;
+            double length = chain_length(graph, start, v, actual_previous, &hops);
+            chain_length(graph, start, v, expected_previous, &expected_hops);
+            if (length < 0.0 || fabs(length - actual[v]) > 1e-9 || actual[v] < expected[v] - 1e-9 ||
+                actual[v] > expected[v] + (hops + expected_hops) * ROUNDING_KM + 1e-9) {
+                mismatches++;
+            }
+            if (actual_previous[v] != expected_previous[v]) {
+                *same_paths = 0;
+            }
+        }
+    }
+
+    free(expected);
+    free(actual);
+    free(expected_previous);
+    free(actual_previous);
+    return mismatches;
+}
+
+int test_heap_arities() {
+    printf("\n🧪 Testing d-ary Heap Ordering\n");
+    printf("===============================\n");
+
+    int arities[4] = { 2, 4, 8, 16 };
+    int ordered = 1;
+    for (int a = 0; a < 4 && ordered; a++) {
+        MinHeap heap;
+        if (init_heap_arity(&heap, 1000, arities[a]) != 0) {
+            return 0;
+        }
+        srand(3);
+        for (int v = 0; v < 1000; v++) {
+            // Keys closer than float precision exercise the exact tie-break
+            insert_heap(&heap, v, 100.0 + (rand() % 50) + (rand() % 4) * 1e-9);
+        }
+        for (int i = 0; i < 300; i++) {
+            int v = rand() % 1000;
+            decrease_key(&heap, v, (rand() % 200) * 0.5);
+        }
+        double last = -1.0;
+        int popped = 0;
+        while (!is_empty(&heap)) {
+            PQNode node = extract_min(&heap);
+            if (node.distance < last || in_heap(&heap, node.vertex)) {
+                ordered = 0;
+            }
+            last = node.distance;
+            popped++;
+        }
+        ordered = ordered && popped == 1000;
+        free_heap(&heap);
+    }
+    TEST_ASSERT(ordered, "2/4/8/16-ary heaps pop exact keys in order");
+
+    MinHeap heap;
+    TEST_ASSERT(init_heap_arity(&heap, 10, 3) != 0, "Arity that is not a power of two is rejected");
+    return 1;
+}
+
+int test_radix_heap_order() {
+    printf("\n🧪 Testing Radix Heap Ordering\n");
+    printf("===============================\n");
+
+    RadixHeap heap;
+    init_radix_heap(&heap);
+    srand(11);
+
+    // Dijkstra-like use: every push is at least the key last popped
+    uint32_t last = 0;
+    int ordered = 1, popped = 0;
+    for (int i = 0; i < 64; i++) {
+        radix_heap_push(&heap, (uint32_t)(rand() % 100000), i);
+    }
+    while (heap.size > 0) {
+        uint32_t key;
+        int vertex = radix_heap_pop(&heap, &key);
+        if (vertex < 0 || key < last) {
+            ordered = 0;
+            break;
+        }
+        last = key;
+        popped++;
+        if (popped < 2000) {
+            radix_heap_push(&heap, key + (uint32_t)(rand() % 5000), vertex);
+        }
+    }
+    TEST_ASSERT(ordered, "Keys come out in non-decreasing order");
+    TEST_ASSERT(popped == 2063, "Every pushed entry is popped once");
+    TEST_ASSERT(radix_heap_push(&heap, last - 1, 0) != 0, "Keys below the last popped key are rejected");
+
+    free_radix_heap(&heap);
+    return 1;
+}
+
+int test_enhanced_network_paths() {
+    printf("\n🧪 Testing Radix Heap Dijkstra on the Mumbai Network\n");
+    printf("=====================================================\n");
+
+    Graph graph;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+
+    int same_paths;
+    int mismatches = compare_searches(&graph, graph.node_count, &same_paths);
+    cleanup_graph(&graph);
+
+    TEST_ASSERT(mismatches == 0, "Distances match the binary heap search");
+    TEST_ASSERT(same_paths, "Paths match the binary heap search");
+    return 1;
+}
+
+int test_grid_distances() {
+    printf("\n🧪 Testing Radix Heap Dijkstra on a Jittered Grid\n");
+    printf("==================================================\n");
+
+    Graph graph;
+    if (build_test_grid(&graph, GRID_SIDE) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+
+    int same_paths;
+    int mismatches = compare_searches(&graph, 8, &same_paths);
+    cleanup_graph(&graph);
+
+    printf("Identical predecessor trees: %s\n", same_paths ? "yes" : "no (ties within rounding)");
+    TEST_ASSERT(mismatches == 0, "Paths are valid and optimal within rounding");
+    return 1;
+}
+
+int test_workspace_reuse() {
+    printf("\n🧪 Testing Search Workspace Reuse\n");
+    printf("==================================\n");
+
+    Graph graph;
+    SearchWorkspace workspace;
+    if (build_test_grid(&graph, GRID_SIDE) != 0 ||
+        init_search_workspace(&workspace, graph.node_count) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int n = graph.node_count;
+    double* distances = malloc((size_t)n * sizeof(double));
+    int* previous = malloc((size_t)n * sizeof(int));
+    if (!distances || !previous) {
+        free(distances);
+        free(previous);
+        free_search_workspace(&workspace);
+        cleanup_graph(&graph);
+        return 0;
+    }
+
+    // Start just below the epoch wrap so the stamp reset is exercised too
+    workspace.epoch = 0xFFFFFFFFu - 3;
+    int mismatches = 0;
+    for (int q = 0; q < 8; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 2) % n;
+        dijkstra(&graph, start, -1, distances, previous);
+        double distance = dijkstra_search(&graph, &workspace, start, end);
+        double astar_cost = astar_search(&graph, &workspace, start, end);
+        mismatches += fabs(distance - distances[end]) > 1e-9;
+        mismatches += fabs(astar_cost - distances[end]) > 1e-6;
+
+        // A full search leaves every vertex reached in this epoch only
+        dijkstra_search(&graph, &workspace, start, -1);
+        for (int v = 0; v < n; v++) {
+            mismatches += workspace_distance(&workspace, v) != distances[v];
+        }
+    }
+    TEST_ASSERT(workspace.epoch < 24, "Epoch wrapped around during the test");
+    TEST_ASSERT(mismatches == 0, "Reused workspace matches fresh searches");
+
+    free(distances);
+    free(previous);
+    free_search_workspace(&workspace);
+    cleanup_graph(&graph);
+    return 1;
+}
+
+// Whether path[] runs from start to end over graph edges totalling expected km
+static int path_matches(const Graph* graph, const int path[], int length,
+                        int start, int end, double expected) {
+    double path_km = 0.0;
+    int valid = length > 0 && path[0] == start && path[length - 1] == end;
+    for (int i = 1; i < length && valid; i++) {
+        double weight = edge_weight(graph, path[i - 1], path[i]);
+        valid = weight >= 0.0;
+        path_km += weight;
+    }
+    return valid && fabs(path_km - expected) <= 1e-9;
+}
+
+// Bidirectional distances and paths against one-directional Dijkstra for
+// many start/end pairs, including unreachable ones on one-way grids
+static int compare_bidirectional(const Graph* graph, int queries, int* unreachable) {
+    int n = graph->node_count;
+    SearchWorkspace single, forward, backward;
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!path || init_search_workspace(&single, n) != 0) {
+        free(path);
+        return -1;
+    }
+    if (init_search_workspace(&forward, n) != 0 || init_search_workspace(&backward, n) != 0) {
+        free_search_workspace(&single);
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    *unreachable = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 3) % n;
+        if (q == 0) end = start;
+        double expected = dijkstra_search(graph, &single, start, end);
+        int meeting;
+        double actual = bidirectional_search(graph, &forward, &backward, start, end, &meeting);
+        if (expected >= INF) {
+            (*unreachable)++;
+            mismatches += actual < INF || meeting != -1;
+            continue;
+        }
+        if (fabs(actual - expected) > 1e-9) {
+            mismatches++;
+            continue;
+        }
+
+        int length = bidirectional_path(&forward, &backward, meeting, path);
+        mismatches += !path_matches(graph, path, length, start, end, expected);
+    }
+
+    free_search_workspace(&single);
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    free(path);
+    return mismatches;
+}
+
+// Hierarchy queries and unpacked paths against Dijkstra, as above
+static int compare_hierarchy(const Graph* graph, const ContractionHierarchy* ch, int queries) {
+    int n = graph->node_count;
+    SearchWorkspace single, forward, backward;
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!path || init_search_workspace(&single, n) != 0) {
+        free(path);
+        return -1;
+    }
+    if (init_search_workspace(&forward, n) != 0 || init_search_workspace(&backward, n) != 0) {
+        free_search_workspace(&single);
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 3) % n;
+        if (q == 0) end = start;
+        double expected = dijkstra_search(graph, &single, start, end);
+        int meeting;
+        double actual = ch_search(ch, &forward, &backward, start, end, &meeting);
+        if (expected >= INF) {
+            mismatches += actual < INF || meeting != -1;
+        } else if (fabs(actual - expected) > 1e-9) {
+            mismatches++;
+        } else {
+            int length = ch_path(ch, &forward, &backward, meeting, path);
+            mismatches += !path_matches(graph, path, length, start, end, expected);
+        }
+    }
+
+    free_search_workspace(&single);
+    free_search_workspace(&forward);
+    free_search_workspace(&backward);
+    free(path);
+    return mismatches;
+}
+
+// ALT distances and paths against Dijkstra, as above, then the bound
+// from a few sources to every node against the true distance
+static int compare_landmarks(const Graph* graph, const LandmarkSet* set, int queries,
+                             int* overestimates) {
+    int n = graph->node_count;
+    SearchWorkspace single, workspace;
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!path || init_search_workspace(&single, n) != 0) {
+        free(path);
+        return -1;
+    }
+    if (init_search_workspace(&workspace, n) != 0) {
+        free_search_workspace(&single);
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 3) % n;
+        if (q == 0) end = start;
+        double expected = dijkstra_search(graph, &single, start, end);
+        LandmarkQuery query;
+        init_landmark_query(&query, set, start, end, q % (MAX_ACTIVE_LANDMARKS + 1));
+        double actual = astar_search_with(graph, &workspace, start, end, landmark_heuristic, &query);
+        if (expected >= INF) {
+            mismatches += actual < INF;
+        } else if (fabs(actual - expected) > 1e-9) {
+            mismatches++;
+        } else {
+            int length = workspace_path(&workspace, end, path);
+            mismatches += !path_matches(graph, path, length, start, end, expected);
+        }
+    }
+
+    *overestimates = 0;
+    for (int s = 0; s < 5; s++) {
+        int source = (s * 104729) % n;
+        dijkstra_search(graph, &single, source, -1);
+        for (int v = 0; v < n; v++) {
+            LandmarkQuery query;
+            init_landmark_query(&query, set, source, v, MAX_ACTIVE_LANDMARKS);
+            *overestimates += landmark_heuristic(&query, source, v) > workspace_distance(&single, v);
+        }
+    }
+
+    free_search_workspace(&single);
+    free_search_workspace(&workspace);
+    free(path);
+    return mismatches;
+}
+
+// Overlay distances and expanded paths against Dijkstra, as above
+static int compare_overlay(const Graph* graph, const MultiLevelOverlay* overlay, int queries) {
+    int n = graph->node_count;
+    SearchWorkspace single, workspace, scratch;
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!path || init_search_workspace(&single, n) != 0) {
+        free(path);
+        return -1;
+    }
+    if (init_search_workspace(&workspace, n) != 0 || init_search_workspace(&scratch, n) != 0) {
+        free_search_workspace(&single);
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 3) % n;
+        if (q == 0) end = start;
+        double expected = dijkstra_search(graph, &single, start, end);
+        double actual = overlay_search(graph, overlay, &workspace, start, end);
+        if (expected >= INF) {
+            mismatches += actual < INF;
+        } else if (fabs(actual - expected) > 1e-9) {
+            mismatches++;
+        } else {
+            int length = overlay_path(graph, overlay, &workspace, &scratch, start, end, path);
+            mismatches += !path_matches(graph, path, length, start, end, expected);
+        }
+    }
+
+    free_search_workspace(&single);
+    free_search_workspace(&workspace);
+    free_search_workspace(&scratch);
+    free(path);
+    return mismatches;
+}
+
+// Label distances (SSE2 and scalar merges) and retrieved paths against
+// Dijkstra, as above
+static int compare_hub_labels(const Graph* graph, const HubLabels* labels, int queries) {
+    int n = graph->node_count;
+    SearchWorkspace single;
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!path || init_search_workspace(&single, n) != 0) {
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 3) % n;
+        if (q == 0) end = start;
+        double expected = dijkstra_search(graph, &single, start, end);
+        double actual = hub_label_distance(labels, start, end);
+        mismatches += hub_label_distance_scalar(labels, start, end) != actual;
+        if (expected >= INF) {
+            mismatches += actual < INF || hub_label_path(graph, labels, start, end, path) != 0;
+        } else if (fabs(actual - expected) > 1e-9) {
+            mismatches++;
+        } else {
+            int length = hub_label_path(graph, labels, start, end, path);
+            mismatches += !path_matches(graph, path, length, start, end, expected);
+        }
+    }
+
+    free_search_workspace(&single);
+    free(path);
+    return mismatches;
+}
+
+// Pruned Dijkstra and A* distances and paths against Dijkstra, as above
+static int compare_arc_flags(const Graph* graph, const ArcFlags* flags, int queries) {
+    int n = graph->node_count;
+    SearchWorkspace single, workspace;
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!path || init_search_workspace(&single, n) != 0) {
+        free(path);
+        return -1;
+    }
+    if (init_search_workspace(&workspace, n) != 0) {
+        free_search_workspace(&single);
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n, end = (q * 104729 + n / 3) % n;
+        if (q == 0) end = start;
+        double expected = dijkstra_search(graph, &single, start, end);
+        for (int m = 0; m < 2; m++) {
+            double actual = arc_flag_search(graph, flags, &workspace, start, end,
+                                            m == 0 ? NULL : straight_line_heuristic, graph);
+            if (expected >= INF) {
+                mismatches += actual < INF;
+            } else if (fabs(actual - expected) > 1e-9) {
+                mismatches++;
+            } else {
+                int length = workspace_path(&workspace, end, path);
+                mismatches += !path_matches(graph, path, length, start, end, expected);
+            }
+        }
+    }
+
+    free_search_workspace(&single);
+    free_search_workspace(&workspace);
+    free(path);
+    return mismatches;
+}
+
+// Matrix entries against one full Dijkstra per source; entries are floats
+static int compare_matrix(const Graph* graph, const float* matrix, const int* sources, int source_count,
+                          const int* targets, int target_count) {
+    SearchWorkspace single;
+    if (init_search_workspace(&single, graph->node_count) != 0) {
+        return -1;
+    }
+    int mismatches = 0;
+    for (int i = 0; i < source_count; i++) {
+        dijkstra_search(graph, &single, sources[i], -1);
+        for (int j = 0; j < target_count; j++) {
+            double expected = workspace_distance(&single, targets[j]);
+            double actual = matrix[(size_t)i * target_count + j];
+            if (expected >= INF) {
+                mismatches += actual != (float)INF;
+            } else {
+                mismatches += fabs(actual - expected) > 1e-5 * (1.0 + expected);
+            }
+        }
+    }
+    free_search_workspace(&single);
+    return mismatches;
+}
+
+// MatrixRowSink that checks the blocks arrive in order
+static int count_blocks(void* context, int first_row, int row_count, const float* rows) {
+    int* next_row = context;
+    (void)rows;
+    if (first_row != next_row[0]) {
+        return -1;
+    }
+    next_row[0] += row_count;
+    next_row[1]++;
+    return 0;
+}
+
+// Earliest arrivals by relaxing every road until nothing improves
+// (label-correcting, so it does not rely on the FIFO property)
+static int compare_time_dependent(const Graph* graph, const TimeProfiles* profiles, int sources,
+                                  double departure) {
+    const CSRGraph* csr = &graph->csr;
+    int n = graph->node_count;
+    SearchWorkspace workspace;
+    double* arrival = malloc((size_t)n * sizeof(double));
+    int* path = malloc((size_t)n * sizeof(int));
+    if (!arrival || !path || init_search_workspace(&workspace, n) != 0) {
+        free(arrival);
+        free(path);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < sources; q++) {
+        int start = (q * 7919) % n;
+        for (int v = 0; v < n; v++) {
+            arrival[v] = INF;
+        }
+        arrival[start] = departure;
+        for (int changed = 1; changed;) {
+            changed = 0;
+            for (int u = 0; u < n; u++) {
+                if (arrival[u] >= INF) {
+                    continue;
+                }
+                for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+                    double at = arrival[u] + td_edge_minutes(profiles, e, arrival[u]);
+                    if (at < arrival[csr->targets[e]] - 1e-9) {
+                        arrival[csr->targets[e]] = at;
+                        changed = 1;
+                    }
+                }
+            }
+        }
+        for (int k = 0; k < 10; k++) {
+            int end = (q * 104729 + k * 337 + n / 3) % n;
+            double expected = arrival[end] >= INF ? INF : arrival[end] - departure;
+            for (int use_astar = 0; use_astar < 2; use_astar++) {
+                double actual = td_search(graph, profiles, &workspace, start, end, departure, use_astar);
+                if (expected >= INF) {
+                    mismatches += actual < INF;
+                    continue;
+                }
+                mismatches += fabs(actual - expected) > 1e-6;
+                // Replaying the route from the departure gives the same time
+                int length = workspace_path(&workspace, end, path);
+                double t = departure;
+                for (int i = 1; i < length; i++) {
+                    for (int e = csr->offsets[path[i - 1]]; e < csr->offsets[path[i - 1] + 1]; e++) {
+                        if (csr->targets[e] == path[i]) {
+                            t += td_edge_minutes(profiles, e, t);
+                            break;
+                        }
+                    }
+                }
+                mismatches += length == 0 || fabs(t - departure - actual) > 1e-6;
+            }
+        }
+    }
+
+    free_search_workspace(&workspace);
+    free(arrival);
+    free(path);
+    return mismatches;
+}
+
+// Every route find_alternatives returns against Dijkstra: the first is
+// shortest; the others are simple paths within the stretch bound whose
+// legs to and from the via vertex are shortest paths, sharing no more
+// than allowed with the routes before them. Counts broken routes.
+static int compare_alternatives(const Graph* graph, int queries, int* with_alternatives) {
+    int n = graph->node_count;
+    SearchWorkspace from_start, to_end;
+    AlternativeWorkspace workspace;
+    unsigned char* visited = calloc((size_t)n, 1);
+    *with_alternatives = 0;
+    if (!visited || init_search_workspace(&from_start, n) != 0) {
+        free(visited);
+        return -1;
+    }
+    if (init_search_workspace(&to_end, n) != 0) {
+        free_search_workspace(&from_start);
+        free(visited);
+        return -1;
+    }
+    if (init_alternative_workspace(&workspace, n) != 0) {
+        free_search_workspace(&from_start);
+        free_search_workspace(&to_end);
+        free(visited);
+        return -1;
+    }
+
+    int mismatches = 0;
+    for (int q = 0; q < queries; q++) {
+        int start = (q * 7919) % n;
+        int end = (q * 104729 + n / 2) % n;
+        dijkstra_search(graph, &from_start, start, -1);
+        reverse_dijkstra_search(graph, &to_end, end);
+        double shortest = workspace_distance(&from_start, end);
+
+        int count = find_alternatives(graph, &workspace, start, end, MAX_ALTERNATIVE_ROUTES);
+        if (shortest >= INF) {
+            mismatches += count != 0;
+            continue;
+        }
+        const AlternativeRoute* routes = workspace.routes;
+        mismatches += count < 1 || !path_matches(graph, routes[0].path, routes[0].length, start, end, shortest);
+        *with_alternatives += count > 1;
+
+        for (int r = 1; r < count; r++) {
+            const AlternativeRoute* route = &routes[r];
+            int simple = path_matches(graph, route->path, route->length, start, end, route->distance);
+            for (int i = 0; i < route->length && simple; i++) {
+                simple = !visited[route->path[i]];
+                visited[route->path[i]] = 1;
+            }
+            for (int i = 0; i < route->length; i++) {
+                visited[route->path[i]] = 0;
+            }
+
+            // Leg lengths either side of via, and km on earlier routes
+            double before = 0.0, shared = 0.0;
+            int passed_via = route->path[0] == route->via;
+            for (int i = 1; i < route->length; i++) {
+                int u = route->path[i - 1], v = route->path[i];
+                double weight = edge_weight(graph, u, v);
+                if (!passed_via) {
+                    before += weight;
+                }
+                passed_via = passed_via || v == route->via;
+                for (int k = 0; k < r; k++) {
+                    int on_route = 0;
+                    for (int j = 1; j < routes[k].length && !on_route; j++) {
+                        on_route = routes[k].path[j - 1] == u && routes[k].path[j] == v;
+                    }
+                    if (on_route) {
+                        shared += weight;
+                        break;
+                    }
+                }
+            }
+            double after = route->distance - before;
+
+            mismatches += !simple || !passed_via ||
+                          route->distance > shortest * (1.0 + ALTERNATIVE_STRETCH) + 1e-9 ||
+                          fabs(before - workspace_distance(&from_start, route->via)) > 1e-9 ||
+                          fabs(after - workspace_distance(&to_end, route->via)) > 1e-9 ||
+                          fabs(shared - route->shared) > 1e-9 ||
+                          shared > shortest * ALTERNATIVE_SHARING + 1e-9 ||
+                          route->plateau < shortest * ALTERNATIVE_PLATEAU;
+        }
+    }
+
+    free_alternative_workspace(&workspace);
+    free_search_workspace(&from_start);
+    free_search_workspace(&to_end);
+    free(visited);
+    return mismatches;
+}
+
+int test_contraction_hierarchy() {
+    printf("\n🧪 Testing Contraction Hierarchies\n");
+    printf("==================================\n");
+
+    Graph graph;
+    ContractionHierarchy ch, loaded;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    if (build_contraction_hierarchy(&graph, &ch, 1) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int mismatches = compare_hierarchy(&graph, &ch, graph.node_count * graph.node_count);
+    free_contraction_hierarchy(&ch);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network distances and unpacked paths match Dijkstra");
+
+    // Several threads contract each round's independent nodes
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || build_contraction_hierarchy(&graph, &ch, 3) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_hierarchy(&graph, &ch, 300);
+    TEST_ASSERT(mismatches == 0, "One-way grid distances and unpacked paths match Dijkstra");
+
+    int saved = save_contraction_hierarchy(&ch, TEST_HIERARCHY_FILE) == 0;
+    int reloaded = saved && load_contraction_hierarchy(&loaded, &graph, TEST_HIERARCHY_FILE) == 0;
+    TEST_ASSERT(reloaded, "Hierarchy file saves and loads");
+    mismatches = compare_hierarchy(&graph, &loaded, 300);
+    free_contraction_hierarchy(&loaded);
+    free_contraction_hierarchy(&ch);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Loaded hierarchy answers the same queries");
+
+    // The file belongs to the one-way grid, not to a grid with other roads
+    if (build_test_grid(&graph, GRID_SIDE) != 0) {
+        cleanup_graph(&graph);
+        remove(TEST_HIERARCHY_FILE);
+        return 0;
+    }
+    int stale = load_contraction_hierarchy(&loaded, &graph, TEST_HIERARCHY_FILE) != 0;
+    cleanup_graph(&graph);
+    remove(TEST_HIERARCHY_FILE);
+    TEST_ASSERT(stale, "Hierarchy built for another graph is refused");
+    return 1;
+}
+
+int test_bidirectional() {
+    printf("\n🧪 Testing Bidirectional Dijkstra\n");
+    printf("=================================\n");
+
+    Graph graph;
+    int unreachable;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    int mismatches = compare_bidirectional(&graph, 100, &unreachable);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network distances and paths match Dijkstra");
+
+    if (build_test_grid(&graph, GRID_SIDE) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_bidirectional(&graph, 200, &unreachable);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Grid distances and paths match Dijkstra");
+
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_bidirectional(&graph, 200, &unreachable);
+    cleanup_graph(&graph);
+    printf("Unreachable one-way queries: %d\n", unreachable);
+    TEST_ASSERT(mismatches == 0, "One-way grid distances and paths match Dijkstra");
+    return 1;
+}
+
+int test_landmarks() {
+    printf("\n🧪 Testing A* with Landmarks (ALT)\n");
+    printf("==================================\n");
+
+    Graph graph;
+    LandmarkSet set;
+    int overestimates;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    if (select_landmarks(&graph, &set, 4, LANDMARKS_AVOID) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int mismatches = compare_landmarks(&graph, &set, graph.node_count * graph.node_count, &overestimates);
+    free_landmarks(&set);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0 && overestimates == 0, "Mumbai network distances and paths match Dijkstra");
+
+    // One-way streets make d(v,L) and d(L,v) differ, and leave some nodes
+    // unreachable from or unable to reach a landmark
+    for (int method = LANDMARKS_FARTHEST; method <= LANDMARKS_AVOID; method++) {
+        if (build_one_way_grid(&graph, GRID_SIDE) != 0 ||
+            select_landmarks(&graph, &set, 12, (LandmarkSelection)method) != 0) {
+            cleanup_graph(&graph);
+            return 0;
+        }
+        mismatches = compare_landmarks(&graph, &set, 200, &overestimates);
+        free_landmarks(&set);
+        cleanup_graph(&graph);
+        TEST_ASSERT(overestimates == 0, method == LANDMARKS_FARTHEST ?
+                    "Farthest landmark bounds never exceed the true distance" :
+                    "Avoid landmark bounds never exceed the true distance");
+        TEST_ASSERT(mismatches == 0, method == LANDMARKS_FARTHEST ?
+                    "One-way grid distances and paths match Dijkstra (farthest)" :
+                    "One-way grid distances and paths match Dijkstra (avoid)");
+    }
+    return 1;
+}
+
+int test_overlay() {
+    printf("\n🧪 Testing Multi-Level Overlay\n");
+    printf("==============================\n");
+
+    Graph graph;
+    MultiLevelOverlay overlay;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    if (build_overlay(&graph, &overlay, 2) != 0 || customize_overlay(&graph, &overlay, 1) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int mismatches = compare_overlay(&graph, &overlay, graph.node_count * graph.node_count);
+    free_overlay(&overlay);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network distances and expanded paths match Dijkstra");
+
+    // Small cells give every level some work; several threads customize
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || build_overlay(&graph, &overlay, 8) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    TEST_ASSERT(overlay.level_count == 3, "One-way grid overlay has three levels");
+    if (customize_overlay(&graph, &overlay, 3) != 0) {
+        free_overlay(&overlay);
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_overlay(&graph, &overlay, 200);
+    TEST_ASSERT(mismatches == 0, "One-way grid distances and expanded paths match Dijkstra");
+
+    // Rush hour weights: same partition, new matrices
+    apply_traffic_weights(&graph, 8);
+    int customized = freeze_graph(&graph) == 0 && customize_overlay(&graph, &overlay, 2) == 0;
+    mismatches = customized ? compare_overlay(&graph, &overlay, 200) : -1;
+    free_overlay(&overlay);
+    TEST_ASSERT(mismatches == 0, "Re-customized overlay matches Dijkstra on new weights");
+
+    // A partition of one network cannot be customized for another
+    Graph other;
+    int refused = build_test_grid(&other, GRID_SIDE) == 0 &&
+                  build_overlay(&graph, &overlay, 8) == 0 &&
+                  customize_overlay(&other, &overlay, 1) != 0;
+    free_overlay(&overlay);
+    cleanup_graph(&other);
+    cleanup_graph(&graph);
+    TEST_ASSERT(refused, "Overlay built for another road network is refused");
+    return 1;
+}
+
+int test_hub_labels() {
+    printf("\n🧪 Testing Hub Labels\n");
+    printf("=====================\n");
+
+    Graph graph;
+    ContractionHierarchy ch;
+    HubLabels labels, loaded;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    if (build_contraction_hierarchy(&graph, &ch, 1) != 0 || build_hub_labels(&ch, &labels) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    free_contraction_hierarchy(&ch);
+    int mismatches = compare_hub_labels(&graph, &labels, graph.node_count * graph.node_count);
+    free_hub_labels(&labels);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network distances and paths match Dijkstra");
+
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || build_contraction_hierarchy(&graph, &ch, 2) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int built = build_hub_labels(&ch, &labels) == 0;
+    free_contraction_hierarchy(&ch);
+    if (!built) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_hub_labels(&graph, &labels, 300);
+    TEST_ASSERT(mismatches == 0, "One-way grid distances and paths match Dijkstra");
+
+    int saved = save_hub_labels(&labels, TEST_LABEL_FILE) == 0;
+    int reloaded = saved && load_hub_labels(&loaded, &graph, TEST_LABEL_FILE) == 0;
+    free_hub_labels(&labels);
+    TEST_ASSERT(reloaded && loaded.mapping != NULL, "Label file saves and maps");
+    mismatches = compare_hub_labels(&graph, &loaded, 300);
+    free_hub_labels(&loaded);
+    TEST_ASSERT(mismatches == 0, "Mapped labels answer the same queries");
+
+    // Labels saved for the one-way grid against a grid with other roads
+    cleanup_graph(&graph);
+    if (build_test_grid(&graph, GRID_SIDE) != 0) {
+        remove(TEST_LABEL_FILE);
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int stale = load_hub_labels(&loaded, &graph, TEST_LABEL_FILE) != 0;
+    cleanup_graph(&graph);
+    remove(TEST_LABEL_FILE);
+    TEST_ASSERT(stale, "Labels built for another graph are refused");
+
+    // Two junctions at the same spot joined by a zero-weight road: from
+    // node 0 going back to 1 ties with going on to 2
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    add_location(&graph, 0, "junction", 18.9000, 72.8000);
+    add_location(&graph, 1, "junction", 18.9000, 72.8000);
+    add_location(&graph, 2, "station", 18.9100, 72.8100);
+    add_edge(&graph, 0, 2);
+    add_edge(&graph, 0, 1);
+    if (freeze_graph(&graph) != 0 || build_contraction_hierarchy(&graph, &ch, 1) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    built = build_hub_labels(&ch, &labels) == 0;
+    free_contraction_hierarchy(&ch);
+    if (!built) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int path[3];
+    int length = hub_label_path(&graph, &labels, 1, 2, path);
+    free_hub_labels(&labels);
+    cleanup_graph(&graph);
+    TEST_ASSERT(length == 3 && path[0] == 1 && path[1] == 0 && path[2] == 2,
+                "Zero-weight roads do not send the path in circles");
+    return 1;
+}
+
+int test_arc_flags() {
+    printf("\n🧪 Testing Arc Flags\n");
+    printf("===================\n");
+
+    Graph graph;
+    ArcFlags flags, threaded;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    if (compute_arc_flags(&graph, &flags, 4, 1) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    int mismatches = compare_arc_flags(&graph, &flags, graph.node_count * graph.node_count);
+    free_arc_flags(&flags);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network distances and paths match Dijkstra");
+
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || compute_arc_flags(&graph, &flags, 8, 1) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_arc_flags(&graph, &flags, 300);
+    TEST_ASSERT(mismatches == 0, "One-way grid distances and paths match Dijkstra");
+
+    // Threads share out the boundary nodes; the merged flags are the same
+    int same = compute_arc_flags(&graph, &threaded, 8, 3) == 0 &&
+               memcmp(flags.flags, threaded.flags, (size_t)flags.edge_count * flags.flag_bytes) == 0;
+    free_arc_flags(&threaded);
+    free_arc_flags(&flags);
+    cleanup_graph(&graph);
+    TEST_ASSERT(same, "Flags computed by three threads match one thread");
+    return 1;
+}
+
+int test_distance_matrix() {
+    printf("\n🧪 Testing Distance Matrices\n");
+    printf("===========================\n");
+
+    Graph graph;
+    ContractionHierarchy ch;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    int n = graph.node_count;
+    int* nodes = malloc((size_t)GRID_SIDE * GRID_SIDE * sizeof(int));
+    float* matrix = malloc((size_t)n * n * sizeof(float));
+    if (!nodes || !matrix || build_contraction_hierarchy(&graph, &ch, 1) != 0) {
+        free(nodes);
+        free(matrix);
+        cleanup_graph(&graph);
+        return 0;
+    }
+    for (int v = 0; v < n; v++) {
+        nodes[v] = v;
+    }
+    int computed = distance_matrix(&ch, nodes, n, nodes, n, 1, matrix) == 0;
+    int mismatches = computed ? compare_matrix(&graph, matrix, nodes, n, nodes, n) : -1;
+    free_contraction_hierarchy(&ch);
+    cleanup_graph(&graph);
+    free(matrix);
+    TEST_ASSERT(mismatches == 0, "Mumbai network all-pairs matrix matches Dijkstra");
+
+    // Every grid node as a target: rows are wide enough to need several
+    // blocks, and one-way streets leave some pairs unreachable
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || build_contraction_hierarchy(&graph, &ch, 2) != 0) {
+        free(nodes);
+        cleanup_graph(&graph);
+        return 0;
+    }
+    n = graph.node_count;
+    int source_count = 600;
+    int sources[600];
+    for (int i = 0; i < source_count; i++) {
+        sources[i] = (i * 7919) % n;
+    }
+    for (int v = 0; v < n; v++) {
+        nodes[v] = v;
+    }
+    float* single = malloc((size_t)source_count * n * sizeof(float));
+    float* threaded = malloc((size_t)source_count * n * sizeof(float));
+    computed = single && threaded &&
+               distance_matrix(&ch, sources, source_count, nodes, n, 1, single) == 0 &&
+               distance_matrix(&ch, sources, source_count, nodes, n, 3, threaded) == 0;
+    mismatches = computed ? compare_matrix(&graph, single, sources, source_count, nodes, n) : -1;
+    TEST_ASSERT(mismatches == 0, "One-way grid matrix matches Dijkstra");
+    TEST_ASSERT(computed && memcmp(single, threaded, (size_t)source_count * n * sizeof(float)) == 0,
+                "Matrix computed by three threads matches one thread");
+
+    int progress[2] = { 0, 0 };     // Next row expected, blocks seen
+    int streamed = distance_matrix_stream(&ch, sources, source_count, nodes, n, 2,
+                                          count_blocks, progress) == 0;
+    TEST_ASSERT(streamed && progress[0] == source_count && progress[1] > 1,
+                "Rows are streamed in order, several blocks");
+
+    float* loaded = NULL;
+    int rows = 0, columns = 0;
+    int saved = write_distance_matrix(&ch, sources, source_count, nodes, n, 2, TEST_MATRIX_FILE) == 0;
+    int reloaded = saved && load_distance_matrix(TEST_MATRIX_FILE, &rows, &columns, &loaded) == 0;
+    TEST_ASSERT(reloaded && rows == source_count && columns == n && computed &&
+                memcmp(loaded, single, (size_t)source_count * n * sizeof(float)) == 0,
+                "Matrix file holds the same distances");
+
+    // A bad index is refused before any search
+    nodes[0] = n;
+    int refused = distance_matrix(&ch, sources, 1, nodes, 1, 1, single) != 0;
+    free(loaded);
+    free(single);
+    free(threaded);
+    free(nodes);
+    remove(TEST_MATRIX_FILE);
+    free_contraction_hierarchy(&ch);
+    cleanup_graph(&graph);
+    TEST_ASSERT(refused, "Out of range locations are refused");
+    return 1;
+}
+
+int test_batch_queries() {
+    printf("\n🧪 Testing Batch Queries\n");
+    printf("=======================\n");
+
+    Graph graph;
+    ContractionHierarchy ch;
+    SearchWorkspace single;
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || build_contraction_hierarchy(&graph, &ch, 2) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    if (init_search_workspace(&single, graph.node_count) != 0) {
+        free_contraction_hierarchy(&ch);
+        cleanup_graph(&graph);
+        return 0;
+    }
+
+    // Every algorithm, mixed through the batch so ranges differ in cost
+    int n = graph.node_count, count = 400;
+    BatchQuery queries[400];
+    BatchResult results[400], threaded[400];
+    for (int q = 0; q < count; q++) {
+        queries[q].start = (q * 7919) % n;
+        queries[q].end = (q * 104729 + n / 3) % n;
+        queries[q].algorithm = (QueryAlgorithm)(q % 4);
+    }
+    BatchStats stats;
+    int ran = run_batch_queries(&graph, &ch, queries, count, 1, results, &stats) == 0 &&
+              run_batch_queries(&graph, &ch, queries, count, 4, threaded, &stats) == 0;
+    int mismatches = ran ? 0 : -1;
+    for (int q = 0; q < count && ran; q++) {
+        double expected = dijkstra_search(&graph, &single, queries[q].start, queries[q].end);
+        mismatches += fabs(results[q].distance - expected) > 1e-9 ||
+                      threaded[q].distance != results[q].distance;
+    }
+    TEST_ASSERT(mismatches == 0, "Results come back in input order and match Dijkstra");
+    TEST_ASSERT(ran && stats.query_count == count && stats.thread_count == 4 &&
+                stats.p50 <= stats.p99 && stats.queries_per_second > 0.0,
+                "Batch statistics cover every query");
+
+    int refused = run_batch_queries(&graph, NULL, queries, count, 2, results, &stats) != 0;
+    TEST_ASSERT(refused, "Hierarchy queries without a hierarchy are refused");
+
+    // Query files: comments, blank lines and the default algorithm
+    FILE* input = tmpfile();
+    BatchQuery* parsed = NULL;
+    int parsed_count = 0;
+    int read = 0;
+    if (input) {
+        fputs("# start end algorithm\n0 5\n\n7 3 ch\n", input);
+        rewind(input);
+        read = read_batch_queries(input, &graph, &parsed, &parsed_count) == 0 && parsed_count == 2 &&
+               parsed[0].algorithm == QUERY_DIJKSTRA && parsed[1].start == 7 &&
+               parsed[1].algorithm == QUERY_CH;
+        free(parsed);
+        parsed = NULL;
+        rewind(input);
+        fputs("1 2 teleport\n", input);
+        rewind(input);
+        read = read && read_batch_queries(input, &graph, &parsed, &parsed_count) != 0;
+        fclose(input);
+    }
+    free_search_workspace(&single);
+    free_contraction_hierarchy(&ch);
+    cleanup_graph(&graph);
+    TEST_ASSERT(read, "Query files parse and unknown algorithms are refused");
+    return 1;
+}
+
+int test_time_dependent() {
+    printf("\n🧪 Testing Time-Dependent Routing\n");
+    printf("================================\n");
+
+    Graph graph;
+    TimeProfiles profiles;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    if (build_time_profiles(&graph, &profiles) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+
+    // Arrival never decreases with departure, minute by minute round the day
+    int fifo = 1;
+    for (int e = 0; e < profiles.edge_count && fifo; e++) {
+        double previous = -INF;
+        for (double t = 0.0; t <= 2 * MINUTES_PER_DAY; t += 1.0) {
+            double arrival = t + td_edge_minutes(&profiles, e, t);
+            fifo = arrival >= previous - 1e-9;
+            previous = arrival;
+        }
+    }
+    TEST_ASSERT(fifo, "Every road's arrival time grows with its departure time");
+
+    // Midday the profiles are flat: a few minutes later, the same trip
+    SearchWorkspace workspace;
+    int flat = init_search_workspace(&workspace, graph.node_count) == 0;
+    if (flat) {
+        double noon = td_search(&graph, &profiles, &workspace, 8, 3, 12 * 60.0, 0);
+        flat = noon < INF && td_search(&graph, &profiles, &workspace, 8, 3, 12 * 60.0 + 20, 0) == noon;
+        double rush = td_search(&graph, &profiles, &workspace, 8, 3, 8 * 60.0, 0);
+        flat = flat && rush > noon;
+        free_search_workspace(&workspace);
+    }
+    TEST_ASSERT(flat, "Rush hour trips take longer than the same trip at noon");
+
+    int mismatches = compare_time_dependent(&graph, &profiles, graph.node_count, 7 * 60.0 + 40);
+    free_time_profiles(&profiles);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network arrivals match label-correcting search");
+
+    // Departures spanning the evening rush and midnight, on one-way streets
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0 || build_time_profiles(&graph, &profiles) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_time_dependent(&graph, &profiles, 8, 17 * 60.0 + 50) +
+                 compare_time_dependent(&graph, &profiles, 8, 23 * 60.0 + 55);
+    free_time_profiles(&profiles);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "One-way grid arrivals match label-correcting search");
+    return 1;
+}
+
+int test_alternatives() {
+    printf("\n🧪 Testing Alternative Routes\n");
+    printf("============================\n");
+
+    Graph graph;
+    int with_alternatives;
+    if (init_graph(&graph) != 0) {
+        return 0;
+    }
+    load_enhanced_mumbai_network(&graph);
+    int mismatches = compare_alternatives(&graph, graph.node_count, &with_alternatives);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Mumbai network routes are valid and the first is shortest");
+
+    if (build_test_grid(&graph, GRID_SIDE) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_alternatives(&graph, 40, &with_alternatives);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "Grid alternatives keep stretch, sharing and plateau bounds");
+    TEST_ASSERT(with_alternatives >= 30, "Most grid queries get an alternative");
+
+    if (build_one_way_grid(&graph, GRID_SIDE) != 0) {
+        cleanup_graph(&graph);
+        return 0;
+    }
+    mismatches = compare_alternatives(&graph, 40, &with_alternatives);
+    cleanup_graph(&graph);
+    TEST_ASSERT(mismatches == 0, "One-way grid alternatives keep stretch, sharing and plateau bounds");
+    return 1;
+}
+
+int run_all_tests() {
+    printf("🧪 TrackMate Pathfinding - Differential Tests\n");
+    printf("=============================================\n");
+
+    int total_tests = 0;
+    int passed_tests = 0;
+
+    if (test_heap_arities()) passed_tests++;
+    total_tests++;
+
+    if (test_radix_heap_order()) passed_tests++;
+    total_tests++;
+
+    if (test_enhanced_network_paths()) passed_tests++;
+    total_tests++;
+
+    if (test_grid_distances()) passed_tests++;
+    total_tests++;
+
+    if (test_workspace_reuse()) passed_tests++;
+    total_tests++;
+
+    if (test_bidirectional()) passed_tests++;
+    total_tests++;
+
+    if (test_contraction_hierarchy()) passed_tests++;
+    total_tests++;
+
+    if (test_landmarks()) passed_tests++;
+    total_tests++;
+
+    if (test_overlay()) passed_tests++;
+    total_tests++;
+
+    if (test_hub_labels()) passed_tests++;
+    total_tests++;
+
+    if (test_arc_flags()) passed_tests++;
+    total_tests++;
+
+    if (test_distance_matrix()) passed_tests++;
+    total_tests++;
+
+    if (test_batch_queries()) passed_tests++;
+    total_tests++;
+
+    if (test_time_dependent()) passed_tests++;
+    total_tests++;
+
+    if (test_alternatives()) passed_tests++;
+    total_tests++;
+
+    // Print summary
+    printf("\n📊 Test Results Summary\n");
+    printf("========================\n");
+    printf("Passed: %d/%d tests\n", passed_tests, total_tests);
+
+    if (passed_tests == total_tests) {
+        printf("🎉 All tests passed! Search engines agree.\n");
+        return 0;
+    } else {
+        printf("❌ Some tests failed. Please check the implementation.\n");
+        return 1;
+    }
+}
+
+int main() {
+    return run_all_tests();
+}
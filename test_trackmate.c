@@ -5,6 +5,11 @@
 #include <assert.h>
 #include <string.h>
 #include <time.h>
+#include "graph.h"
+#include "graph_file.h"
+#include "distance.h"
+#include "traffic.h"
+#include "osm_import.h"
 
 // Test framework macros
 #define TEST_ASSERT(condition, message) \
@@ -17,25 +22,6 @@
         } \
     } while(0)
 
-// Include the main trackmate functions (simplified for testing)
-#define EARTH_RADIUS 6371.0
-#define PI 3.14159265359
-
-double haversine_distance(double lat1, double lon1, double lat2, double lon2) {
-    lat1 = lat1 * PI / 180.0;
-    lon1 = lon1 * PI / 180.0;
-    lat2 = lat2 * PI / 180.0;
-    lon2 = lon2 * PI / 180.0;
-    
-    double dlat = lat2 - lat1;
-    double dlon = lon2 - lon1;
-    
-    double a = sin(dlat/2) * sin(dlat/2) + cos(lat1) * cos(lat2) * sin(dlon/2) * sin(dlon/2);
-    double c = 2 * atan2(sqrt(a), sqrt(1-a));
-    
-    return EARTH_RADIUS * c;
-}
-
 // Test functions
 int test_haversine_formula() {
     printf("\n🧪 Testing Haversine Formula\n");
@@ -174,6 +160,191 @@ int test_performance() {
     return 1;
 }
 
+int test_name_index() {
+    printf("\n🧪 Testing Location Name Index\n");
+    printf("===============================\n");
+
+    Graph graph;
+    TEST_ASSERT(init_graph(&graph) == 0, "Graph initialized");
+    add_location(&graph, 0, "Bandra Station", 19.0544, 72.8406);
+    add_location(&graph, 1, "Andheri", 19.1136, 72.8697);
+    add_location(&graph, 2, "Bandra Station", 19.0545, 72.8407);
+    add_location(&graph, 3, "BANDRA STATION", 19.0546, 72.8408);
+
+    TEST_ASSERT(find_location_by_name(&graph, "Andheri") == 1, "Exact lookup");
+    TEST_ASSERT(find_location_by_name(&graph, "andheri") == -1, "Exact lookup respects case");
+    TEST_ASSERT(find_location_by_name_nocase(&graph, "aNDHERI") == 1, "Case-insensitive lookup");
+    TEST_ASSERT(find_location_by_name(&graph, "Powai Lake") == -1 &&
+                find_location_by_name_nocase(&graph, "powai lake") == -1, "Unknown names not found");
+    TEST_ASSERT(find_location_by_name(&graph, "Bandra Station") == 0,
+                "Duplicate names return the lowest index");
+    TEST_ASSERT(find_location_by_name(&graph, "BANDRA STATION") == 3,
+                "Names differing only in case are indexed separately");
+    TEST_ASSERT(find_location_by_name_nocase(&graph, "bandra station") == 0,
+                "Case-insensitive lookup returns the lowest matching index");
+
+    // Far more names than the initial capacity: the node arrays grow and the
+    // index is rebuilt several times
+    const int extra = 5000;
+    char name[32];
+    for (int i = 0; i < extra; i++) {
+        snprintf(name, sizeof(name), "Junction %d", i);
+        add_location(&graph, 4 + i, name, 19.0 + i * 1e-5, 72.8);
+    }
+    int found = 1;
+    for (int i = 0; i < extra; i += 97) {
+        snprintf(name, sizeof(name), "Junction %d", i);
+        found = found && find_location_by_name(&graph, name) == 4 + i;
+        snprintf(name, sizeof(name), "JUNCTION %d", i);
+        found = found && find_location_by_name_nocase(&graph, name) == 4 + i;
+    }
+    TEST_ASSERT(graph.node_count == 4 + extra && found, "Every name found after the index grows");
+    TEST_ASSERT(find_location_by_name(&graph, "Bandra Station") == 0 &&
+                find_location_by_name_nocase(&graph, "bandra station") == 0,
+                "Lowest index still returned after growth");
+
+    // Reverse the node order: the lowest index of a repeated name changes
+    int n = graph.node_count;
+    int* new_index = malloc((size_t)n * sizeof(int));
+    TEST_ASSERT(new_index != NULL, "Permutation allocated");
+    for (int i = 0; i < n; i++) {
+        new_index[i] = n - 1 - i;
+    }
+    int permuted = apply_node_permutation(&graph, new_index);
+    free(new_index);
+    TEST_ASSERT(permuted == 0, "Nodes renumbered");
+    found = 1;
+    for (int i = 0; i < extra; i += 97) {
+        snprintf(name, sizeof(name), "Junction %d", i);
+        found = found && find_location_by_name(&graph, name) == n - 1 - (4 + i);
+    }
+    TEST_ASSERT(found, "Names follow their nodes through renumbering");
+    TEST_ASSERT(find_location_by_name(&graph, "Bandra Station") == n - 3,
+                "Duplicate names resolve to the lowest index in the new order");
+    TEST_ASSERT(find_location_by_name_nocase(&graph, "bandra station") == n - 4,
+                "Case-insensitive lookup resolves in the new order");
+    TEST_ASSERT(find_location_by_name_nocase(&graph, "ANDHERI") == n - 2 &&
+                strcmp(graph.locations[n - 2].name, "Andheri") == 0,
+                "Lookup result points at the renumbered location");
+
+    cleanup_graph(&graph);
+    return 1;
+}
+
+// A small extract: a two-way primary road with a maxspeed, a one-way
+// residential street, a motorway (one-way by default) with a speed in mph
+// and a footway that must be skipped
+static const char* ROUNDTRIP_OSM =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<osm version=\"0.6\">\n"
+    "  <node id=\"101\" lat=\"19.0544\" lon=\"72.8406\"/>\n"
+    "  <node id=\"102\" lat=\"19.0600\" lon=\"72.8500\">\n"
+    "    <tag k=\"name\" v=\"Test Junction\"/>\n"
+    "  </node>\n"
+    "  <node id=\"103\" lat=\"19.0633\" lon=\"72.8682\"/>\n"
+    "  <node id=\"104\" lat=\"19.0700\" lon=\"72.8700\"/>\n"
+    "  <node id=\"105\" lat=\"19.1136\" lon=\"72.8697\"/>\n"
+    "  <way id=\"201\">\n"
+    "    <nd ref=\"101\"/><nd ref=\"102\"/><nd ref=\"103\"/>\n"
+    "    <tag k=\"highway\" v=\"primary\"/>\n"
+    "    <tag k=\"maxspeed\" v=\"45\"/>\n"
+    "  </way>\n"
+    "  <way id=\"202\">\n"
+    "    <nd ref=\"103\"/><nd ref=\"104\"/>\n"
+    "    <tag k=\"highway\" v=\"residential\"/>\n"
+    "    <tag k=\"oneway\" v=\"yes\"/>\n"
+    "  </way>\n"
+    "  <way id=\"203\">\n"
+    "    <nd ref=\"104\"/><nd ref=\"105\"/>\n"
+    "    <tag k=\"highway\" v=\"motorway\"/>\n"
+    "    <tag k=\"maxspeed\" v=\"30 mph\"/>\n"
+    "  </way>\n"
+    "  <way id=\"204\">\n"
+    "    <nd ref=\"101\"/><nd ref=\"105\"/>\n"
+    "    <tag k=\"highway\" v=\"footway\"/>\n"
+    "  </way>\n"
+    "</osm>\n";
+
+int test_osm_graph_file_roundtrip() {
+    printf("\n🧪 Testing OSM Import Round Trip\n");
+    printf("=================================\n");
+
+    const char* osm_path = "test_roundtrip.osm";
+    const char* graph_path = "test_roundtrip.tmg";
+    FILE* file = fopen(osm_path, "w");
+    TEST_ASSERT(file != NULL, "Sample OSM file written");
+    fputs(ROUNDTRIP_OSM, file);
+    fclose(file);
+
+    Graph imported, opened;
+    TEST_ASSERT(init_graph(&imported) == 0, "Graph initialized");
+    int import_result = import_osm_xml(&imported, osm_path, 2);
+    remove(osm_path);
+    TEST_ASSERT(import_result == 0, "OSM extract imported");
+    TEST_ASSERT(imported.node_count == 5, "Every node on a car road imported");
+    TEST_ASSERT(imported.csr.edge_count == 6, "Two-way and one-way roads give 6 directed edges");
+
+    int junction = find_location_by_name(&imported, "Test Junction");
+    TEST_ASSERT(junction >= 0, "Named node keeps its name");
+
+    // The tags must have reached the edges before they can survive a file
+    const CSRGraph* csr = &imported.csr;
+    int primary = 0, residential = 0, motorway = 0;
+    for (int e = 0; e < csr->edge_count; e++) {
+        const char* road = interned_string(&imported.road_types, csr->road_types[e]);
+        if (strcmp(road, "main") == 0 && fabs(csr->speed_limits[e] - 45.0f) < 0.01f &&
+            csr->traffic_factors[e] == 2) {
+            primary++;
+        } else if (strcmp(road, "local") == 0 && fabs(csr->speed_limits[e] - 30.0f) < 0.01f) {
+            residential++;
+        } else if (strcmp(road, "highway") == 0 && fabs(csr->speed_limits[e] - 48.28f) < 0.01f &&
+                   csr->traffic_factors[e] == 1) {
+            motorway++;
+        }
+    }
+    TEST_ASSERT(primary == 4 && residential == 1 && motorway == 1,
+                "Highway class, maxspeed and oneway tags reach the edges");
+
+    TEST_ASSERT(save_graph_file(&imported, graph_path) == 0, "Graph file saved");
+    int open_result = open_graph_file(&opened, graph_path, 1);
+    remove(graph_path);
+    TEST_ASSERT(open_result == 0, "Graph file reopened with checksum");
+    TEST_ASSERT(opened.node_count == imported.node_count &&
+                opened.csr.edge_count == csr->edge_count, "Node and edge counts survive");
+
+    const CSRGraph* mapped = &opened.csr;
+    int same = memcmp(mapped->offsets, csr->offsets, (size_t)(imported.node_count + 1) * sizeof(int)) == 0 &&
+               memcmp(mapped->targets, csr->targets, (size_t)csr->edge_count * sizeof(int)) == 0;
+    for (int e = 0; same && e < csr->edge_count; e++) {
+        same = mapped->weights[e] == csr->weights[e] &&
+               mapped->base_distances[e] == csr->base_distances[e] &&
+               mapped->speed_limits[e] == csr->speed_limits[e] &&
+               mapped->traffic_factors[e] == csr->traffic_factors[e] &&
+               strcmp(interned_string(&opened.road_types, mapped->road_types[e]),
+                      interned_string(&imported.road_types, csr->road_types[e])) == 0;
+    }
+    TEST_ASSERT(same, "Adjacency and every edge attribute survive the file");
+    TEST_ASSERT(find_location_by_name(&opened, "Test Junction") == junction, "Name index survives");
+    TEST_ASSERT(mapped->fingerprint == graph_fingerprint(&opened) &&
+                mapped->fingerprint == csr->fingerprint, "Stored fingerprint matches the graph");
+
+    // Rush-hour reweighting needs the stored attributes, not edge lists
+    apply_traffic_weights(&imported, 18);
+    apply_traffic_weights(&opened, 18);
+    same = 1;
+    for (int e = 0; e < csr->edge_count; e++) {
+        same = same && mapped->weights[e] == csr->weights[e] &&
+               mapped->reverse_weights[e] == csr->reverse_weights[e];
+    }
+    TEST_ASSERT(same, "Traffic weights of the opened graph match the imported graph");
+    TEST_ASSERT(mapped->fingerprint == graph_fingerprint(&opened) &&
+                mapped->fingerprint == csr->fingerprint, "Reweighting refreshes the cached fingerprint");
+
+    cleanup_graph(&opened);
+    cleanup_graph(&imported);
+    return 1;
+}
+
 int run_all_tests() {
     printf("🧪 TrackMate GPS Tracker - Test Suite\n");
     printf("=====================================\n");
@@ -196,6 +367,12 @@ int run_all_tests() {
     
     if (test_performance()) passed_tests++;
     total_tests++;
+
+    if (test_name_index()) passed_tests++;
+    total_tests++;
+
+    if (test_osm_graph_file_roundtrip()) passed_tests++;
+    total_tests++;
     
     // Print summary
     printf("\n📊 Test Results Summary\n");
@@ -0,0 +1,266 @@
+/**
+ * time_dependent.c
+ * Travel time profiles and time-dependent Dijkstra / A*
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "time_dependent.h"
+#include "traffic.h"
+#include "pathfinding.h"
+#include "heap.h"
+#include "search_workspace.h"
+#include "distance.h"
+
+#define PROFILE_KEYS 65536      // Road type * 256 + traffic factor
+
+static int profile_key(const CSRGraph* csr, int e) {
+    return csr->road_types[e] * 256 + csr->traffic_factors[e];
+}
+
+// Multiple of free-flow time at minute t of the day for edge e's road type
+// and traffic factor: the hourly model taken at the middle of each hour,
+// linear in between
+static double sample_factor(const CSRGraph* csr, int e, double t) {
+    double hours = (t - 30.0) / 60.0;
+    double first = floor(hours);
+    double fraction = hours - first;
+    int hour = (int)first;
+    double a = dynamic_weight(1.0, csr->road_types[e], csr->traffic_factors[e], hour);
+    double b = dynamic_weight(1.0, csr->road_types[e], csr->traffic_factors[e], hour + 1);
+    return a + (b - a) * fraction;
+}
+
+// Surface distance to target: roads are measured the same way, so no
+// road is shorter (heuristic_distance adds elevation and could be)
+static double surface_distance(const Graph* graph, int v, int target) {
+    return haversine_distance(graph->nodes.latitude[v], graph->nodes.longitude[v],
+                              graph->nodes.latitude[target], graph->nodes.longitude[target]);
+}
+
+static double free_flow_minutes(const CSRGraph* csr, int e) {
+    double speed = csr->speed_limits[e] > 0.0f ? csr->speed_limits[e] : DEFAULT_SPEED_KMH;
+    return csr->base_distances[e] / speed * 60.0;
+}
+
+int build_time_profiles(const Graph* graph, TimeProfiles* profiles) {
+    memset(profiles, 0, sizeof(TimeProfiles));
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before building time profiles\n");
+        return -1;
+    }
+
+    const CSRGraph* csr = &graph->csr;
+    int edge_count = csr->edge_count;
+    int* index = malloc(PROFILE_KEYS * sizeof(int));
+    int* sample = malloc(PROFILE_KEYS * sizeof(int));
+    double* longest = malloc(PROFILE_KEYS * sizeof(double));
+    profiles->profile = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(unsigned short));
+    profiles->free_flow = malloc((size_t)(edge_count > 0 ? edge_count : 1) * sizeof(float));
+    if (!index || !sample || !longest || !profiles->profile || !profiles->free_flow) {
+        printf("❌ Out of memory: could not allocate time profiles\n");
+        free(index);
+        free(sample);
+        free(longest);
+        free_time_profiles(profiles);
+        return -1;
+    }
+
+    // Number the profiles in CSR edge order, noting each one's longest edge
+    for (int k = 0; k < PROFILE_KEYS; k++) {
+        index[k] = -1;
+    }
+    for (int e = 0; e < edge_count; e++) {
+        int key = profile_key(csr, e);
+        if (index[key] < 0) {
+            index[key] = profiles->profile_count;
+            sample[profiles->profile_count] = e;
+            longest[profiles->profile_count] = 0.0;
+            profiles->profile_count++;
+        }
+        int p = index[key];
+        profiles->profile[e] = (unsigned short)p;
+        profiles->free_flow[e] = (float)free_flow_minutes(csr, e);
+        if (profiles->free_flow[e] > longest[p]) {
+            longest[p] = profiles->free_flow[e];
+        }
+    }
+
+    profiles->factors = malloc((size_t)(profiles->profile_count > 0 ? profiles->profile_count : 1) *
+                               TIME_SLOTS * sizeof(float));
+    if (!profiles->factors) {
+        printf("❌ Out of memory: could not allocate time profiles\n");
+        free(index);
+        free(sample);
+        free(longest);
+        free_time_profiles(profiles);
+        return -1;
+    }
+
+    double min_factor = INF;
+    for (int p = 0; p < profiles->profile_count; p++) {
+        float* factor = profiles->factors + (size_t)p * TIME_SLOTS;
+        for (int s = 0; s < TIME_SLOTS; s++) {
+            factor[s] = (float)sample_factor(csr, sample[p], s * SLOT_MINUTES);
+        }
+        // A slot may fall by at most SLOT_MINUTES on the longest edge, or
+        // leaving later would arrive earlier; raise the slots after a
+        // steeper fall (twice round, as the day wraps)
+        if (longest[p] > 0.0) {
+            float limit = (float)(SLOT_MINUTES / longest[p]);
+            for (int i = 0; i < 2 * TIME_SLOTS; i++) {
+                int s = i % TIME_SLOTS, next = (i + 1) % TIME_SLOTS;
+                if (factor[next] < factor[s] - limit) {
+                    factor[next] = factor[s] - limit;
+                }
+            }
+        }
+        for (int s = 0; s < TIME_SLOTS; s++) {
+            if (factor[s] < min_factor) {
+                min_factor = factor[s];
+            }
+        }
+    }
+
+    // Slowest-case lower bound for A*: the fewest minutes any road takes per km
+    profiles->min_minutes_per_km = INF;
+    for (int e = 0; e < edge_count; e++) {
+        if (csr->base_distances[e] > 0.0) {
+            double per_km = profiles->free_flow[e] * min_factor / csr->base_distances[e];
+            if (per_km < profiles->min_minutes_per_km) {
+                profiles->min_minutes_per_km = per_km;
+            }
+        }
+    }
+    if (profiles->min_minutes_per_km >= INF) {
+        profiles->min_minutes_per_km = 0.0;
+    }
+    // Float rounding of the free-flow times must not lift the bound
+    profiles->min_minutes_per_km *= 1.0 - 1e-6;
+
+    profiles->edge_count = edge_count;
+    profiles->topology = graph->csr.topology_fingerprint;
+    free(index);
+    free(sample);
+    free(longest);
+    return 0;
+}
+
+void free_time_profiles(TimeProfiles* profiles) {
+    free(profiles->factors);
+    free(profiles->profile);
+    free(profiles->free_flow);
+    memset(profiles, 0, sizeof(TimeProfiles));
+}
+
+double td_edge_minutes(const TimeProfiles* profiles, int e, double t) {
+    double day = t - MINUTES_PER_DAY * floor(t / MINUTES_PER_DAY);
+    double position = day / SLOT_MINUTES;
+    int slot = (int)position;
+    if (slot >= TIME_SLOTS) {
+        slot = TIME_SLOTS - 1;
+    }
+    int next = slot + 1 < TIME_SLOTS ? slot + 1 : 0;
+    const float* factor = profiles->factors + (size_t)profiles->profile[e] * TIME_SLOTS;
+    double scale = factor[slot] + (factor[next] - factor[slot]) * (position - slot);
+    return profiles->free_flow[e] * scale;
+}
+
+double td_search(const Graph* graph, const TimeProfiles* profiles, SearchWorkspace* workspace,
+                 int start, int end, double departure, int use_astar) {
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return INF;
+    }
+    if (workspace->node_count < graph->node_count) {
+        printf("❌ Search workspace is smaller than the graph\n");
+        return INF;
+    }
+    const CSRGraph* csr = &graph->csr;
+    unsigned int epoch;
+    unsigned int* stamp = workspace->stamp;
+    double* arrival = workspace->distance;
+    int* parents = workspace->previous;
+    MinHeap* open_set = &workspace->heap;
+    double per_km = use_astar ? profiles->min_minutes_per_km : 0.0;
+
+    begin_search(workspace);
+    epoch = workspace->epoch;
+    stamp[start] = epoch;
+    arrival[start] = departure;
+    parents[start] = -1;
+    insert_heap(open_set, start, departure + per_km * surface_distance(graph, start, end));
+
+    while (!is_empty(open_set)) {
+        int u = extract_min(open_set).vertex;
+        workspace->settled++;
+
+        if (u == end) {
+            return arrival[end] - departure;
+        }
+
+        // Each road is timed from the moment it is entered
+        for (int e = csr->offsets[u]; e < csr->offsets[u + 1]; e++) {
+            int v = csr->targets[e];
+            int reached = stamp[v] == epoch;
+
+            if (!reached || in_heap(open_set, v)) {
+                double at = arrival[u] + td_edge_minutes(profiles, e, arrival[u]);
+
+                if (!reached || at < arrival[v]) {
+                    stamp[v] = epoch;
+                    arrival[v] = at;
+                    parents[v] = u;
+                    double h = per_km > 0.0 ? per_km * surface_distance(graph, v, end) : 0.0;
+                    insert_heap(open_set, v, at + h);
+                }
+            }
+        }
+    }
+    return INF;
+}
+
+int td_pathfind(const Graph* graph, const TimeProfiles* profiles, int start, int end,
+                double departure, int path[], double* travel_minutes) {
+    if (!graph->csr.is_frozen) {
+        printf("❌ Graph must be frozen before searching\n");
+        return 0;
+    }
+    if (profiles->edge_count != graph->csr.edge_count ||
+        profiles->topology != graph->csr.topology_fingerprint) {
+        printf("❌ Time profiles were built for a different road network\n");
+        return 0;
+    }
+
+    clock_t start_time = clock();
+    int minute = (int)departure % (int)MINUTES_PER_DAY;
+    printf("Starting time-dependent A*: node %d → node %d, leaving at %02d:%02d\n",
+           start, end, minute / 60, minute % 60);
+
+    SearchWorkspace workspace;
+    if (init_search_workspace(&workspace, graph->node_count) != 0) {
+        printf("❌ Out of memory: could not allocate time-dependent search state\n");
+        return 0;
+    }
+
+    int path_length = 0;
+    double minutes = td_search(graph, profiles, &workspace, start, end, departure, 1);
+    if (minutes < INF) {
+        path_length = workspace_path(&workspace, end, path);
+        *travel_minutes = minutes;
+
+        double calc_time = ((double)(clock() - start_time)) / CLOCKS_PER_SEC;
+        int arrival = (int)(departure + minutes + 0.5) % (int)MINUTES_PER_DAY;
+        printf("✅ Time-dependent A* completed! Travel time: %.1f minutes, arriving %02d:%02d\n",
+               minutes, arrival / 60, arrival % 60);
+        printf("   Nodes explored: %d, Time: %.4fs\n", workspace.settled, calc_time);
+    } else {
+        printf("❌ No path found!\n");
+    }
+
+    free_search_workspace(&workspace);
+    return path_length;
+}
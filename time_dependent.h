@@ -0,0 +1,61 @@
+/**
+ * time_dependent.h
+ * Time-dependent routing: earliest arrival for a given departure time
+ * over fifteen-minute travel time profiles
+ */
+
+#ifndef TIME_DEPENDENT_H
+#define TIME_DEPENDENT_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+#define SLOT_MINUTES 15.0
+#define MINUTES_PER_DAY 1440.0
+#define DEFAULT_SPEED_KMH 50.0      // For edges without a speed limit
+
+/**
+ * Sample the hourly traffic model (see calculate_dynamic_weight) at every
+ * slot boundary, interpolating between the middles of the hours, into one
+ * profile per road type and traffic factor. Where a profile falls faster
+ * than its longest edge could be overtaken by waiting, the later slots
+ * are raised, so arrival times never decrease with departure time (FIFO).
+ * Reads the CSR edge attributes, so graphs opened from a graph file work.
+ * @return 0 on success, -1 if the graph is not frozen or memory runs out
+ */
+int build_time_profiles(const Graph* graph, TimeProfiles* profiles);
+
+/**
+ * Release the memory held by time profiles
+ */
+void free_time_profiles(TimeProfiles* profiles);
+
+/**
+ * Minutes to cross CSR edge e when entering it at minute t (minutes
+ * after midnight; later days wrap around)
+ */
+double td_edge_minutes(const TimeProfiles* profiles, int e, double t);
+
+/**
+ * Earliest arrival from start to end leaving at departure (minutes after
+ * midnight), with each edge's time read from its profile at the moment it
+ * is entered. Label-setting is exact because the profiles are FIFO.
+ * Quiet, like dijkstra_search; the route is left in the workspace.
+ * @param use_astar Order the search by a straight-line lower bound on the
+ *                  remaining minutes
+ * @return Travel time in minutes, INF if there is no path
+ */
+double td_search(const Graph* graph, const TimeProfiles* profiles, SearchWorkspace* workspace,
+                 int start, int end, double departure, int use_astar);
+
+/**
+ * Find the fastest route for a departure time and print the query
+ * statistics
+ * @param path Array to store the path vertices (node_count entries)
+ * @param travel_minutes Pointer to store the travel time
+ * @return Length of the path (number of vertices)
+ */
+int td_pathfind(const Graph* graph, const TimeProfiles* profiles, int start, int end,
+                double departure, int path[], double* travel_minutes);
+
+#endif // TIME_DEPENDENT_H
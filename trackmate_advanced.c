@@ -27,15 +27,28 @@ typedef struct {
     char district[30];
 } Location;
 
+// Road categories, resolved from their names once when edges are added
+typedef enum {
+    ROAD_MAIN = 0,
+    ROAD_HIGHWAY,
+    ROAD_LOCAL,
+    ROAD_TYPE_COUNT
+} RoadType;
+
+static const char* ROAD_TYPE_NAMES[ROAD_TYPE_COUNT] = { "main", "highway", "local" };
+
+// Cost multiplier per road type: highways are faster, local roads slower
+static const double ROAD_TYPE_MULTIPLIER[ROAD_TYPE_COUNT] = { 1.0, 0.8, 1.2 };
+
 // Enhanced Edge with traffic and road type information
 typedef struct Edge {
-    int destination;
+    struct Edge* next;
     double base_distance;    // Physical distance
     double current_weight;   // Dynamic weight with traffic
-    char road_type[20];      // "highway", "main", "local"
-    int traffic_factor;      // Current traffic multiplier (1-3)
-    double speed_limit;      // Speed limit in km/h
-    struct Edge* next;
+    int destination;
+    float speed_limit;       // Speed limit in km/h
+    unsigned char road_type; // RoadType
+    unsigned char traffic_factor; // Current traffic multiplier (1-3)
 } Edge;
 
 // Enhanced Graph node
@@ -110,15 +123,21 @@ double calculate_dynamic_weight(Edge* edge, int current_hour) {
     }
     
     // Road type factor
-    if (strcmp(edge->road_type, "highway") == 0) {
-        traffic_multiplier *= 0.8;  // Highways are faster
-    } else if (strcmp(edge->road_type, "local") == 0) {
-        traffic_multiplier *= 1.2;  // Local roads are slower
-    }
+    traffic_multiplier *= ROAD_TYPE_MULTIPLIER[edge->road_type];
     
     return base_weight * traffic_multiplier;
 }
 
+// Map a road type name to its RoadType (unknown names count as main roads)
+RoadType parse_road_type(const char* road_type) {
+    for (int i = 0; i < ROAD_TYPE_COUNT; i++) {
+        if (strcmp(road_type, ROAD_TYPE_NAMES[i]) == 0) {
+            return (RoadType)i;
+        }
+    }
+    return ROAD_MAIN;
+}
+
 // ===== A* ALGORITHM IMPLEMENTATION =====
 void init_astar_queue(AStarQueue* queue) {
     queue->size = 0;
@@ -179,13 +198,16 @@ double heuristic_distance(int from, int to) {
 }
 
 // ===== A* PATHFINDING =====
-int astar_pathfind(int start, int goal, int path[], double* total_cost) {
+// Each edge weight is taken at the hour the route reaches it: departure_hour
+// plus the hours spent so far, driving every road at its speed limit
+int astar_pathfind(int start, int goal, int departure_hour, int path[], double* total_cost) {
     clock_t start_time = clock();
     
     AStarQueue open_set;
     init_astar_queue(&open_set);
     
     double g_costs[MAX_NODES];
+    double hours[MAX_NODES];     // Hours since departure on reaching each node
     int parents[MAX_NODES];
     int in_closed_set[MAX_NODES] = {0};
     
@@ -195,6 +217,7 @@ int astar_pathfind(int start, int goal, int path[], double* total_cost) {
     }
     
     g_costs[start] = 0;
+    hours[start] = 0;
     double h_start = heuristic_distance(start, goal);
     astar_insert(&open_set, start, 0, h_start, -1);
     
@@ -241,6 +264,7 @@ int astar_pathfind(int start, int goal, int path[], double* total_cost) {
         }
         
         in_closed_set[u] = 1;
+        int current_hour = (departure_hour + (int)hours[u]) % 24;
         
         // Explore neighbors
         Edge* edge = graph[u].edges;
@@ -248,14 +272,13 @@ int astar_pathfind(int start, int goal, int path[], double* total_cost) {
             int v = edge->destination;
             
             if (!in_closed_set[v] && graph[v].is_active) {
-                time_t now = time(NULL);
-                struct tm* local_time = localtime(&now);
-                double dynamic_weight = calculate_dynamic_weight(edge, local_time->tm_hour);
+                double dynamic_weight = calculate_dynamic_weight(edge, current_hour);
                 
                 double tentative_g = g_costs[u] + dynamic_weight;
                 
                 if (tentative_g < g_costs[v]) {
                     g_costs[v] = tentative_g;
+                    hours[v] = hours[u] + dynamic_weight / edge->speed_limit;
                     parents[v] = u;
                     double h = heuristic_distance(v, goal);
                     astar_insert(&open_set, v, tentative_g, h, u);
@@ -286,6 +309,7 @@ void add_enhanced_location(int id, const char* name, const char* type, const cha
 }
 
 void add_enhanced_edge(int from, int to, const char* road_type, int traffic_factor, double speed_limit) {
+    RoadType type = parse_road_type(road_type);
     double distance = enhanced_haversine_distance(
         graph[from].location.latitude, graph[from].location.longitude, graph[from].location.elevation,
         graph[to].location.latitude, graph[to].location.longitude, graph[to].location.elevation
@@ -296,9 +320,9 @@ void add_enhanced_edge(int from, int to, const char* road_type, int traffic_fact
     new_edge->destination = to;
     new_edge->base_distance = distance;
     new_edge->current_weight = distance;
-    strcpy(new_edge->road_type, road_type);
-    new_edge->traffic_factor = traffic_factor;
-    new_edge->speed_limit = speed_limit;
+    new_edge->road_type = (unsigned char)type;
+    new_edge->traffic_factor = (unsigned char)traffic_factor;
+    new_edge->speed_limit = (float)speed_limit;
     new_edge->next = graph[from].edges;
     graph[from].edges = new_edge;
     
@@ -307,9 +331,9 @@ void add_enhanced_edge(int from, int to, const char* road_type, int traffic_fact
     reverse_edge->destination = from;
     reverse_edge->base_distance = distance;
     reverse_edge->current_weight = distance;
-    strcpy(reverse_edge->road_type, road_type);
-    reverse_edge->traffic_factor = traffic_factor;
-    reverse_edge->speed_limit = speed_limit;
+    reverse_edge->road_type = (unsigned char)type;
+    reverse_edge->traffic_factor = (unsigned char)traffic_factor;
+    reverse_edge->speed_limit = (float)speed_limit;
     reverse_edge->next = graph[to].edges;
     graph[to].edges = reverse_edge;
 }
@@ -456,7 +480,10 @@ int main() {
     int path[MAX_NODES];
     double total_cost;
     
-    int path_length = astar_pathfind(start, goal, path, &total_cost);
+    // Read the clock once for the whole query, not once per edge
+    time_t now = time(NULL);
+    int departure_hour = localtime(&now)->tm_hour;
+    int path_length = astar_pathfind(start, goal, departure_hour, path, &total_cost);
     
     if (path_length > 0) {
         printf("\n🎉 Optimal Route Found!\n");
@@ -0,0 +1,79 @@
+/**
+ * traffic.c
+ * Traffic-aware dynamic edge weights implementation
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include "traffic.h"
+#include "graph.h"
+
+// Base multiplier by hour: rush hours (7-9 AM, 6-8 PM) are scaled per edge
+// below, nights (10 PM - 6 AM) are faster
+static const double HOUR_MULTIPLIER[24] = {
+    0.8, 0.8, 0.8, 0.8, 0.8, 0.8, 0.8,  // 00-06
+    1.5, 1.5, 1.5,                      // 07-09 rush
+    1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0,  // 10-17
+    1.5, 1.5, 1.5,                      // 18-20 rush
+    1.0,                                // 21
+    0.8, 0.8                            // 22-23
+};
+
+// Extra multiplier per unit of Edge.traffic_factor (rush hours only)
+static const double HOUR_TRAFFIC_COEFFICIENT[24] = {
+    0, 0, 0, 0, 0, 0, 0,
+    0.3, 0.3, 0.3,
+    0, 0, 0, 0, 0, 0, 0, 0,
+    0.3, 0.3, 0.3,
+    0,
+    0, 0
+};
+
+// Multiplier per built-in road type; other interned types use 1.0
+static const double ROAD_TYPE_MULTIPLIER[ROAD_TYPE_BUILTIN_COUNT] = {
+    1.0,    // ROAD_MAIN
+    0.8,    // ROAD_HIGHWAY: faster
+    1.2     // ROAD_LOCAL: slower
+};
+
+double dynamic_weight(double base_distance, int road_type, int traffic_factor, int current_hour) {
+    int hour = ((current_hour % 24) + 24) % 24;
+    double multiplier = HOUR_MULTIPLIER[hour] +
+                        HOUR_TRAFFIC_COEFFICIENT[hour] * traffic_factor;
+    
+    if (road_type < ROAD_TYPE_BUILTIN_COUNT) {
+        multiplier *= ROAD_TYPE_MULTIPLIER[road_type];
+    }
+    
+    return base_distance * multiplier;
+}
+
+double calculate_dynamic_weight(const Edge* edge, int current_hour) {
+    return dynamic_weight(edge->base_distance, edge->road_type, edge->traffic_factor, current_hour);
+}
+
+void apply_traffic_weights(Graph* graph, int current_hour) {
+    // Edge lists first, so a later re-freeze keeps the new weights
+    if (!graph->is_mapped) {
+        for (int i = 0; i < graph->node_count; i++) {
+            for (Edge* edge = graph->edge_lists[i]; edge != NULL; edge = edge->next) {
+                edge->current_weight = calculate_dynamic_weight(edge, current_hour);
+            }
+        }
+    }
+    if (!graph->csr.is_frozen) {
+        return;
+    }
+    
+    CSRGraph* csr = &graph->csr;
+    double* weights = writable_csr_weights(graph);
+    if (weights) {
+        for (int e = 0; e < csr->edge_count; e++) {
+            weights[e] = dynamic_weight(csr->base_distances[e], csr->road_types[e],
+                                        csr->traffic_factors[e], current_hour);
+        }
+    }
+    if ((!weights || sync_reverse_weights(graph) != 0) && !graph->is_mapped) {
+        csr->is_frozen = 0;     // Out of memory: rebuild from the edge lists instead
+    }
+}
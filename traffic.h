@@ -0,0 +1,35 @@
+/**
+ * traffic.h
+ * Traffic-aware dynamic edge weights
+ */
+
+#ifndef TRAFFIC_H
+#define TRAFFIC_H
+
+#include "gps_types.h"
+#include "graph.h"
+
+/**
+ * Weight of an edge at a given hour of day, from per-hour and per-road-type
+ * multiplier tables (rush hour scales with the edge's traffic factor)
+ * @param edge Edge to weigh
+ * @param current_hour Hour of day (0-23)
+ * @return Weighted distance in km
+ */
+double calculate_dynamic_weight(const Edge* edge, int current_hour);
+
+/**
+ * The same weight from the edge's attributes, e.g. the per-edge CSR arrays
+ * of a frozen graph
+ */
+double dynamic_weight(double base_distance, int road_type, int traffic_factor, int current_hour);
+
+/**
+ * Set every edge's current_weight for the given hour of day. A frozen
+ * graph is reweighted in place from its CSR edge attributes, so graphs
+ * opened from a graph file can be reweighted too; otherwise the graph is
+ * marked for re-freezing.
+ */
+void apply_traffic_weights(Graph* graph, int current_hour);
+
+#endif // TRAFFIC_H